@@ -0,0 +1,74 @@
+#include <iostream>
+#include <chrono>
+
+#include <symengine/symbol.h>
+#include <symengine/polynomial.h>
+#include <symengine/polynomial_multivariate.h>
+#include <symengine/polynomial_packed.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using SymEngine::RCP;
+using SymEngine::Symbol;
+using SymEngine::symbol;
+using SymEngine::MultivariateIntPolynomial;
+using SymEngine::MonomialPacker;
+using SymEngine::PackedIntPoly;
+using SymEngine::packed_mul_parallel;
+using SymEngine::integer_class;
+
+// Fateman's benchmark: f = (1 + x + y + z + t)**N, then time f * (f + 1)
+// for every number of threads from 1 to the maximum available.
+int main(int argc, char *argv[])
+{
+    SymEngine::print_stack_on_segfault();
+    int N;
+    if (argc == 2) {
+        N = std::atoi(argv[1]);
+    } else {
+        N = 20;
+    }
+
+    RCP<const Symbol> x = symbol("x"), y = symbol("y"), z = symbol("z"),
+                      t = symbol("t");
+    RCP<const MultivariateIntPolynomial> s = MultivariateIntPolynomial::create(
+        {x, y, z, t}, {{{1, 0, 0, 0}, integer_class(1)},
+                       {{0, 1, 0, 0}, integer_class(1)},
+                       {{0, 0, 1, 0}, integer_class(1)},
+                       {{0, 0, 0, 1}, integer_class(1)},
+                       {{0, 0, 0, 0}, integer_class(1)}});
+    RCP<const MultivariateIntPolynomial> f = s;
+    for (int i = 1; i < N; i++)
+        f = mul_mult_poly(*f, *s);
+    RCP<const MultivariateIntPolynomial> g = add_mult_poly(
+        *f, *MultivariateIntPolynomial::create(
+                {x, y, z, t}, {{{0, 0, 0, 0}, integer_class(1)}}));
+
+    MonomialPacker packer(4);
+    PackedIntPoly a, b, c;
+    packed_from_dict(a, f->dict_, {0, 1, 2, 3}, packer);
+    packed_from_dict(b, g->dict_, {0, 1, 2, 3}, packer);
+
+#ifdef _OPENMP
+    unsigned int max_threads = omp_get_max_threads();
+#else
+    unsigned int max_threads = 1;
+#endif
+    double base = 0;
+    for (unsigned int n = 1; n <= max_threads; n++) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        packed_mul_parallel(c, a, b, n);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration_cast<std::chrono::microseconds>(
+                        t2 - t1).count() / 1000.0;
+        if (n == 1)
+            base = ms;
+        std::cout << n << " threads: " << ms << "ms"
+                  << " (speedup " << base / ms << ")" << std::endl;
+    }
+    std::cout << "number of terms: " << c.size() << std::endl;
+
+    return 0;
+}
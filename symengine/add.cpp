@@ -13,6 +13,9 @@ Add::Add(const RCP<const Number> &coef, umap_basic_num &&dict)
     : coef_{coef}, dict_{std::move(dict)}
 {
     SYMENGINE_ASSERT(is_canonical(coef, dict_))
+    // The hashes of the terms are known from the dictionary, so the hash is
+    // cheap to compute now and it is needed by every dictionary operation.
+    hash();
 }
 
 bool Add::is_canonical(const RCP<const Number> &coef,
@@ -20,12 +20,19 @@ inline bool Basic::__neq__(const Basic &o) const
 //! \return true if  `a` equal `b`
 inline bool eq(const Basic &a, const Basic &b)
 {
+    if (&a == &b)
+        return true;
+    // Expressions with different hashes are not equal. The hashes are only
+    // compared if both are known, computing them costs more than __eq__.
+    std::size_t ha = a.cached_hash(), hb = b.cached_hash();
+    if (ha != 0 and hb != 0 and ha != hb)
+        return false;
     return a.__eq__(b);
 }
 //! \return true if  `a` not equal `b`
 inline bool neq(const Basic &a, const Basic &b)
 {
-    return not(a.__eq__(b));
+    return not eq(a, b);
 }
 
 //! Templatised version to check is_a type
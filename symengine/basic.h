@@ -132,6 +132,11 @@ public:
 
     //! This caches the hash:
     std::size_t hash() const;
+    //! \return the cached hash, or 0 if it was not computed yet
+    std::size_t cached_hash() const
+    {
+        return hash_;
+    }
 
     //! true if `this` is equal to `o`.
     virtual bool __eq__(const Basic &o) const = 0;
@@ -183,7 +188,7 @@ struct RCPBasicKeyEq {
     //! Comparison Operator `==`
     bool operator()(const RCP<const Basic> &x, const RCP<const Basic> &y) const
     {
-        return x->__eq__(*y);
+        return x.get() == y.get() or x->__eq__(*y);
     }
 };
 
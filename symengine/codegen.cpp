@@ -0,0 +1,975 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <symengine/codegen.h>
+#include <symengine/eval_double.h>
+#include <symengine/printer.h>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace SymEngine
+{
+
+namespace
+{
+
+bool is_atom(const Basic &x)
+{
+    return is_a_Number(x) or is_a<Symbol>(x) or is_a<Constant>(x);
+}
+
+std::string double_literal(double d)
+{
+    if (std::isnan(d))
+        return "NAN";
+    if (std::isinf(d))
+        return d > 0 ? "INFINITY" : "-INFINITY";
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.17g", d);
+    std::string s(buf);
+    if (s.find_first_of(".e") == std::string::npos)
+        s += ".0";
+    return s;
+}
+
+//! Appends ` + s` to `r`, or ` - s` if `s` is negated
+void append_term(std::string &r, const std::string &s)
+{
+    if (s[0] == '-') {
+        r += " - ";
+        r.append(s, 1, std::string::npos);
+    } else {
+        r += " + ";
+        r += s;
+    }
+}
+
+} // anonymous namespace
+
+std::string CCodePrinter::apply(const std::string &name,
+                                const vec_basic &inputs,
+                                const vec_basic &outputs)
+{
+    uses_.clear();
+    names_.clear();
+    body_.clear();
+    ntemps_ = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (not is_a<Symbol>(*inputs[i]))
+            throw std::runtime_error("Inputs must be symbols.");
+        names_[inputs[i]] = "x[" + std::to_string(i) + "]";
+    }
+    for (const auto &p : outputs)
+        count_uses(p);
+
+    std::string assignments;
+    for (size_t i = 0; i < outputs.size(); i++) {
+        std::string value = print(outputs[i]);
+        assignments += "    out[" + std::to_string(i) + "] = " + value + ";\n";
+    }
+    std::string code = "#include <math.h>\n\nvoid " + name
+                       + "(const double *restrict x, double *restrict out)"
+                         "\n{\n";
+    code += body_;
+    code += assignments;
+    code += "}\n";
+    return code;
+}
+
+void CCodePrinter::count_uses(const RCP<const Basic> &x)
+{
+    if (is_atom(*x))
+        return;
+    // The arguments are visited only on the first use, so that every
+    // argument is counted once for each distinct expression using it.
+    if (uses_[x]++ == 0) {
+        for (const auto &p : x->get_args())
+            count_uses(p);
+    }
+}
+
+std::string CCodePrinter::print(const RCP<const Basic> &x)
+{
+    auto it = names_.find(x);
+    if (it != names_.end())
+        return it->second;
+    x->accept(*this);
+    std::string s = std::move(str_);
+    auto u = uses_.find(x);
+    if (u != uses_.end() and u->second > 1) {
+        s = new_temp(s);
+        names_[x] = s;
+    }
+    return s;
+}
+
+std::string CCodePrinter::print_factor(const RCP<const Basic> &x)
+{
+    std::string s = print(x);
+    if (names_.find(x) == names_.end()) {
+        Precedence prec;
+        if (prec.getPrecedence(x) < PrecedenceEnum::Mul)
+            return "(" + s + ")";
+    }
+    return s;
+}
+
+std::string CCodePrinter::print_name(const RCP<const Basic> &x)
+{
+    std::string s = print(x);
+    if (is_atom(*x) or names_.find(x) != names_.end())
+        return s;
+    s = new_temp(s);
+    names_[x] = s;
+    return s;
+}
+
+std::string CCodePrinter::new_temp(const std::string &value)
+{
+    std::string name = "t" + std::to_string(ntemps_++);
+    body_ += "    const double " + name + " = " + value + ";\n";
+    return name;
+}
+
+std::string CCodePrinter::power_chain(const std::string &base, unsigned n)
+{
+    // binary powering, the squares that are used again are temporaries
+    std::string r;
+    std::string p = base;
+    for (;;) {
+        if (n & 1)
+            r = r.empty() ? p : r + "*" + p;
+        n >>= 1;
+        if (n == 0)
+            break;
+        p = p + "*" + p;
+        if (n > 1)
+            p = new_temp(p);
+    }
+    return r;
+}
+
+void CCodePrinter::print_call(const char *f, const RCP<const Basic> &arg)
+{
+    std::string s = print(arg);
+    str_ = std::string(f) + "(" + s + ")";
+}
+
+void CCodePrinter::print_reciprocal(const char *f, const RCP<const Basic> &arg,
+                                    bool inverse_result)
+{
+    std::string s = print(arg);
+    if (inverse_result) {
+        str_ = "1.0/" + std::string(f) + "(" + s + ")";
+    } else {
+        if (not is_atom(*arg) and names_.find(arg) == names_.end())
+            s = "(" + s + ")";
+        str_ = std::string(f) + "(1.0/" + s + ")";
+    }
+}
+
+void CCodePrinter::bvisit(const Symbol &x)
+{
+    throw std::runtime_error("Symbol " + x.get_name()
+                             + " is not one of the inputs.");
+}
+
+void CCodePrinter::bvisit(const Number &x)
+{
+    str_ = double_literal(eval_double(x));
+}
+
+void CCodePrinter::bvisit(const Constant &x)
+{
+    str_ = double_literal(eval_double(x));
+}
+
+void CCodePrinter::bvisit(const Add &x)
+{
+    std::string r;
+    for (const auto &p : x.get_args()) {
+        std::string s = print(p);
+        if (r.empty())
+            r = std::move(s);
+        else
+            append_term(r, s);
+    }
+    str_ = std::move(r);
+}
+
+void CCodePrinter::bvisit(const Mul &x)
+{
+    std::string num, den;
+    unsigned nden = 0;
+    bool minus = false;
+    for (const auto &p : x.get_args()) {
+        if (is_a_Number(*p)) {
+            if (eq(*p, *minus_one)) {
+                minus = true;
+                continue;
+            }
+            num = print(p);
+            continue;
+        }
+        if (is_a<Pow>(*p)) {
+            const Pow &q = static_cast<const Pow &>(*p);
+            if (is_a_Number(*q.get_exp())
+                and static_cast<const Number &>(*q.get_exp()).is_negative()) {
+                // factors with negative exponents go to the denominator
+                RCP<const Basic> d = pow(q.get_base(), neg(q.get_exp()));
+                std::string s = print_factor(d);
+                den = den.empty() ? s : den + "*" + s;
+                nden++;
+                continue;
+            }
+        }
+        std::string s = print_factor(p);
+        num = num.empty() ? s : num + "*" + s;
+    }
+    if (num.empty())
+        num = "1.0";
+    if (not den.empty()) {
+        if (nden > 1 or den.find_first_of("*/") != std::string::npos)
+            den = "(" + den + ")";
+        num += "/" + den;
+    }
+    str_ = minus ? "-" + num : num;
+}
+
+void CCodePrinter::bvisit(const Pow &x)
+{
+    RCP<const Basic> base = x.get_base(), exp = x.get_exp();
+    if (eq(*base, *E)) {
+        print_call("exp", exp);
+        return;
+    }
+    if (is_a<Integer>(*exp)) {
+        const Integer &n = static_cast<const Integer &>(*exp);
+        if (mp_fits_slong_p(n.i)) {
+            long e = mp_get_si(n.i);
+            unsigned m = e < 0 ? -e : e;
+            if (m <= max_chain_power) {
+                std::string s = power_chain(print_name(base), m);
+                if (e < 0)
+                    s = m > 1 ? "1.0/(" + s + ")" : "1.0/" + s;
+                str_ = s;
+                return;
+            }
+        }
+    } else if (eq(*exp, *div(one, integer(2)))) {
+        print_call("sqrt", base);
+        return;
+    } else if (eq(*exp, *div(minus_one, integer(2)))) {
+        print_reciprocal("sqrt", base, true);
+        return;
+    }
+    std::string b = print(base);
+    str_ = "pow(" + b + ", " + print(exp) + ")";
+}
+
+void CCodePrinter::bvisit(const Sin &x)
+{
+    print_call("sin", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const Cos &x)
+{
+    print_call("cos", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const Tan &x)
+{
+    print_call("tan", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const Cot &x)
+{
+    print_reciprocal("tan", x.get_arg(), true);
+}
+
+void CCodePrinter::bvisit(const Csc &x)
+{
+    print_reciprocal("sin", x.get_arg(), true);
+}
+
+void CCodePrinter::bvisit(const Sec &x)
+{
+    print_reciprocal("cos", x.get_arg(), true);
+}
+
+void CCodePrinter::bvisit(const ASin &x)
+{
+    print_call("asin", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const ACos &x)
+{
+    print_call("acos", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const ATan &x)
+{
+    print_call("atan", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const ACot &x)
+{
+    print_reciprocal("atan", x.get_arg(), false);
+}
+
+void CCodePrinter::bvisit(const ASec &x)
+{
+    print_reciprocal("acos", x.get_arg(), false);
+}
+
+void CCodePrinter::bvisit(const ACsc &x)
+{
+    print_reciprocal("asin", x.get_arg(), false);
+}
+
+void CCodePrinter::bvisit(const Sinh &x)
+{
+    print_call("sinh", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const Cosh &x)
+{
+    print_call("cosh", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const Tanh &x)
+{
+    print_call("tanh", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const Coth &x)
+{
+    print_reciprocal("tanh", x.get_arg(), true);
+}
+
+void CCodePrinter::bvisit(const Csch &x)
+{
+    print_reciprocal("sinh", x.get_arg(), true);
+}
+
+void CCodePrinter::bvisit(const Sech &x)
+{
+    print_reciprocal("cosh", x.get_arg(), true);
+}
+
+void CCodePrinter::bvisit(const ASinh &x)
+{
+    print_call("asinh", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const ACosh &x)
+{
+    print_call("acosh", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const ATanh &x)
+{
+    print_call("atanh", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const ACoth &x)
+{
+    print_reciprocal("atanh", x.get_arg(), false);
+}
+
+void CCodePrinter::bvisit(const ACsch &x)
+{
+    print_reciprocal("asinh", x.get_arg(), false);
+}
+
+void CCodePrinter::bvisit(const ASech &x)
+{
+    print_reciprocal("acosh", x.get_arg(), false);
+}
+
+void CCodePrinter::bvisit(const Log &x)
+{
+    print_call("log", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const Abs &x)
+{
+    print_call("fabs", x.get_arg());
+}
+
+void CCodePrinter::bvisit(const ATan2 &x)
+{
+    std::string num = print(x.get_num());
+    str_ = "atan2(" + num + ", " + print(x.get_den()) + ")";
+}
+
+void CCodePrinter::bvisit(const Gamma &x)
+{
+    print_call("tgamma", x.get_args()[0]);
+}
+
+void CCodePrinter::bvisit(const LogGamma &x)
+{
+    print_call("lgamma", x.get_args()[0]);
+}
+
+void CCodePrinter::bvisit(const Erf &x)
+{
+    print_call("erf", x.get_args()[0]);
+}
+
+void CCodePrinter::bvisit(const Max &x)
+{
+    vec_basic args = x.get_args();
+    std::string r = print(args[0]);
+    for (size_t i = 1; i < args.size(); i++)
+        r = "fmax(" + r + ", " + print(args[i]) + ")";
+    str_ = std::move(r);
+}
+
+void CCodePrinter::bvisit(const Min &x)
+{
+    vec_basic args = x.get_args();
+    std::string r = print(args[0]);
+    for (size_t i = 1; i < args.size(); i++)
+        r = "fmin(" + r + ", " + print(args[i]) + ")";
+    str_ = std::move(r);
+}
+
+void CCodePrinter::bvisit(const Basic &x)
+{
+    throw std::runtime_error("Not implemented.");
+}
+
+CCodeLambdaDouble::CCodeLambdaDouble() : handle_(nullptr), func_(nullptr)
+{
+}
+
+CCodeLambdaDouble::~CCodeLambdaDouble()
+{
+#ifndef _WIN32
+    if (handle_ != nullptr)
+        dlclose(handle_);
+#endif
+}
+
+#ifndef _WIN32
+void CCodeLambdaDouble::init(const vec_basic &inputs, const vec_basic &outputs,
+                             const std::string &flags)
+{
+    CCodePrinter p;
+    code_ = p.apply("symengine_ccode", inputs, outputs);
+
+    const char *tmp = std::getenv("TMPDIR");
+    std::string dir = std::string(tmp != nullptr ? tmp : "/tmp")
+                      + "/symengine_XXXXXX";
+    if (mkdtemp(&dir[0]) == nullptr)
+        throw std::runtime_error("Cannot create a temporary directory.");
+    std::string src = dir + "/code.c", lib = dir + "/code.so";
+    {
+        std::ofstream out(src.c_str());
+        out << code_;
+    }
+    const char *cc = std::getenv("CC");
+    std::string cmd = std::string(cc != nullptr ? cc : "cc") + " -std=c99 "
+                      + flags + " -shared -fPIC -o '" + lib + "' '" + src
+                      + "' -lm";
+    int status = std::system(cmd.c_str());
+    void *handle = nullptr;
+    if (status == 0)
+        handle = dlopen(lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+    // the library stays loaded after its file is removed
+    std::remove(src.c_str());
+    std::remove(lib.c_str());
+    rmdir(dir.c_str());
+    if (status != 0)
+        throw std::runtime_error("Compiling the generated code failed.");
+    if (handle == nullptr)
+        throw std::runtime_error("Loading the compiled code failed.");
+    void *f = dlsym(handle, "symengine_ccode");
+    if (f == nullptr) {
+        dlclose(handle);
+        throw std::runtime_error("Loading the compiled code failed.");
+    }
+    if (handle_ != nullptr)
+        dlclose(handle_);
+    handle_ = handle;
+    func_ = reinterpret_cast<fn>(f);
+}
+#else
+void CCodeLambdaDouble::init(const vec_basic &inputs, const vec_basic &outputs,
+                             const std::string &flags)
+{
+    throw std::runtime_error("Compiled C code is not supported on Windows.");
+}
+#endif
+
+#if defined(__x86_64__) && !defined(_WIN32)
+namespace
+{
+
+//! Operand of an instruction: an input, a stack slot or a constant
+struct Operand {
+    enum Kind { INPUT, SLOT, CONST } kind;
+    unsigned index;
+    double value;
+};
+
+// SSE2 opcodes, following the prefix 0xF2 0x0F
+enum SSEOp : unsigned char {
+    MOVSD = 0x10,
+    STORESD = 0x11,
+    SQRTSD = 0x51,
+    ADDSD = 0x58,
+    MULSD = 0x59,
+    SUBSD = 0x5C,
+    MINSD = 0x5D,
+    DIVSD = 0x5E,
+    MAXSD = 0x5F
+};
+
+typedef double (*unary_fn)(double);
+typedef double (*binary_fn)(double, double);
+
+//! Emits the x86-64 code of `void f(const double *x, double *out)`. The
+//! arguments are kept in rbx and r12, and the intermediate values in stack
+//! slots addressed relative to rsp. The result of every node is computed in
+//! xmm0; xmm1 and xmm2 are scratch registers and xmm7 holds constants.
+class X86Emitter : public BaseVisitor<X86Emitter>
+{
+public:
+    std::vector<unsigned char> code_;
+
+    X86Emitter(const vec_basic &inputs) : nslots_(0)
+    {
+        for (size_t i = 0; i < inputs.size(); i++) {
+            if (not is_a<Symbol>(*inputs[i]))
+                throw std::runtime_error("Inputs must be symbols.");
+            inputs_[inputs[i]] = i;
+        }
+    }
+
+    void emit_function(const vec_basic &outputs)
+    {
+        for (const auto &p : outputs)
+            count_uses(p);
+        // push rbx; push r12; mov rbx, rdi; mov r12, rsi
+        emit({0x53, 0x41, 0x54, 0x48, 0x89, 0xFB, 0x49, 0x89, 0xF4});
+        // sub rsp, imm32, patched below once the number of slots is known
+        emit({0x48, 0x81, 0xEC});
+        size_t frame_pos = code_.size();
+        emit_u32(0);
+        for (size_t i = 0; i < outputs.size(); i++) {
+            Operand v = value(outputs[i]);
+            load(0, v);
+            // movsd [r12 + 8*i], xmm0
+            emit({0xF2, 0x41, 0x0F, STORESD, 0x84, 0x24});
+            emit_u32(8 * i);
+            release(outputs[i], v);
+        }
+        // the stack pointer is 16 byte aligned at calls
+        unsigned frame = 8 * nslots_;
+        if (frame % 16 == 0)
+            frame += 8;
+        for (unsigned i = 0; i < 4; i++)
+            code_[frame_pos + i] = (frame >> (8 * i)) & 0xFF;
+        // add rsp, imm32; pop r12; pop rbx; ret
+        emit({0x48, 0x81, 0xC4});
+        emit_u32(frame);
+        emit({0x41, 0x5C, 0x5B, 0xC3});
+    }
+
+    void bvisit(const Add &x)
+    {
+        bool first = true;
+        if (not x.coef_->is_exact_zero()) {
+            load(0, constant(eval_double(*x.coef_)));
+            first = false;
+        }
+        size_t i = 0;
+        for (const auto &p : x.dict_) {
+            const Operand &v = args_[i++];
+            double c = eval_double(*p.second);
+            if (c == 1.0) {
+                if (first)
+                    load(0, v);
+                else
+                    op(ADDSD, 0, v);
+            } else {
+                load(1, v);
+                op(MULSD, 1, constant(c));
+                op_rr(first ? MOVSD : ADDSD, 0, 1);
+            }
+            first = false;
+        }
+    }
+
+    void bvisit(const Mul &x)
+    {
+        load(0, args_[0]);
+        for (size_t i = 1; i < args_.size(); i++)
+            op(MULSD, 0, args_[i]);
+    }
+
+    void bvisit(const Pow &x)
+    {
+        const Operand &base = args_[0], &exp = args_[1];
+        if (eq(*x.get_base(), *E)) {
+            call(std::exp, exp);
+            return;
+        }
+        if (is_a<Integer>(*x.get_exp())) {
+            const Integer &n = static_cast<const Integer &>(*x.get_exp());
+            if (mp_fits_slong_p(n.i)) {
+                long e = mp_get_si(n.i);
+                unsigned m = e < 0 ? -e : e;
+                if (m <= CCodePrinter::max_chain_power) {
+                    power_chain(base, m);
+                    if (e < 0) {
+                        load(0, constant(1.0));
+                        op_rr(DIVSD, 0, 2);
+                    } else {
+                        op_rr(MOVSD, 0, 2);
+                    }
+                    return;
+                }
+            }
+        }
+        if (exp.kind == Operand::CONST and exp.value == 0.5) {
+            op(SQRTSD, 0, base);
+            return;
+        }
+        call(std::pow, base, exp);
+    }
+
+#define SYMENGINE_JIT_CALL(Class, f)                                           \
+    void bvisit(const Class &x)                                                \
+    {                                                                          \
+        call(f, args_[0]);                                                     \
+    }
+#define SYMENGINE_JIT_INV_CALL(Class, f)                                       \
+    void bvisit(const Class &x)                                                \
+    {                                                                          \
+        call(f, args_[0]);                                                     \
+        op_rr(MOVSD, 1, 0);                                                    \
+        load(0, constant(1.0));                                                \
+        op_rr(DIVSD, 0, 1);                                                    \
+    }
+#define SYMENGINE_JIT_CALL_INV(Class, f)                                       \
+    void bvisit(const Class &x)                                                \
+    {                                                                          \
+        load(0, constant(1.0));                                                \
+        op(DIVSD, 0, args_[0]);                                                \
+        call(f);                                                               \
+    }
+
+    SYMENGINE_JIT_CALL(Sin, std::sin)
+    SYMENGINE_JIT_CALL(Cos, std::cos)
+    SYMENGINE_JIT_CALL(Tan, std::tan)
+    SYMENGINE_JIT_INV_CALL(Cot, std::tan)
+    SYMENGINE_JIT_INV_CALL(Csc, std::sin)
+    SYMENGINE_JIT_INV_CALL(Sec, std::cos)
+    SYMENGINE_JIT_CALL(ASin, std::asin)
+    SYMENGINE_JIT_CALL(ACos, std::acos)
+    SYMENGINE_JIT_CALL(ATan, std::atan)
+    SYMENGINE_JIT_CALL_INV(ACot, std::atan)
+    SYMENGINE_JIT_CALL_INV(ASec, std::acos)
+    SYMENGINE_JIT_CALL_INV(ACsc, std::asin)
+    SYMENGINE_JIT_CALL(Sinh, std::sinh)
+    SYMENGINE_JIT_CALL(Cosh, std::cosh)
+    SYMENGINE_JIT_CALL(Tanh, std::tanh)
+    SYMENGINE_JIT_INV_CALL(Coth, std::tanh)
+    SYMENGINE_JIT_INV_CALL(Csch, std::sinh)
+    SYMENGINE_JIT_INV_CALL(Sech, std::cosh)
+    SYMENGINE_JIT_CALL(ASinh, std::asinh)
+    SYMENGINE_JIT_CALL(ACosh, std::acosh)
+    SYMENGINE_JIT_CALL(ATanh, std::atanh)
+    SYMENGINE_JIT_CALL_INV(ACoth, std::atanh)
+    SYMENGINE_JIT_CALL_INV(ACsch, std::asinh)
+    SYMENGINE_JIT_CALL_INV(ASech, std::acosh)
+    SYMENGINE_JIT_CALL(Log, std::log)
+    SYMENGINE_JIT_CALL(Abs, std::fabs)
+    SYMENGINE_JIT_CALL(Gamma, std::tgamma)
+    SYMENGINE_JIT_CALL(LogGamma, std::lgamma)
+    SYMENGINE_JIT_CALL(Erf, std::erf)
+
+#undef SYMENGINE_JIT_CALL
+#undef SYMENGINE_JIT_INV_CALL
+#undef SYMENGINE_JIT_CALL_INV
+
+    void bvisit(const ATan2 &x)
+    {
+        call(std::atan2, args_[0], args_[1]);
+    }
+
+    void bvisit(const Max &x)
+    {
+        load(0, args_[0]);
+        for (size_t i = 1; i < args_.size(); i++)
+            op(MAXSD, 0, args_[i]);
+    }
+
+    void bvisit(const Min &x)
+    {
+        load(0, args_[0]);
+        for (size_t i = 1; i < args_.size(); i++)
+            op(MINSD, 0, args_[i]);
+    }
+
+    void bvisit(const Basic &x)
+    {
+        throw std::runtime_error("Not implemented.");
+    }
+
+private:
+    std::unordered_map<RCP<const Basic>, unsigned, RCPBasicHash,
+                       RCPBasicKeyEq> inputs_;
+    //! remaining uses of the subexpressions
+    umap_basic_uint uses_;
+    //! slots of the subexpressions computed so far
+    umap_basic_uint slots_;
+    std::vector<unsigned> free_slots_;
+    unsigned nslots_;
+    //! operands of the node being visited
+    std::vector<Operand> args_;
+
+    static bool is_atom(const Basic &x)
+    {
+        return is_a_Number(x) or is_a<Symbol>(x) or is_a<Constant>(x);
+    }
+
+    //! The terms of an Add are its children, the coefficients are constants
+    static vec_basic children(const Basic &x)
+    {
+        if (is_a<Add>(x)) {
+            vec_basic v;
+            for (const auto &p : static_cast<const Add &>(x).dict_)
+                v.push_back(p.first);
+            return v;
+        }
+        return x.get_args();
+    }
+
+    void count_uses(const RCP<const Basic> &x)
+    {
+        if (is_atom(*x))
+            return;
+        if (uses_[x]++ == 0) {
+            for (const auto &p : children(*x))
+                count_uses(p);
+        }
+    }
+
+    static Operand constant(double d)
+    {
+        return {Operand::CONST, 0, d};
+    }
+
+    Operand value(const RCP<const Basic> &x)
+    {
+        if (is_a<Symbol>(*x)) {
+            auto it = inputs_.find(x);
+            if (it == inputs_.end())
+                throw std::runtime_error("Symbol not in the symbols vector.");
+            return {Operand::INPUT, it->second, 0.0};
+        }
+        if (is_atom(*x))
+            return constant(eval_double(*x));
+        auto it = slots_.find(x);
+        if (it != slots_.end())
+            return {Operand::SLOT, it->second, 0.0};
+
+        vec_basic c = children(*x);
+        std::vector<Operand> args;
+        for (const auto &p : c)
+            args.push_back(value(p));
+        args_ = std::move(args);
+        x->accept(*this);
+        for (size_t i = 0; i < c.size(); i++)
+            release(c[i], args_[i]);
+
+        unsigned slot;
+        if (free_slots_.empty()) {
+            slot = nslots_++;
+        } else {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        slots_[x] = slot;
+        // movsd [rsp + 8*slot], xmm0
+        emit({0xF2, 0x0F, STORESD, 0x84, 0x24});
+        emit_u32(8 * slot);
+        return {Operand::SLOT, slot, 0.0};
+    }
+
+    //! Frees the slot of `x` after its last use
+    void release(const RCP<const Basic> &x, const Operand &v)
+    {
+        if (v.kind != Operand::SLOT)
+            return;
+        auto it = uses_.find(x);
+        if (--(it->second) == 0) {
+            free_slots_.push_back(v.index);
+            slots_.erase(x);
+        }
+    }
+
+    void emit(std::initializer_list<unsigned char> bytes)
+    {
+        code_.insert(code_.end(), bytes);
+    }
+
+    void emit_u32(unsigned v)
+    {
+        for (unsigned i = 0; i < 4; i++)
+            code_.push_back((v >> (8 * i)) & 0xFF);
+    }
+
+    void emit_u64(std::uint64_t v)
+    {
+        for (unsigned i = 0; i < 8; i++)
+            code_.push_back((v >> (8 * i)) & 0xFF);
+    }
+
+    //! mov rax, imm64
+    void load_rax(std::uint64_t v)
+    {
+        emit({0x48, 0xB8});
+        emit_u64(v);
+    }
+
+    //! op xmm`dst`, xmm`src`
+    void op_rr(SSEOp opcode, unsigned dst, unsigned src)
+    {
+        emit({0xF2, 0x0F, opcode, (unsigned char)(0xC0 | dst << 3 | src)});
+    }
+
+    //! op xmm`reg`, `v`
+    void op(SSEOp opcode, unsigned reg, const Operand &v)
+    {
+        if (v.kind == Operand::CONST) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &v.value, sizeof(bits));
+            load_rax(bits);
+            // movq xmm7, rax
+            emit({0x66, 0x48, 0x0F, 0x6E, 0xF8});
+            op_rr(opcode, reg, 7);
+        } else if (v.kind == Operand::INPUT) {
+            // op xmm, [rbx + 8*index]
+            emit({0xF2, 0x0F, opcode, (unsigned char)(0x83 | reg << 3)});
+            emit_u32(8 * v.index);
+        } else {
+            // op xmm, [rsp + 8*index]
+            emit({0xF2, 0x0F, opcode, (unsigned char)(0x84 | reg << 3), 0x24});
+            emit_u32(8 * v.index);
+        }
+    }
+
+    void load(unsigned reg, const Operand &v)
+    {
+        op(MOVSD, reg, v);
+    }
+
+    //! Computes `base**n` in xmm2, by repeated squaring in xmm1
+    void power_chain(const Operand &base, unsigned n)
+    {
+        load(1, base);
+        bool first = true;
+        for (;;) {
+            if (n & 1) {
+                op_rr(first ? MOVSD : MULSD, 2, 1);
+                first = false;
+            }
+            n >>= 1;
+            if (n == 0)
+                break;
+            op_rr(MULSD, 1, 1);
+        }
+    }
+
+    //! call f, with the arguments in xmm0 and xmm1
+    void call(const void *f)
+    {
+        load_rax(reinterpret_cast<std::uint64_t>(f));
+        // call rax
+        emit({0xFF, 0xD0});
+    }
+
+    void call(unary_fn f, const Operand &a)
+    {
+        load(0, a);
+        call(reinterpret_cast<const void *>(f));
+    }
+
+    void call(unary_fn f)
+    {
+        call(reinterpret_cast<const void *>(f));
+    }
+
+    void call(binary_fn f, const Operand &a, const Operand &b)
+    {
+        load(0, a);
+        load(1, b);
+        call(reinterpret_cast<const void *>(f));
+    }
+};
+
+} // anonymous namespace
+#endif
+
+JITLambdaDouble::JITLambdaDouble() : code_(nullptr), size_(0), func_(nullptr)
+{
+}
+
+JITLambdaDouble::~JITLambdaDouble()
+{
+    release();
+}
+
+#if defined(__x86_64__) && !defined(_WIN32)
+void JITLambdaDouble::init(const vec_basic &inputs, const vec_basic &outputs)
+{
+    X86Emitter e(inputs);
+    e.emit_function(outputs);
+
+    void *p = mmap(nullptr, e.code_.size(), PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        throw std::runtime_error("Cannot allocate memory for the code.");
+    std::memcpy(p, e.code_.data(), e.code_.size());
+    if (mprotect(p, e.code_.size(), PROT_READ | PROT_EXEC) != 0) {
+        munmap(p, e.code_.size());
+        throw std::runtime_error("Cannot make the code executable.");
+    }
+    release();
+    code_ = p;
+    size_ = e.code_.size();
+    func_ = reinterpret_cast<fn>(p);
+}
+
+void JITLambdaDouble::release()
+{
+    if (code_ != nullptr)
+        munmap(code_, size_);
+    code_ = nullptr;
+    size_ = 0;
+}
+#else
+void JITLambdaDouble::init(const vec_basic &inputs, const vec_basic &outputs)
+{
+    throw std::runtime_error(
+        "Machine code generation is only supported on x86-64.");
+}
+
+void JITLambdaDouble::release()
+{
+}
+#endif
+
+} // SymEngine
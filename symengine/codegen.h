@@ -0,0 +1,174 @@
+/**
+ *  \file codegen.h
+ *  Generation of C and machine code for the numerical evaluation of
+ *  expressions
+ *
+ **/
+#ifndef SYMENGINE_CODEGEN_H
+#define SYMENGINE_CODEGEN_H
+
+#include <symengine/basic.h>
+#include <symengine/dict.h>
+#include <symengine/visitor.h>
+
+namespace SymEngine
+{
+
+//! Prints expressions as a C99 function
+//!
+//!     void name(const double *restrict x, double *restrict out)
+//!
+//! that evaluates `outputs` in double precision and stores them to `out`,
+//! where `x[i]` is the value of the `i`-th input symbol. Subexpressions used
+//! more than once are computed only once, into a temporary. Integer powers
+//! up to `max_chain_power` are computed by repeated squaring and
+//! multiplication instead of calling `pow`.
+class CCodePrinter : public BaseVisitor<CCodePrinter>
+{
+public:
+    static const unsigned max_chain_power = 16;
+
+    std::string apply(const std::string &name, const vec_basic &inputs,
+                      const vec_basic &outputs);
+
+    void bvisit(const Symbol &x);
+    void bvisit(const Number &x);
+    void bvisit(const Constant &x);
+    void bvisit(const Add &x);
+    void bvisit(const Mul &x);
+    void bvisit(const Pow &x);
+    void bvisit(const Sin &x);
+    void bvisit(const Cos &x);
+    void bvisit(const Tan &x);
+    void bvisit(const Cot &x);
+    void bvisit(const Csc &x);
+    void bvisit(const Sec &x);
+    void bvisit(const ASin &x);
+    void bvisit(const ACos &x);
+    void bvisit(const ATan &x);
+    void bvisit(const ACot &x);
+    void bvisit(const ASec &x);
+    void bvisit(const ACsc &x);
+    void bvisit(const Sinh &x);
+    void bvisit(const Cosh &x);
+    void bvisit(const Tanh &x);
+    void bvisit(const Coth &x);
+    void bvisit(const Csch &x);
+    void bvisit(const Sech &x);
+    void bvisit(const ASinh &x);
+    void bvisit(const ACosh &x);
+    void bvisit(const ATanh &x);
+    void bvisit(const ACoth &x);
+    void bvisit(const ACsch &x);
+    void bvisit(const ASech &x);
+    void bvisit(const Log &x);
+    void bvisit(const Abs &x);
+    void bvisit(const ATan2 &x);
+    void bvisit(const Gamma &x);
+    void bvisit(const LogGamma &x);
+    void bvisit(const Erf &x);
+    void bvisit(const Max &x);
+    void bvisit(const Min &x);
+    void bvisit(const Basic &x);
+
+private:
+    std::string str_;
+    //! statements computing the temporaries
+    std::string body_;
+    unsigned ntemps_;
+    //! number of uses of every subexpression
+    umap_basic_uint uses_;
+    //! names of the inputs and of the temporaries computed so far
+    std::unordered_map<RCP<const Basic>, std::string, RCPBasicHash,
+                       RCPBasicKeyEq> names_;
+
+    void count_uses(const RCP<const Basic> &x);
+    //! \return C expression of `x`, a temporary if `x` is used more than once
+    std::string print(const RCP<const Basic> &x);
+    //! Prints `x` in parentheses if its precedence is lower than Mul
+    std::string print_factor(const RCP<const Basic> &x);
+    //! \return a name (or a literal) holding the value of `x`
+    std::string print_name(const RCP<const Basic> &x);
+    std::string new_temp(const std::string &value);
+    std::string power_chain(const std::string &base, unsigned n);
+    void print_call(const char *f, const RCP<const Basic> &arg);
+    //! Prints `f(1.0/arg)`, or `1.0/f(arg)` if `inverse_result`
+    void print_reciprocal(const char *f, const RCP<const Basic> &arg,
+                          bool inverse_result);
+};
+
+//! Evaluates expressions with C code generated by `CCodePrinter`, compiled
+//! with the system C compiler (`$CC` if set, `cc` otherwise) into a shared
+//! library that is then loaded with `dlopen`. Only available on POSIX
+//! systems.
+class CCodeLambdaDouble
+{
+public:
+    CCodeLambdaDouble();
+    ~CCodeLambdaDouble();
+    CCodeLambdaDouble(const CCodeLambdaDouble &) = delete;
+    CCodeLambdaDouble &operator=(const CCodeLambdaDouble &) = delete;
+
+    //! Compiles `outputs` as functions of the symbols `inputs`, with the
+    //! compiler options `flags`. Throws `std::runtime_error` if the code
+    //! cannot be compiled or loaded.
+    void init(const vec_basic &inputs, const vec_basic &outputs,
+              const std::string &flags = "-O2");
+    //! Evaluates the outputs at `inps` and stores them to `outs`
+    void call(double *outs, const double *inps) const
+    {
+        func_(inps, outs);
+    }
+    //! \return the C code that was compiled
+    const std::string &get_code() const
+    {
+        return code_;
+    }
+
+private:
+    typedef void (*fn)(const double *, double *);
+    void *handle_;
+    fn func_;
+    std::string code_;
+};
+
+//! Evaluates expressions with x86-64 machine code generated in process,
+//! without a compiler. The supported functions are the ones of
+//! `LambdaRealDoubleVisitor`; functions without an SSE2 instruction are
+//! calls to the C math library. Every subexpression is computed once and
+//! stored in a stack slot that is reused after its last use. Only available
+//! on x86-64 POSIX systems.
+class JITLambdaDouble
+{
+public:
+    JITLambdaDouble();
+    ~JITLambdaDouble();
+    JITLambdaDouble(const JITLambdaDouble &) = delete;
+    JITLambdaDouble &operator=(const JITLambdaDouble &) = delete;
+
+    //! Generates the code evaluating `outputs` as functions of the symbols
+    //! `inputs`. Throws `std::runtime_error` for unsupported expressions.
+    void init(const vec_basic &inputs, const vec_basic &outputs);
+    //! Evaluates the outputs at `inps` and stores them to `outs`
+    void call(double *outs, const double *inps) const
+    {
+        func_(inps, outs);
+    }
+    //! \return the size of the generated code in bytes
+    std::size_t code_size() const
+    {
+        return size_;
+    }
+
+private:
+    typedef void (*fn)(const double *, double *);
+    void *code_;
+    std::size_t size_;
+    fn func_;
+
+    void release();
+};
+
+} // SymEngine
+
+#endif
@@ -35,19 +35,31 @@ int Constant::compare(const Basic &o) const
     return name_ < s.name_ ? -1 : 1;
 }
 
-RCP<const Integer> zero = integer(0);
-RCP<const Integer> one = integer(1);
-RCP<const Integer> minus_one = integer(-1);
-RCP<const Number> I = Complex::from_two_nums(*zero, *one);
+namespace
+{
+//! The global constants are shared by all threads, so they are not
+//! reference counted where this is supported
+template <class T>
+RCP<T> immortal(RCP<T> x)
+{
+    x->make_immortal();
+    return x;
+}
+}
+
+RCP<const Integer> zero = immortal(integer(0));
+RCP<const Integer> one = immortal(integer(1));
+RCP<const Integer> minus_one = immortal(integer(-1));
+RCP<const Number> I = immortal(Complex::from_two_nums(*zero, *one));
 
-RCP<const Constant> pi = constant("pi");
-RCP<const Constant> E = constant("E");
-RCP<const Constant> EulerGamma = constant("EulerGamma");
+RCP<const Constant> pi = immortal(constant("pi"));
+RCP<const Constant> E = immortal(constant("E"));
+RCP<const Constant> EulerGamma = immortal(constant("EulerGamma"));
 
 // Global variables declared in functions.cpp
 // Look over https://github.com/sympy/symengine/issues/272
 // for further details
-RCP<const Basic> i2 = integer(2);
+RCP<const Basic> i2 = immortal(integer(2));
 
 namespace
 {
@@ -57,31 +69,31 @@ RCP<const Basic> sqrt_(const RCP<const Basic> &arg)
 }
 }
 
-RCP<const Basic> i3 = integer(3);
-RCP<const Basic> i5 = integer(5);
-RCP<const Basic> im2 = integer(-2);
-RCP<const Basic> im3 = integer(-3);
-RCP<const Basic> im5 = integer(-5);
-
-RCP<const Basic> sq3 = sqrt_(i3);
-RCP<const Basic> sq2 = sqrt_(i2);
-RCP<const Basic> sq5 = sqrt_(i5);
-
-RCP<const Basic> C0 = div(sub(sq3, one), mul(i2, sq2));
-RCP<const Basic> C1 = div(one, i2);
-RCP<const Basic> C2 = div(sq2, i2);
-RCP<const Basic> C3 = div(sq3, i2);
-RCP<const Basic> C4 = div(add(sq3, one), mul(i2, sq2));
-RCP<const Basic> C5 = div(sqrt_(sub(i5, sqrt_(i5))), integer(8));
-RCP<const Basic> C6 = div(sub(sqrt_(i5), one), integer(4));
-
-RCP<const Basic> mC0 = mul(minus_one, C0);
-RCP<const Basic> mC1 = mul(minus_one, C1);
-RCP<const Basic> mC2 = mul(minus_one, C2);
-RCP<const Basic> mC3 = mul(minus_one, C3);
-RCP<const Basic> mC4 = mul(minus_one, C4);
-RCP<const Basic> mC5 = mul(minus_one, C5);
-RCP<const Basic> mC6 = mul(minus_one, C6);
+RCP<const Basic> i3 = immortal(integer(3));
+RCP<const Basic> i5 = immortal(integer(5));
+RCP<const Basic> im2 = immortal(integer(-2));
+RCP<const Basic> im3 = immortal(integer(-3));
+RCP<const Basic> im5 = immortal(integer(-5));
+
+RCP<const Basic> sq3 = immortal(sqrt_(i3));
+RCP<const Basic> sq2 = immortal(sqrt_(i2));
+RCP<const Basic> sq5 = immortal(sqrt_(i5));
+
+RCP<const Basic> C0 = immortal(div(sub(sq3, one), mul(i2, sq2)));
+RCP<const Basic> C1 = immortal(div(one, i2));
+RCP<const Basic> C2 = immortal(div(sq2, i2));
+RCP<const Basic> C3 = immortal(div(sq3, i2));
+RCP<const Basic> C4 = immortal(div(add(sq3, one), mul(i2, sq2)));
+RCP<const Basic> C5 = immortal(div(sqrt_(sub(i5, sqrt_(i5))), integer(8)));
+RCP<const Basic> C6 = immortal(div(sub(sqrt_(i5), one), integer(4)));
+
+RCP<const Basic> mC0 = immortal(mul(minus_one, C0));
+RCP<const Basic> mC1 = immortal(mul(minus_one, C1));
+RCP<const Basic> mC2 = immortal(mul(minus_one, C2));
+RCP<const Basic> mC3 = immortal(mul(minus_one, C3));
+RCP<const Basic> mC4 = immortal(mul(minus_one, C4));
+RCP<const Basic> mC5 = immortal(mul(minus_one, C5));
+RCP<const Basic> mC6 = immortal(mul(minus_one, C6));
 
 // sin_table[n] represents the value of sin(2*pi*n/24) for n = 0..23
 RCP<const Basic> sin_table[]
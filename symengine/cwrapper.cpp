@@ -15,6 +15,10 @@
 #include <symengine/constants.h>
 #include <symengine/visitor.h>
 #include <symengine/printer.h>
+#include <symengine/serialize.h>
+#include <symengine/codegen.h>
+#include <symengine/eval_double.h>
+#include <symengine/lambda_double.h>
 
 #define xstr(s) str(s)
 #define str(s) #s
@@ -466,6 +470,32 @@ size_t vecbasic_size(CVecBasic *self)
     return self->m.size();
 }
 
+char *vecbasic_serialize(CVecBasic *self, size_t *size)
+{
+    std::string str;
+    try {
+        str = SymEngine::serialize(self->m);
+    } catch (std::runtime_error &) {
+        return NULL;
+    }
+    auto cc = new char[str.length()];
+    std::memcpy(cc, str.data(), str.length());
+    *size = str.length();
+    return cc;
+}
+
+int vecbasic_deserialize(CVecBasic *self, const char *data, size_t size)
+{
+    SymEngine::vec_basic v;
+    try {
+        v = SymEngine::deserialize(data, data + size);
+    } catch (std::runtime_error &) {
+        return 0;
+    }
+    self->m.insert(self->m.end(), v.begin(), v.end());
+    return 1;
+}
+
 // C Wrapper for set_basic
 
 struct CSetBasic {
@@ -566,6 +596,114 @@ void basic_subs2(basic s, const basic e, const basic a, const basic b)
     s->m = e->m->subs({{a->m, b->m}});
 }
 
+void vecbasic_subs(CVecBasic *result, const CVecBasic *self,
+                   const CMapBasicBasic *mapbb)
+{
+    SymEngine::vec_basic v;
+    v.reserve(self->m.size());
+    for (const auto &p : self->m)
+        v.push_back(p->subs(mapbb->m));
+    result->m = std::move(v);
+}
+
+int vecbasic_diff(CVecBasic *result, const CVecBasic *self, const basic sym)
+{
+    if (not is_a_Symbol(sym))
+        return 0;
+    RCP<const Symbol> x = rcp_static_cast<const Symbol>(sym->m);
+    SymEngine::vec_basic v;
+    v.reserve(self->m.size());
+    for (const auto &p : self->m)
+        v.push_back(p->diff(x));
+    result->m = std::move(v);
+    return 1;
+}
+
+void vecbasic_expand(CVecBasic *result, const CVecBasic *self)
+{
+    SymEngine::vec_basic v;
+    v.reserve(self->m.size());
+    for (const auto &p : self->m)
+        v.push_back(SymEngine::expand(p));
+    result->m = std::move(v);
+}
+
+int vecbasic_eval_double(double *values, const CVecBasic *self)
+{
+    try {
+        for (size_t i = 0; i < self->m.size(); i++)
+            values[i] = SymEngine::eval_double(*self->m[i]);
+    } catch (std::runtime_error &) {
+        return 0;
+    }
+    return 1;
+}
+
+struct CLambdaRealDouble {
+    SymEngine::JITLambdaDouble jit;
+    //! used where machine code cannot be generated
+    std::vector<SymEngine::LambdaRealDoubleVisitor> visitors;
+    bool use_jit;
+    size_t ninputs;
+    size_t noutputs;
+};
+
+CLambdaRealDouble *lambda_real_double_new()
+{
+    CLambdaRealDouble *self = new CLambdaRealDouble;
+    self->use_jit = false;
+    self->ninputs = self->noutputs = 0;
+    return self;
+}
+
+void lambda_real_double_free(CLambdaRealDouble *self)
+{
+    delete self;
+}
+
+int lambda_real_double_init(CLambdaRealDouble *self, const CVecBasic *inputs,
+                            const CVecBasic *outputs)
+{
+    self->ninputs = inputs->m.size();
+    self->noutputs = outputs->m.size();
+    self->visitors.clear();
+    try {
+        self->jit.init(inputs->m, outputs->m);
+        self->use_jit = true;
+        return 1;
+    } catch (std::runtime_error &) {
+        self->use_jit = false;
+    }
+    try {
+        self->visitors.resize(self->noutputs);
+        for (size_t i = 0; i < self->noutputs; i++)
+            self->visitors[i].init(inputs->m, *outputs->m[i]);
+    } catch (std::runtime_error &) {
+        self->visitors.clear();
+        self->ninputs = self->noutputs = 0;
+        return 0;
+    }
+    return 1;
+}
+
+void lambda_real_double_call(CLambdaRealDouble *self, double *outs,
+                             const double *inps, size_t n)
+{
+    if (self->use_jit) {
+        for (size_t i = 0; i < n; i++)
+            self->jit.call(outs + i * self->noutputs,
+                           inps + i * self->ninputs);
+        return;
+    }
+    std::vector<double> x(self->ninputs);
+    for (size_t i = 0; i < n; i++) {
+        std::copy(inps + i * self->ninputs, inps + (i + 1) * self->ninputs,
+                  x.begin());
+        for (size_t j = 0; j < self->noutputs; j++)
+            outs[i * self->noutputs + j] = self->visitors[j].call(x);
+    }
+}
+
 // ----------------------
 
 char *ascii_art_str()
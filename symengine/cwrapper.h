@@ -289,6 +289,13 @@ void vecbasic_free(CVecBasic *self);
 void vecbasic_push_back(CVecBasic *self, const basic value);
 void vecbasic_get(CVecBasic *self, int n, basic result);
 size_t vecbasic_size(CVecBasic *self);
+//! Serializes the expressions in `self` into a binary buffer whose length is
+//! stored in `size`. The caller is responsible to free the buffer using
+//! 'basic_str_free'. Returns NULL if an expression is not supported.
+char *vecbasic_serialize(CVecBasic *self, size_t *size);
+//! Appends the expressions serialized in the `size` bytes of `data` to
+//! `self`. Returns 0 if the data is not valid.
+int vecbasic_deserialize(CVecBasic *self, const char *data, size_t size);
 
 //! Wrapper for set_basic
 
@@ -331,6 +338,40 @@ void basic_subs(basic s, const basic e, const CMapBasicBasic *mapbb);
 //! in the given basic 'e' and returns it through basic 's'
 void basic_subs2(basic s, const basic e, const basic a, const basic b);
 
+//! Batch operations on all the expressions of a CVecBasic. The results
+//! replace the contents of `result`, which may be the same as `self`.
+
+//! Substitutes the keys of `mapbb` with their mapped values in every
+//! expression of `self`
+void vecbasic_subs(CVecBasic *result, const CVecBasic *self,
+                   const CMapBasicBasic *mapbb);
+//! Differentiates every expression of `self` with respect to `sym`. Returns 0
+//! if sym is not a symbol.
+int vecbasic_diff(CVecBasic *result, const CVecBasic *self, const basic sym);
+//! Expands every expression of `self`
+void vecbasic_expand(CVecBasic *result, const CVecBasic *self);
+//! Evaluates every expression of `self` to a double, and stores the values to
+//! the array `values` of `vecbasic_size(self)` elements. Returns 0 if an
+//! expression cannot be evaluated to a real double.
+int vecbasic_eval_double(double *values, const CVecBasic *self);
+
+//! Wrapper for compiled evaluation of expressions, using machine code
+//! generated in process where supported and LambdaRealDoubleVisitor otherwise
+
+typedef struct CLambdaRealDouble CLambdaRealDouble;
+
+CLambdaRealDouble *lambda_real_double_new();
+void lambda_real_double_free(CLambdaRealDouble *self);
+//! Compiles the expressions `outputs` as functions of the symbols `inputs`.
+//! Returns 0 if an expression is not supported.
+int lambda_real_double_init(CLambdaRealDouble *self, const CVecBasic *inputs,
+                            const CVecBasic *outputs);
+//! Evaluates the outputs at `n` points. The values of the inputs at the
+//! `i`-th point are `inps[i*ninputs]` to `inps[(i+1)*ninputs-1]`, and the
+//! outputs are stored likewise to `outs`.
+void lambda_real_double_call(CLambdaRealDouble *self, double *outs,
+                             const double *inps, size_t n);
+
 //! Wrapper for ascii_art()
 
 //! Returns a new char pointer to the ascii_art string
@@ -0,0 +1,309 @@
+/**
+ *  \file dual_double.h
+ *  Dual numbers in double precision
+ *
+ **/
+#ifndef SYMENGINE_DUAL_DOUBLE_H
+#define SYMENGINE_DUAL_DOUBLE_H
+
+#include <cmath>
+#include <symengine/special_double.h>
+
+namespace SymEngine
+{
+
+//! Dual number `v + d[0]*e_0 + ... + d[N-1]*e_{N-1}` with `e_i*e_j = 0`.
+//! Evaluating a function `f` at a dual number with tangents `d` gives
+//! `f(v)` and the directional derivatives of `f` along the `N` tangents.
+template <unsigned N>
+class DualDouble
+{
+public:
+    double v;
+    double d[N];
+
+    DualDouble(double x = 0) : v(x)
+    {
+        for (unsigned i = 0; i < N; i++)
+            d[i] = 0;
+    }
+
+    DualDouble &operator+=(const DualDouble &y)
+    {
+        v += y.v;
+        for (unsigned i = 0; i < N; i++)
+            d[i] += y.d[i];
+        return *this;
+    }
+
+    DualDouble &operator-=(const DualDouble &y)
+    {
+        v -= y.v;
+        for (unsigned i = 0; i < N; i++)
+            d[i] -= y.d[i];
+        return *this;
+    }
+
+    DualDouble &operator*=(const DualDouble &y)
+    {
+        for (unsigned i = 0; i < N; i++)
+            d[i] = d[i] * y.v + v * y.d[i];
+        v *= y.v;
+        return *this;
+    }
+
+    DualDouble &operator/=(const DualDouble &y)
+    {
+        double r = v / y.v;
+        for (unsigned i = 0; i < N; i++)
+            d[i] = (d[i] - r * y.d[i]) / y.v;
+        v = r;
+        return *this;
+    }
+};
+
+//! \return the dual number with value `f` and tangents `df*x.d`, where `df`
+//! is the derivative of the function at `x.v`
+template <unsigned N>
+inline DualDouble<N> chain_rule(const DualDouble<N> &x, double f, double df)
+{
+    DualDouble<N> r(f);
+    for (unsigned i = 0; i < N; i++)
+        r.d[i] = df * x.d[i];
+    return r;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator-(const DualDouble<N> &x)
+{
+    return chain_rule(x, -x.v, -1);
+}
+
+template <unsigned N>
+inline DualDouble<N> operator+(DualDouble<N> x, const DualDouble<N> &y)
+{
+    return x += y;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator-(DualDouble<N> x, const DualDouble<N> &y)
+{
+    return x -= y;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator*(DualDouble<N> x, const DualDouble<N> &y)
+{
+    return x *= y;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator/(DualDouble<N> x, const DualDouble<N> &y)
+{
+    return x /= y;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator+(double x, const DualDouble<N> &y)
+{
+    return DualDouble<N>(x) += y;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator-(double x, const DualDouble<N> &y)
+{
+    return DualDouble<N>(x) -= y;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator*(double x, const DualDouble<N> &y)
+{
+    return chain_rule(y, x * y.v, x);
+}
+
+template <unsigned N>
+inline DualDouble<N> operator/(double x, const DualDouble<N> &y)
+{
+    double r = x / y.v;
+    return chain_rule(y, r, -r / y.v);
+}
+
+template <unsigned N>
+inline DualDouble<N> operator+(DualDouble<N> x, double y)
+{
+    x.v += y;
+    return x;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator-(DualDouble<N> x, double y)
+{
+    x.v -= y;
+    return x;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator*(const DualDouble<N> &x, double y)
+{
+    return y * x;
+}
+
+template <unsigned N>
+inline DualDouble<N> operator/(const DualDouble<N> &x, double y)
+{
+    return chain_rule(x, x.v / y, 1 / y);
+}
+
+template <unsigned N>
+inline DualDouble<N> sqrt(const DualDouble<N> &x)
+{
+    double r = std::sqrt(x.v);
+    return chain_rule(x, r, 0.5 / r);
+}
+
+template <unsigned N>
+inline DualDouble<N> exp(const DualDouble<N> &x)
+{
+    double r = std::exp(x.v);
+    return chain_rule(x, r, r);
+}
+
+template <unsigned N>
+inline DualDouble<N> log(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::log(x.v), 1 / x.v);
+}
+
+template <unsigned N>
+inline DualDouble<N> pow(const DualDouble<N> &x, double y)
+{
+    return chain_rule(x, std::pow(x.v, y), y * std::pow(x.v, y - 1));
+}
+
+template <unsigned N>
+inline DualDouble<N> pow(const DualDouble<N> &x, const DualDouble<N> &y)
+{
+    double r = std::pow(x.v, y.v);
+    DualDouble<N> p = chain_rule(x, r, y.v * std::pow(x.v, y.v - 1));
+    // the derivative with respect to the exponent vanishes where y does
+    // not vary, even if log(x) is not defined
+    for (unsigned i = 0; i < N; i++)
+        if (y.d[i] != 0)
+            p.d[i] += r * std::log(x.v) * y.d[i];
+    return p;
+}
+
+template <unsigned N>
+inline DualDouble<N> abs(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::fabs(x.v), x.v > 0 ? 1 : (x.v < 0 ? -1 : 0));
+}
+
+template <unsigned N>
+inline DualDouble<N> sin(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::sin(x.v), std::cos(x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> cos(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::cos(x.v), -std::sin(x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> tan(const DualDouble<N> &x)
+{
+    double r = std::tan(x.v);
+    return chain_rule(x, r, 1 + r * r);
+}
+
+template <unsigned N>
+inline DualDouble<N> asin(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::asin(x.v), 1 / std::sqrt(1 - x.v * x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> acos(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::acos(x.v), -1 / std::sqrt(1 - x.v * x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> atan(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::atan(x.v), 1 / (1 + x.v * x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> atan2(const DualDouble<N> &y, const DualDouble<N> &x)
+{
+    double h = 1 / (x.v * x.v + y.v * y.v);
+    DualDouble<N> r(std::atan2(y.v, x.v));
+    for (unsigned i = 0; i < N; i++)
+        r.d[i] = h * (x.v * y.d[i] - y.v * x.d[i]);
+    return r;
+}
+
+template <unsigned N>
+inline DualDouble<N> sinh(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::sinh(x.v), std::cosh(x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> cosh(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::cosh(x.v), std::sinh(x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> tanh(const DualDouble<N> &x)
+{
+    double r = std::tanh(x.v);
+    return chain_rule(x, r, 1 - r * r);
+}
+
+template <unsigned N>
+inline DualDouble<N> asinh(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::asinh(x.v), 1 / std::sqrt(x.v * x.v + 1));
+}
+
+template <unsigned N>
+inline DualDouble<N> acosh(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::acosh(x.v), 1 / std::sqrt(x.v * x.v - 1));
+}
+
+template <unsigned N>
+inline DualDouble<N> atanh(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::atanh(x.v), 1 / (1 - x.v * x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> erf(const DualDouble<N> &x)
+{
+    // 2/sqrt(pi)*exp(-x**2)
+    return chain_rule(x, std::erf(x.v),
+                      1.1283791670955126 * std::exp(-x.v * x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> tgamma(const DualDouble<N> &x)
+{
+    double r = std::tgamma(x.v);
+    return chain_rule(x, r, r * polygamma(0.0, x.v));
+}
+
+template <unsigned N>
+inline DualDouble<N> lgamma(const DualDouble<N> &x)
+{
+    return chain_rule(x, std::lgamma(x.v), polygamma(0.0, x.v));
+}
+
+} // SymEngine
+
+#endif
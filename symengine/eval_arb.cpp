@@ -428,6 +428,38 @@ void eval_arb(arb_t result, const Basic &b, long precision)
     v.apply(result, b);
 }
 
+#ifdef HAVE_SYMENGINE_MPFR
+RCP<const Basic> evalf(const Basic &b, unsigned long digits,
+                       long max_precision)
+{
+    // log2(10) bits per decimal digit
+    const long target
+        = static_cast<long>(std::ceil(digits * 3.321928094887362)) + 1;
+    long prec = target + 16;
+    arb_t r;
+    arb_init(r);
+    while (true) {
+        try {
+            eval_arb(r, b, prec);
+        } catch (...) {
+            arb_clear(r);
+            throw;
+        }
+        if (arb_rel_accuracy_bits(r) >= target)
+            break;
+        if (prec >= max_precision) {
+            arb_clear(r);
+            throw std::runtime_error("evalf: requested accuracy not reached");
+        }
+        prec = std::min(2 * prec, max_precision);
+    }
+    mpfr_class m(target);
+    arf_get_mpfr(m.get_mpfr_t(), arb_midref(r), MPFR_RNDN);
+    arb_clear(r);
+    return real_mpfr(std::move(m));
+}
+#endif // HAVE_SYMENGINE_MPFR
+
 } // SymEngine
 
 #endif // HAVE_SYMENGINE_ARB
@@ -22,6 +22,16 @@ namespace SymEngine
 // also.
 void eval_arb(arb_t result, const Basic &b, long precision = 53);
 
+#ifdef HAVE_SYMENGINE_MPFR
+//! Evaluates `b` to a `RealMPFR` with at least `digits` correct decimal
+//! digits. `b` is evaluated with `eval_arb` at a few guard bits more than
+//! needed, and again at twice the precision only while the error bound is
+//! too large. Throws `std::runtime_error` if the required accuracy is not
+//! reached at `max_precision` bits, e.g. if `b` is zero but not exactly.
+RCP<const Basic> evalf(const Basic &b, unsigned long digits,
+                       long max_precision = 65536);
+#endif // HAVE_SYMENGINE_MPFR
+
 } // SymEngine
 
 #endif // HAVE_SYMENGINE_ARB
@@ -2,6 +2,8 @@
 #include <functional>
 #include <complex>
 #include <algorithm>
+#include <cstring>
+#include <exception>
 
 #include <symengine/basic.h>
 #include <symengine/symbol.h>
@@ -15,10 +17,109 @@
 #include <symengine/constants.h>
 #include <symengine/visitor.h>
 #include <symengine/eval_double.h>
+#include <symengine/special_double.h>
+#include <symengine/exact_sum.h>
 
 namespace SymEngine
 {
 
+//! The math functions of doubles, complex doubles and dual numbers, so that
+//! EvalDoubleVisitor can be used with any of these types
+namespace eval_math
+{
+#define SYMENGINE_EVAL_MATH(f)                                                 \
+    using std::f;                                                              \
+    using SymEngine::f;
+SYMENGINE_EVAL_MATH(sin)
+SYMENGINE_EVAL_MATH(cos)
+SYMENGINE_EVAL_MATH(tan)
+SYMENGINE_EVAL_MATH(asin)
+SYMENGINE_EVAL_MATH(acos)
+SYMENGINE_EVAL_MATH(atan)
+SYMENGINE_EVAL_MATH(sinh)
+SYMENGINE_EVAL_MATH(cosh)
+SYMENGINE_EVAL_MATH(tanh)
+SYMENGINE_EVAL_MATH(asinh)
+SYMENGINE_EVAL_MATH(acosh)
+SYMENGINE_EVAL_MATH(atanh)
+SYMENGINE_EVAL_MATH(exp)
+SYMENGINE_EVAL_MATH(log)
+SYMENGINE_EVAL_MATH(pow)
+SYMENGINE_EVAL_MATH(abs)
+#undef SYMENGINE_EVAL_MATH
+}
+
+//! Sums and products with at least this many arguments are evaluated in
+//! parallel by the reproducible evaluation
+static const std::size_t parallel_min_args = 1024;
+
+//! \return the exact sum of `v` rounded once
+static double exact_sum(const std::vector<double> &v)
+{
+    ExactSum s;
+    for (double x : v)
+        s.add(x);
+    return s.round();
+}
+
+static std::complex<double>
+exact_sum(const std::vector<std::complex<double>> &v)
+{
+    ExactSum re, im;
+    for (const auto &z : v) {
+        re.add(z.real());
+        im.add(z.imag());
+    }
+    return std::complex<double>(re.round(), im.round());
+}
+
+template <unsigned N>
+static DualDouble<N> exact_sum(const std::vector<DualDouble<N>> &v)
+{
+    ExactSum s[N + 1];
+    for (const auto &x : v) {
+        s[N].add(x.v);
+        for (unsigned i = 0; i < N; i++)
+            s[i].add(x.d[i]);
+    }
+    DualDouble<N> r(s[N].round());
+    for (unsigned i = 0; i < N; i++)
+        r.d[i] = s[i].round();
+    return r;
+}
+
+//! Total order on the bit patterns, in which the factors of products are
+//! multiplied
+static bool bits_less(double x, double y)
+{
+    uint64_t a, b;
+    std::memcpy(&a, &x, sizeof(a));
+    std::memcpy(&b, &y, sizeof(b));
+    return a < b;
+}
+
+static bool bits_less(const std::complex<double> &x,
+                      const std::complex<double> &y)
+{
+    if (bits_less(x.real(), y.real()))
+        return true;
+    if (bits_less(y.real(), x.real()))
+        return false;
+    return bits_less(x.imag(), y.imag());
+}
+
+template <unsigned N>
+static bool bits_less(const DualDouble<N> &x, const DualDouble<N> &y)
+{
+    if (bits_less(x.v, y.v) or bits_less(y.v, x.v))
+        return bits_less(x.v, y.v);
+    for (unsigned i = 0; i < N; i++) {
+        if (bits_less(x.d[i], y.d[i]) or bits_less(y.d[i], x.d[i]))
+            return bits_less(x.d[i], y.d[i]);
+    }
+    return false;
+}
+
 template <typename T, typename C>
 class EvalDoubleVisitor : public BaseVisitor<C>
 {
@@ -32,7 +133,41 @@ protected:
     */
     T result_;
 
+    //! Evaluates `f(v, i)` for `i < n`, where `v` is a copy of this visitor
+    //! owned by the thread, in parallel if `n` is large
+    template <typename F>
+    void for_each_arg(std::size_t n, const F &f)
+    {
+        int m = n, failed = m;
+        std::exception_ptr error;
+#pragma omp parallel if (n >= parallel_min_args)
+        {
+            C v(*static_cast<C *>(this));
+#pragma omp for schedule(dynamic, 64)
+            for (int i = 0; i < m; i++) {
+                // Exceptions must not leave the parallel region, the one of
+                // the first failing argument is rethrown afterwards
+                try {
+                    f(v, i);
+                } catch (...) {
+#pragma omp critical
+                    if (i < failed) {
+                        failed = i;
+                        error = std::current_exception();
+                    }
+                }
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
 public:
+    //! If true, sums are computed exactly and rounded once and the factors
+    //! of products are multiplied in a fixed order, so that the result does
+    //! not depend on the order of the hash tables nor on the threads
+    bool reproducible_ = false;
+
     T apply(const Basic &b)
     {
         b.accept(*static_cast<C *>(this));
@@ -65,47 +200,78 @@ public:
 #endif
     void bvisit(const Add &x)
     {
+        if (reproducible_) {
+            std::vector<umap_basic_num::const_iterator> args;
+            for (auto it = x.dict_.begin(); it != x.dict_.end(); ++it)
+                args.push_back(it);
+            std::vector<T> terms(args.size() + 1);
+            terms.back() = apply(*x.coef_);
+            for_each_arg(args.size(), [&](C &v, std::size_t i) {
+                terms[i] = v.apply(*args[i]->second) * v.apply(*args[i]->first);
+            });
+            result_ = exact_sum(terms);
+            return;
+        }
         T tmp = 0;
         for (const auto &p : x.get_args())
             tmp += apply(*p);
         result_ = tmp;
     }
 
+    //! \return the value of `base**exp`
+    T power(const Basic &base, const Basic &exp)
+    {
+        if (eq(base, *E))
+            return eval_math::exp(apply(exp));
+        DoublePower p;
+        if (p.init(exp))
+            return p(apply(base));
+        return eval_math::pow(apply(base), apply(exp));
+    }
+
     void bvisit(const Mul &x)
     {
-        T tmp = 1;
-        for (const auto &p : x.get_args())
-            tmp *= apply(*p);
+        T tmp = apply(*x.coef_);
+        if (reproducible_) {
+            std::vector<map_basic_basic::const_iterator> args;
+            for (auto it = x.dict_.begin(); it != x.dict_.end(); ++it)
+                args.push_back(it);
+            std::vector<T> factors(args.size());
+            for_each_arg(args.size(), [&](C &v, std::size_t i) {
+                factors[i] = v.power(*args[i]->first, *args[i]->second);
+            });
+            std::sort(factors.begin(), factors.end(),
+                      [](const T &a, const T &b) { return bits_less(a, b); });
+            for (const T &f : factors)
+                tmp *= f;
+        } else {
+            for (const auto &p : x.dict_)
+                tmp *= power(*p.first, *p.second);
+        }
         result_ = tmp;
     }
 
     void bvisit(const Pow &x)
     {
-        T exp_ = apply(*(x.get_exp()));
-        if (eq(*(x.get_base()), *E)) {
-            result_ = std::exp(exp_);
-        } else {
-            T base_ = apply(*(x.get_base()));
-            result_ = std::pow(base_, exp_);
-        }
+        result_ = power(*x.get_base(), *x.get_exp());
     }
 
     void bvisit(const Sin &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::sin(tmp);
+        result_ = eval_math::sin(tmp);
     }
 
     void bvisit(const Cos &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::cos(tmp);
+        result_ = eval_math::cos(tmp);
     }
 
     void bvisit(const Tan &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::tan(tmp);
+        result_ = eval_math::tan(tmp);
     }
 
     void bvisit(const Symbol &)
@@ -116,133 +282,180 @@ public:
     void bvisit(const Log &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::log(tmp);
+        result_ = eval_math::log(tmp);
     };
 
     void bvisit(const Cot &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = 1.0 / std::tan(tmp);
+        result_ = 1.0 / eval_math::tan(tmp);
     };
 
     void bvisit(const Csc &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = 1.0 / std::sin(tmp);
+        result_ = 1.0 / eval_math::sin(tmp);
     };
 
     void bvisit(const Sec &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = 1.0 / std::cos(tmp);
+        result_ = 1.0 / eval_math::cos(tmp);
     };
 
     void bvisit(const ASin &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::asin(tmp);
+        result_ = eval_math::asin(tmp);
     };
 
     void bvisit(const ACos &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::acos(tmp);
+        result_ = eval_math::acos(tmp);
     };
 
     void bvisit(const ASec &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::acos(1.0 / tmp);
+        result_ = eval_math::acos(1.0 / tmp);
     };
 
     void bvisit(const ACsc &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::asin(1.0 / tmp);
+        result_ = eval_math::asin(1.0 / tmp);
     };
 
     void bvisit(const ATan &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::atan(tmp);
+        result_ = eval_math::atan(tmp);
     };
 
     void bvisit(const ACot &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::atan(1.0 / tmp);
+        result_ = eval_math::atan(1.0 / tmp);
     };
 
     void bvisit(const Sinh &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::sinh(tmp);
+        result_ = eval_math::sinh(tmp);
     };
 
     void bvisit(const Csch &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = 1.0 / std::sinh(tmp);
+        result_ = 1.0 / eval_math::sinh(tmp);
     };
 
     void bvisit(const Cosh &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::cosh(tmp);
+        result_ = eval_math::cosh(tmp);
     };
 
     void bvisit(const Sech &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = 1.0 / std::cosh(tmp);
+        result_ = 1.0 / eval_math::cosh(tmp);
     };
 
     void bvisit(const Tanh &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::tanh(tmp);
+        result_ = eval_math::tanh(tmp);
     };
 
     void bvisit(const Coth &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = 1.0 / std::tanh(tmp);
+        result_ = 1.0 / eval_math::tanh(tmp);
     };
 
     void bvisit(const ASinh &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::asinh(tmp);
+        result_ = eval_math::asinh(tmp);
     };
 
     void bvisit(const ACsch &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::asinh(1.0 / tmp);
+        result_ = eval_math::asinh(1.0 / tmp);
     };
 
     void bvisit(const ACosh &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::acosh(tmp);
+        result_ = eval_math::acosh(tmp);
     };
 
     void bvisit(const ATanh &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::atanh(tmp);
+        result_ = eval_math::atanh(tmp);
     };
 
     void bvisit(const ACoth &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::atanh(1.0 / tmp);
+        result_ = eval_math::atanh(1.0 / tmp);
     };
 
     void bvisit(const ASech &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::acosh(1.0 / tmp);
+        result_ = eval_math::acosh(1.0 / tmp);
+    };
+
+    void bvisit(const Zeta &x)
+    {
+        T s = apply(*(x.get_s()));
+        T a = apply(*(x.get_a()));
+        result_ = zeta(s, a);
+    };
+
+    void bvisit(const Dirichlet_eta &x)
+    {
+        T tmp = apply(*(x.get_s()));
+        result_ = dirichlet_eta(tmp);
+    };
+
+    void bvisit(const LambertW &x)
+    {
+        T tmp = apply(*(x.get_arg()));
+        result_ = lambertw(tmp);
+    };
+
+    void bvisit(const PolyGamma &x)
+    {
+        T n = apply(*(x.get_arg1()));
+        T tmp = apply(*(x.get_arg2()));
+        result_ = polygamma(n, tmp);
+    };
+
+    void bvisit(const LowerGamma &x)
+    {
+        T s = apply(*(x.get_arg1()));
+        T tmp = apply(*(x.get_arg2()));
+        result_ = lowergamma(s, tmp);
+    };
+
+    void bvisit(const UpperGamma &x)
+    {
+        T s = apply(*(x.get_arg1()));
+        T tmp = apply(*(x.get_arg2()));
+        result_ = uppergamma(s, tmp);
+    };
+
+    void bvisit(const Beta &x)
+    {
+        T a = apply(*(x.get_arg1()));
+        T b = apply(*(x.get_arg2()));
+        result_ = beta(a, b);
     };
 
     void bvisit(const Constant &x)
@@ -263,7 +476,7 @@ public:
     void bvisit(const Abs &x)
     {
         T tmp = apply(*(x.get_arg()));
-        result_ = std::abs(tmp);
+        result_ = eval_math::abs(tmp);
     };
 
     void bvisit(const Basic &)
@@ -287,8 +500,7 @@ class EvalRealDoubleVisitor : public EvalDoubleVisitor<double, C>
 {
 public:
     // Classes not implemented are
-    // Subs, UpperGamma, LowerGamma, Dirichlet_eta, Zeta
-    // LeviCivita, KroneckerDelta, LambertW
+    // Subs, LeviCivita, KroneckerDelta
     // Derivative, Complex, ComplexDouble, ComplexMPC
 
     using EvalDoubleVisitor<double, C>::bvisit;
@@ -364,8 +576,7 @@ class EvalComplexDoubleVisitor
 {
 public:
     // Classes not implemented are
-    // Subs, UpperGamma, LowerGamma, Dirichlet_eta, Zeta
-    // LeviCivita, KroneckerDelta, LambertW
+    // Subs, LeviCivita, KroneckerDelta
     // Derivative, ATan2, Gamma
 
     using EvalDoubleVisitor::bvisit;
@@ -394,6 +605,439 @@ public:
 #endif
 };
 
+template <unsigned N>
+class EvalDualDoubleVisitor
+    : public EvalDoubleVisitor<DualDouble<N>, EvalDualDoubleVisitor<N>>
+{
+    typedef DualDouble<N> T;
+    typedef EvalDoubleVisitor<T, EvalDualDoubleVisitor<N>> Base;
+
+    const umap_basic_uint &symbols_;
+    const std::vector<T> &values_;
+
+public:
+    // Classes not implemented are
+    // Subs, LeviCivita, KroneckerDelta
+    // Derivative, Complex, ComplexDouble, ComplexMPC, Zeta, Dirichlet_eta,
+    // LambertW, PolyGamma, LowerGamma, UpperGamma, Beta
+
+    using Base::bvisit;
+    using Base::apply;
+    using Base::result_;
+
+    EvalDualDoubleVisitor(const umap_basic_uint &symbols,
+                          const std::vector<T> &values)
+        : symbols_(symbols), values_(values)
+    {
+    }
+
+    void bvisit(const Symbol &x)
+    {
+        auto it = symbols_.find(x.rcp_from_this());
+        if (it == symbols_.end())
+            throw std::runtime_error("Symbol " + x.get_name()
+                                     + " is not one of the symbols.");
+        result_ = values_[it->second];
+    }
+
+    void bvisit(const ATan2 &x)
+    {
+        T num = apply(*(x.get_num()));
+        T den = apply(*(x.get_den()));
+        result_ = atan2(num, den);
+    }
+
+    void bvisit(const Gamma &x)
+    {
+        result_ = tgamma(apply(*(x.get_args()[0])));
+    }
+
+    void bvisit(const LogGamma &x)
+    {
+        result_ = lgamma(apply(*(x.get_args()[0])));
+    }
+
+    void bvisit(const Erf &x)
+    {
+        result_ = erf(apply(*(x.get_args()[0])));
+    }
+
+    void bvisit(const Max &x)
+    {
+        auto d = x.get_args();
+        T result = apply(*d[0]);
+        for (size_t i = 1; i < d.size(); i++) {
+            T tmp = apply(*d[i]);
+            if (tmp.v > result.v)
+                result = tmp;
+        }
+        result_ = result;
+    }
+
+    void bvisit(const Min &x)
+    {
+        auto d = x.get_args();
+        T result = apply(*d[0]);
+        for (size_t i = 1; i < d.size(); i++) {
+            T tmp = apply(*d[i]);
+            if (tmp.v < result.v)
+                result = tmp;
+        }
+        result_ = result;
+    }
+
+#define SYMENGINE_DUAL_NOT_IMPLEMENTED(Class)                                  \
+    void bvisit(const Class &x)                                                \
+    {                                                                          \
+        throw std::runtime_error("Not implemented.");                          \
+    }
+
+    SYMENGINE_DUAL_NOT_IMPLEMENTED(Zeta)
+    SYMENGINE_DUAL_NOT_IMPLEMENTED(Dirichlet_eta)
+    SYMENGINE_DUAL_NOT_IMPLEMENTED(LambertW)
+    SYMENGINE_DUAL_NOT_IMPLEMENTED(PolyGamma)
+    SYMENGINE_DUAL_NOT_IMPLEMENTED(LowerGamma)
+    SYMENGINE_DUAL_NOT_IMPLEMENTED(UpperGamma)
+    SYMENGINE_DUAL_NOT_IMPLEMENTED(Beta)
+
+#undef SYMENGINE_DUAL_NOT_IMPLEMENTED
+};
+
+//! \return an interval containing the integer `i`
+static IntervalDouble interval_of(const integer_class &i)
+{
+    if (mp_fits_slong_p(i)) {
+        long n = mp_get_si(i);
+        // exactly representable
+        if (n <= (1L << 53) && n >= -(1L << 53))
+            return IntervalDouble(static_cast<double>(n));
+    }
+    return widen(IntervalDouble(mp_get_d(i)));
+}
+
+class EvalIntervalDoubleVisitor : public BaseVisitor<EvalIntervalDoubleVisitor>
+{
+protected:
+    const vec_basic &symbols_;
+    const std::vector<IntervalDouble> &box_;
+    IntervalDouble result_;
+
+    //! \return the value of `base**exp`
+    IntervalDouble power(const Basic &base, const Basic &exp_)
+    {
+        if (eq(base, *E))
+            return exp(apply(exp_));
+        if (is_a<Integer>(exp_)) {
+            const integer_class &n = static_cast<const Integer &>(exp_).i;
+            if (mp_fits_slong_p(n))
+                return pow(apply(base), mp_get_si(n));
+        } else if (is_a<Rational>(exp_)) {
+            const rational_class &q = static_cast<const Rational &>(exp_).i;
+            if (get_num(q) == 1 && get_den(q) == 2)
+                return sqrt(apply(base));
+        }
+        return pow(apply(base), apply(exp_));
+    }
+
+public:
+    EvalIntervalDoubleVisitor(const vec_basic &symbols,
+                              const std::vector<IntervalDouble> &box)
+        : symbols_(symbols), box_(box)
+    {
+        if (symbols.size() != box.size())
+            throw std::runtime_error("The number of intervals is different "
+                                     "from the number of symbols.");
+    }
+
+    IntervalDouble apply(const Basic &b)
+    {
+        b.accept(*this);
+        return result_;
+    }
+
+    void bvisit(const Symbol &x)
+    {
+        for (unsigned i = 0; i < symbols_.size(); ++i) {
+            if (eq(x, *symbols_[i])) {
+                result_ = box_[i];
+                return;
+            }
+        }
+        throw std::runtime_error("Symbol not in the symbols vector.");
+    }
+
+    void bvisit(const Integer &x)
+    {
+        result_ = interval_of(x.i);
+    }
+
+    void bvisit(const Rational &x)
+    {
+        result_ = widen(IntervalDouble(mp_get_d(x.i)));
+    }
+
+    void bvisit(const RealDouble &x)
+    {
+        result_ = IntervalDouble(x.i);
+    }
+#ifdef HAVE_SYMENGINE_MPFR
+    void bvisit(const RealMPFR &x)
+    {
+        result_ = IntervalDouble(mpfr_get_d(x.i.get_mpfr_t(), MPFR_RNDD),
+                                 mpfr_get_d(x.i.get_mpfr_t(), MPFR_RNDU));
+    }
+#endif
+    void bvisit(const Constant &x)
+    {
+        if (eq(x, *pi)) {
+            result_ = widen(IntervalDouble(3.141592653589793));
+        } else if (eq(x, *E)) {
+            result_ = widen(IntervalDouble(2.718281828459045));
+        } else if (eq(x, *EulerGamma)) {
+            result_ = widen(IntervalDouble(0.5772156649015329));
+        } else {
+            throw std::runtime_error("Constant " + x.get_name()
+                                     + " is not implemented.");
+        }
+    }
+
+    void bvisit(const Add &x)
+    {
+        IntervalDouble tmp = apply(*x.coef_);
+        for (const auto &p : x.dict_)
+            tmp = tmp + apply(*p.second) * apply(*p.first);
+        result_ = tmp;
+    }
+
+    void bvisit(const Mul &x)
+    {
+        IntervalDouble tmp = apply(*x.coef_);
+        for (const auto &p : x.dict_)
+            tmp = tmp * power(*p.first, *p.second);
+        result_ = tmp;
+    }
+
+    void bvisit(const Pow &x)
+    {
+        result_ = power(*x.get_base(), *x.get_exp());
+    }
+
+    void bvisit(const Sin &x)
+    {
+        result_ = sin(apply(*x.get_arg()));
+    }
+
+    void bvisit(const Cos &x)
+    {
+        result_ = cos(apply(*x.get_arg()));
+    }
+
+    void bvisit(const Tan &x)
+    {
+        result_ = tan(apply(*x.get_arg()));
+    }
+
+    void bvisit(const Cot &x)
+    {
+        result_ = inv(tan(apply(*x.get_arg())));
+    }
+
+    void bvisit(const Csc &x)
+    {
+        result_ = inv(sin(apply(*x.get_arg())));
+    }
+
+    void bvisit(const Sec &x)
+    {
+        result_ = inv(cos(apply(*x.get_arg())));
+    }
+
+    void bvisit(const ASin &x)
+    {
+        result_ = asin(apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACos &x)
+    {
+        result_ = acos(apply(*x.get_arg()));
+    }
+
+    void bvisit(const ATan &x)
+    {
+        result_ = atan(apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACot &x)
+    {
+        result_ = atan(inv(apply(*x.get_arg())));
+    }
+
+    void bvisit(const ASec &x)
+    {
+        result_ = acos(inv(apply(*x.get_arg())));
+    }
+
+    void bvisit(const ACsc &x)
+    {
+        result_ = asin(inv(apply(*x.get_arg())));
+    }
+
+    void bvisit(const Sinh &x)
+    {
+        result_ = sinh(apply(*x.get_arg()));
+    }
+
+    void bvisit(const Cosh &x)
+    {
+        result_ = cosh(apply(*x.get_arg()));
+    }
+
+    void bvisit(const Tanh &x)
+    {
+        result_ = tanh(apply(*x.get_arg()));
+    }
+
+    void bvisit(const Coth &x)
+    {
+        result_ = inv(tanh(apply(*x.get_arg())));
+    }
+
+    void bvisit(const Csch &x)
+    {
+        result_ = inv(sinh(apply(*x.get_arg())));
+    }
+
+    void bvisit(const Sech &x)
+    {
+        result_ = inv(cosh(apply(*x.get_arg())));
+    }
+
+    void bvisit(const ASinh &x)
+    {
+        result_ = asinh(apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACosh &x)
+    {
+        result_ = acosh(apply(*x.get_arg()));
+    }
+
+    void bvisit(const ATanh &x)
+    {
+        result_ = atanh(apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACoth &x)
+    {
+        result_ = atanh(inv(apply(*x.get_arg())));
+    }
+
+    void bvisit(const ACsch &x)
+    {
+        result_ = asinh(inv(apply(*x.get_arg())));
+    }
+
+    void bvisit(const ASech &x)
+    {
+        result_ = acosh(inv(apply(*x.get_arg())));
+    }
+
+    void bvisit(const Log &x)
+    {
+        result_ = log(apply(*x.get_arg()));
+    }
+
+    void bvisit(const Abs &x)
+    {
+        result_ = abs(apply(*x.get_arg()));
+    }
+
+    void bvisit(const ATan2 &x)
+    {
+        result_ = atan2(apply(*x.get_num()), apply(*x.get_den()));
+    }
+
+    void bvisit(const Gamma &x)
+    {
+        result_ = tgamma(apply(*x.get_args()[0]));
+    }
+
+    void bvisit(const LogGamma &x)
+    {
+        result_ = lgamma(apply(*x.get_args()[0]));
+    }
+
+    void bvisit(const Erf &x)
+    {
+        result_ = erf(apply(*x.get_args()[0]));
+    }
+
+    void bvisit(const Max &x)
+    {
+        vec_basic d = x.get_args();
+        IntervalDouble tmp = apply(*d[0]);
+        for (size_t i = 1; i < d.size(); i++)
+            tmp = max(tmp, apply(*d[i]));
+        result_ = tmp;
+    }
+
+    void bvisit(const Min &x)
+    {
+        vec_basic d = x.get_args();
+        IntervalDouble tmp = apply(*d[0]);
+        for (size_t i = 1; i < d.size(); i++)
+            tmp = min(tmp, apply(*d[i]));
+        result_ = tmp;
+    }
+
+    void bvisit(const Basic &)
+    {
+        throw std::runtime_error("Not implemented.");
+    }
+};
+
+bool DoublePower::init(const Basic &e)
+{
+    inverse_ = false;
+    if (is_a<Integer>(e)) {
+        const integer_class &i = static_cast<const Integer &>(e).i;
+        if (not mp_fits_slong_p(i))
+            return false;
+        long n = mp_get_si(i);
+        if (n == 0 or n > long(max_chain) or n < -long(max_chain))
+            return false;
+        kind_ = CHAIN;
+        n_ = n < 0 ? -n : n;
+        inverse_ = n < 0;
+        return true;
+    }
+    if (is_a<Rational>(e)) {
+        const rational_class &q = static_cast<const Rational &>(e).i;
+        if (get_num(q) != 1 and get_num(q) != -1)
+            return false;
+        if (get_den(q) == 2)
+            kind_ = SQRT;
+        else if (get_den(q) == 3)
+            kind_ = CBRT;
+        else
+            return false;
+        inverse_ = get_num(q) == -1;
+        return true;
+    }
+    return false;
+}
+
+static double power_single_dispatch(const Basic &base, const Basic &exp)
+{
+    if (eq(base, *E))
+        return ::exp(eval_double_single_dispatch(exp));
+    DoublePower p;
+    if (p.init(exp))
+        return p(eval_double_single_dispatch(base));
+    return ::pow(eval_double_single_dispatch(base),
+                 eval_double_single_dispatch(exp));
+}
+
 /*
  * These two seem to be equivalent and about the same fast.
 */
@@ -432,17 +1076,15 @@ std::vector<fn> init_eval_double()
         return tmp;
     };
     table[MUL] = [](const Basic &x) {
-        double tmp = 1;
-        for (const auto &p : x.get_args())
-            tmp *= eval_double_single_dispatch(*p);
+        const Mul &m = static_cast<const Mul &>(x);
+        double tmp = eval_double_single_dispatch(*m.coef_);
+        for (const auto &p : m.dict_)
+            tmp *= power_single_dispatch(*p.first, *p.second);
         return tmp;
     };
     table[POW] = [](const Basic &x) {
-        double a = eval_double_single_dispatch(
-            *(static_cast<const Pow &>(x)).get_base());
-        double b = eval_double_single_dispatch(
-            *(static_cast<const Pow &>(x)).get_exp());
-        return ::pow(a, b);
+        return power_single_dispatch(*(static_cast<const Pow &>(x)).get_base(),
+                                     *(static_cast<const Pow &>(x)).get_exp());
     };
     table[SIN] = [](const Basic &x) {
         double tmp = eval_double_single_dispatch(
@@ -591,6 +1233,51 @@ std::vector<fn> init_eval_double()
             *(static_cast<const Erf &>(x)).get_args()[0]);
         return ::erf(tmp);
     };
+    table[ZETA] = [](const Basic &x) {
+        double s = eval_double_single_dispatch(
+            *(static_cast<const Zeta &>(x)).get_s());
+        double a = eval_double_single_dispatch(
+            *(static_cast<const Zeta &>(x)).get_a());
+        return zeta(s, a);
+    };
+    table[DIRICHLET_ETA] = [](const Basic &x) {
+        double tmp = eval_double_single_dispatch(
+            *(static_cast<const Dirichlet_eta &>(x)).get_s());
+        return dirichlet_eta(tmp);
+    };
+    table[LAMBERTW] = [](const Basic &x) {
+        double tmp = eval_double_single_dispatch(
+            *(static_cast<const LambertW &>(x)).get_arg());
+        return lambertw(tmp);
+    };
+    table[POLYGAMMA] = [](const Basic &x) {
+        double n = eval_double_single_dispatch(
+            *(static_cast<const PolyGamma &>(x)).get_arg1());
+        double tmp = eval_double_single_dispatch(
+            *(static_cast<const PolyGamma &>(x)).get_arg2());
+        return polygamma(n, tmp);
+    };
+    table[LOWERGAMMA] = [](const Basic &x) {
+        double s = eval_double_single_dispatch(
+            *(static_cast<const LowerGamma &>(x)).get_arg1());
+        double tmp = eval_double_single_dispatch(
+            *(static_cast<const LowerGamma &>(x)).get_arg2());
+        return lowergamma(s, tmp);
+    };
+    table[UPPERGAMMA] = [](const Basic &x) {
+        double s = eval_double_single_dispatch(
+            *(static_cast<const UpperGamma &>(x)).get_arg1());
+        double tmp = eval_double_single_dispatch(
+            *(static_cast<const UpperGamma &>(x)).get_arg2());
+        return uppergamma(s, tmp);
+    };
+    table[BETA] = [](const Basic &x) {
+        double a = eval_double_single_dispatch(
+            *(static_cast<const Beta &>(x)).get_arg1());
+        double b = eval_double_single_dispatch(
+            *(static_cast<const Beta &>(x)).get_arg2());
+        return beta(a, b);
+    };
     table[CONSTANT] = [](const Basic &x) {
         if (eq(x, *pi)) {
             return ::atan2(0, -1);
@@ -647,6 +1334,55 @@ std::complex<double> eval_complex_double(const Basic &b)
     return v.apply(b);
 }
 
+double eval_double_reproducible(const Basic &b)
+{
+    EvalRealDoubleVisitorFinal v;
+    v.reproducible_ = true;
+    return v.apply(b);
+}
+
+std::complex<double> eval_complex_double_reproducible(const Basic &b)
+{
+    EvalComplexDoubleVisitor v;
+    v.reproducible_ = true;
+    return v.apply(b);
+}
+
+template <unsigned N>
+DualDouble<N> eval_dual_double(const Basic &b, const vec_basic &x,
+                               const std::vector<DualDouble<N>> &v)
+{
+    if (x.size() != v.size())
+        throw std::runtime_error("The number of values is different from "
+                                 "the number of symbols.");
+    umap_basic_uint symbols;
+    for (size_t i = 0; i < x.size(); i++)
+        symbols[x[i]] = i;
+    EvalDualDoubleVisitor<N> visitor(symbols, v);
+    return visitor.apply(b);
+}
+
+template DualDouble<1> eval_dual_double(const Basic &, const vec_basic &,
+                                        const std::vector<DualDouble<1>> &);
+template DualDouble<2> eval_dual_double(const Basic &, const vec_basic &,
+                                        const std::vector<DualDouble<2>> &);
+template DualDouble<4> eval_dual_double(const Basic &, const vec_basic &,
+                                        const std::vector<DualDouble<4>> &);
+template DualDouble<8> eval_dual_double(const Basic &, const vec_basic &,
+                                        const std::vector<DualDouble<8>> &);
+
+IntervalDouble eval_interval_double(const Basic &b, const vec_basic &x,
+                                    const std::vector<IntervalDouble> &box)
+{
+    EvalIntervalDoubleVisitor v(x, box);
+    return v.apply(b);
+}
+
+IntervalDouble eval_interval_double(const Basic &b)
+{
+    return eval_interval_double(b, {}, {});
+}
+
 double eval_double_single_dispatch(const Basic &b)
 {
     return table_eval_double[b.get_type_code()](b);
@@ -5,7 +5,11 @@
 #ifndef SYMENGINE_EVAL_DOUBLE_H
 #define SYMENGINE_EVAL_DOUBLE_H
 
+#include <cmath>
+#include <limits>
 #include <symengine/basic.h>
+#include <symengine/interval_double.h>
+#include <symengine/dual_double.h>
 
 namespace SymEngine
 {
@@ -23,6 +27,110 @@ double eval_double_visitor_pattern(const Basic &b);
 
 std::complex<double> eval_complex_double(const Basic &b);
 
+//! Like `eval_double` and `eval_complex_double`, but the result does not
+//! depend on the iteration order of the terms of `Add` and `Mul`, nor on the
+//! number of threads: sums are computed exactly and rounded once, and the
+//! factors of products are multiplied in a fixed order. Wide sums and
+//! products are evaluated in parallel when OpenMP is enabled.
+double eval_double_reproducible(const Basic &b);
+std::complex<double> eval_complex_double_reproducible(const Basic &b);
+
+//! Evaluates `b` with dual numbers, where the `i`-th of the symbols `x`
+//! takes the value `v[i]`. The tangents of the result are the derivatives of
+//! `b` along the tangents of `v`. Defined for `N` = 1, 2, 4 and 8.
+template <unsigned N>
+DualDouble<N> eval_dual_double(const Basic &b, const vec_basic &x,
+                               const std::vector<DualDouble<N>> &v);
+
+//! Evaluates `b` in interval arithmetic over the box where the `i`-th of the
+//! symbols `x` takes the values of `box[i]`. The result contains the value of
+//! `b` at every point of the box.
+IntervalDouble eval_interval_double(const Basic &b, const vec_basic &x,
+                                    const std::vector<IntervalDouble> &box);
+//! \return an interval containing the value of the number `b`
+IntervalDouble eval_interval_double(const Basic &b);
+
+//! Evaluation of `x**e` in double precision for an exponent `e` that is
+//! known in advance. Integer exponents up to `max_chain` are computed with
+//! the fewest multiplications, `1/2` and `1/3` with `sqrt` and `cbrt`, and
+//! their negatives with a division. Other exponents need `std::pow`.
+class DoublePower
+{
+public:
+    static const unsigned max_chain = 16;
+
+    //! \return false if `e` is not one of the exponents above
+    bool init(const Basic &e);
+
+    double operator()(double x) const
+    {
+        double r;
+        if (kind_ == CHAIN)
+            r = chain(x, n_);
+        else if (kind_ == SQRT)
+            r = std::sqrt(x);
+        else // like std::pow, NaN for x < 0
+            r = x < 0 ? std::numeric_limits<double>::quiet_NaN()
+                      : std::cbrt(x);
+        return inverse_ ? 1.0 / r : r;
+    }
+
+    std::complex<double> operator()(const std::complex<double> &x) const
+    {
+        std::complex<double> r;
+        if (kind_ == CHAIN)
+            r = chain(x, n_);
+        else if (kind_ == SQRT)
+            r = std::sqrt(x);
+        else
+            r = std::pow(x, 1.0 / 3);
+        return inverse_ ? 1.0 / r : r;
+    }
+
+    //! For other types, such as dual numbers
+    template <typename T>
+    T operator()(const T &x) const
+    {
+        T r;
+        if (kind_ == CHAIN)
+            r = chain(x, n_);
+        else if (kind_ == SQRT)
+            r = sqrt(x);
+        else
+            r = pow(x, 1.0 / 3);
+        return inverse_ ? 1.0 / r : r;
+    }
+
+    //! \return `x**n` for `1 <= n <= max_chain`. Binary powering uses the
+    //! fewest multiplications except for `n = 15`.
+    template <typename T>
+    static T chain(const T &x, unsigned n)
+    {
+        if (n == 15) {
+            T x3 = x * x * x;
+            T x6 = x3 * x3;
+            return x6 * x6 * x3;
+        }
+        T p = x;
+        while (not(n & 1)) {
+            p = p * p;
+            n >>= 1;
+        }
+        T r = p;
+        while (n >>= 1) {
+            p = p * p;
+            if (n & 1)
+                r = r * p;
+        }
+        return r;
+    }
+
+private:
+    enum { CHAIN, SQRT, CBRT } kind_;
+    unsigned n_;
+    bool inverse_;
+};
+
 } // SymEngine
 
 #endif
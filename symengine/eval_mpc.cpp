@@ -10,6 +10,7 @@
 #include <symengine/constants.h>
 #include <symengine/visitor.h>
 #include <symengine/eval_mpc.h>
+#include <symengine/eval_mpfr.h>
 
 #ifdef HAVE_SYMENGINE_MPC
 
@@ -283,29 +284,11 @@ public:
 
     void bvisit(const Constant &x)
     {
-        if (x.__eq__(*pi)) {
-            mpfr_t t;
-            mpfr_init2(t, mpc_get_prec(result_));
-            mpfr_const_pi(t, rnd_);
-            mpc_set_fr(result_, t, rnd_);
-            mpfr_clear(t);
-        } else if (x.__eq__(*E)) {
-            mpfr_t t;
-            mpfr_init2(t, mpc_get_prec(result_));
-            mpfr_set_ui(t, 1, rnd_);
-            mpfr_exp(t, t, rnd_);
-            mpc_set_fr(result_, t, rnd_);
-            mpfr_clear(t);
-        } else if (x.__eq__(*EulerGamma)) {
-            mpfr_t t;
-            mpfr_init2(t, mpc_get_prec(result_));
-            mpfr_const_euler(t, rnd_);
-            mpc_set_fr(result_, t, rnd_);
-            mpfr_clear(t);
-        } else {
-            throw std::runtime_error("Constant " + x.get_name()
-                                     + " is not implemented.");
-        }
+        mpfr_t t;
+        mpfr_init2(t, mpc_get_prec(result_));
+        eval_mpfr_constant(t, x, rnd_);
+        mpc_set_fr(result_, t, rnd_);
+        mpfr_clear(t);
     }
 
     void bvisit(const Gamma &x)
@@ -10,12 +10,79 @@
 #include <symengine/constants.h>
 #include <symengine/visitor.h>
 #include <symengine/eval_mpfr.h>
+#include <symengine/real_mpfr.h>
+#include <mutex>
+#include <algorithm>
 
 #ifdef HAVE_SYMENGINE_MPFR
 
 namespace SymEngine
 {
 
+namespace
+{
+
+int const_e(mpfr_ptr result, mpfr_rnd_t rnd)
+{
+    mpfr_set_ui(result, 1, rnd);
+    return mpfr_exp(result, result, rnd);
+}
+
+//! Value of a constant at the highest precision requested so far
+class ConstantCache
+{
+public:
+    typedef int (*const_fn)(mpfr_ptr, mpfr_rnd_t);
+
+    ConstantCache(const_fn f) : f_(f), value_(MPFR_PREC_MIN), prec_(0)
+    {
+    }
+
+    void get(mpfr_ptr result, mpfr_rnd_t rnd)
+    {
+        mpfr_prec_t prec = mpfr_get_prec(result);
+        // one more bit to round correctly to nearest
+        mpfr_prec_t target = prec + (rnd == MPFR_RNDN ? 1 : 0);
+        std::lock_guard<std::mutex> lock(mutex_);
+        // The cached value is correctly rounded, so its error is less than
+        // 2**(EXP - prec_ + 1). It is recomputed if that is not enough to
+        // round it to `prec` bits, which only happens if it is very close to
+        // a rounding boundary.
+        while (prec_ < target
+               or not mpfr_can_round(value_.get_mpfr_t(), prec_ - 1,
+                                     MPFR_RNDN, rnd, target)) {
+            prec_ = std::max(2 * prec_, prec + 64);
+            mpfr_set_prec(value_.get_mpfr_t(), prec_);
+            f_(value_.get_mpfr_t(), MPFR_RNDN);
+        }
+        mpfr_set(result, value_.get_mpfr_t(), rnd);
+    }
+
+private:
+    const_fn f_;
+    mpfr_class value_;
+    mpfr_prec_t prec_;
+    std::mutex mutex_;
+};
+
+} // anonymous namespace
+
+void eval_mpfr_constant(mpfr_ptr result, const Basic &c, mpfr_rnd_t rnd)
+{
+    static ConstantCache pi_cache(mpfr_const_pi), e_cache(const_e),
+        euler_cache(mpfr_const_euler);
+    if (eq(c, *pi)) {
+        pi_cache.get(result, rnd);
+    } else if (eq(c, *E)) {
+        e_cache.get(result, rnd);
+    } else if (eq(c, *EulerGamma)) {
+        euler_cache.get(result, rnd);
+    } else {
+        throw std::runtime_error("Constant " + c.__str__()
+                                 + " is not implemented.");
+    }
+}
+
 class EvalMPFRVisitor : public BaseVisitor<EvalMPFRVisitor>
 {
 protected:
@@ -277,20 +344,7 @@ public:
 
     void bvisit(const Constant &x)
     {
-        if (x.__eq__(*pi)) {
-            mpfr_const_pi(result_, rnd_);
-        } else if (x.__eq__(*E)) {
-            mpfr_t one_;
-            mpfr_init2(one_, mpfr_get_prec(result_));
-            mpfr_set_ui(one_, 1, rnd_);
-            mpfr_exp(result_, one_, rnd_);
-            mpfr_clear(one_);
-        } else if (x.__eq__(*EulerGamma)) {
-            mpfr_const_euler(result_, rnd_);
-        } else {
-            throw std::runtime_error("Constant " + x.get_name()
-                                     + " is not implemented.");
-        }
+        eval_mpfr_constant(result_, x, rnd_);
     }
 
     void bvisit(const Abs &x)
@@ -18,6 +18,12 @@ namespace SymEngine
 
 void eval_mpfr(mpfr_ptr result, const Basic &b, mpfr_rnd_t rnd);
 
+//! Sets `result` to the constant `c` (`pi`, `E` or `EulerGamma`) rounded
+//! with `rnd` to the precision of `result`. Every constant is computed once
+//! at the highest precision requested so far and rounded for lower requests.
+//! The cache is shared between threads.
+void eval_mpfr_constant(mpfr_ptr result, const Basic &c, mpfr_rnd_t rnd);
+
 } // SymEngine
 
 #endif // HAVE_SYMENGINE_MPFR
@@ -0,0 +1,102 @@
+#include <cmath>
+
+#include <symengine/exact_sum.h>
+
+namespace SymEngine
+{
+
+namespace
+{
+
+// Terms from 2**970 up are kept scaled by 2**-80, so that no partial sum of
+// fewer than 2**53 terms overflows in either list
+const int large_exponent = 970;
+const int large_scale = 80;
+
+// Adds x to the non-overlapping partials p. Every partial is replaced by
+// the rounding error of adding it to x, zero errors are dropped.
+void add_partial(std::vector<double> &p, double x)
+{
+    std::size_t i = 0;
+    for (double y : p) {
+        if (std::fabs(x) < std::fabs(y))
+            std::swap(x, y);
+        double hi = x + y;
+        double lo = y - (hi - x);
+        if (lo != 0)
+            p[i++] = lo;
+        x = hi;
+    }
+    p.resize(i);
+    p.push_back(x);
+}
+
+// \return the sum of the partials p rounded to the nearest double
+double round_partials(const std::vector<double> &p)
+{
+    std::size_t n = p.size();
+    if (n == 0)
+        return 0;
+    // Add the partials from the largest one until the sum is inexact
+    double hi = p[--n], lo = 0;
+    while (n > 0) {
+        double x = hi, y = p[--n];
+        hi = x + y;
+        lo = y - (hi - x);
+        if (lo != 0)
+            break;
+    }
+    // If the rounding error is exactly half an ulp, the remaining partials
+    // decide the direction of rounding
+    if (n > 0 and ((lo < 0 and p[n - 1] < 0) or (lo > 0 and p[n - 1] > 0))) {
+        double y = 2 * lo, x = hi + y;
+        if (y == x - hi)
+            hi = x;
+    }
+    return hi;
+}
+
+} // anonymous namespace
+
+void ExactSum::add(double x)
+{
+    if (not std::isfinite(x)) {
+        special_ += x;
+        has_special_ = true;
+    } else if (std::fabs(x) >= std::ldexp(1.0, large_exponent)) {
+        add_partial(large_, std::ldexp(x, -large_scale));
+    } else {
+        add_partial(partials_, x);
+    }
+}
+
+void ExactSum::add(const ExactSum &s)
+{
+    for (double y : s.partials_)
+        add_partial(partials_, y);
+    for (double y : s.large_)
+        add_partial(large_, y);
+    if (s.has_special_) {
+        special_ += s.special_;
+        has_special_ = true;
+    }
+}
+
+double ExactSum::round() const
+{
+    if (has_special_)
+        return special_;
+    // The partials are non-overlapping, so their sum is zero only if they
+    // are all zero
+    if (round_partials(large_) == 0)
+        return round_partials(partials_);
+    // The sum is rounded in the scaled range and then overflows only if the
+    // exact sum does. Scaling the other partials drops their bits below
+    // 2**-994, which matter only if the large terms cancel down to there.
+    std::vector<double> p = large_;
+    for (double y : partials_)
+        add_partial(p, std::ldexp(y, -large_scale));
+    return std::ldexp(round_partials(p), large_scale);
+}
+
+} // SymEngine
@@ -0,0 +1,41 @@
+/**
+ *  \file exact_sum.h
+ *  Correctly rounded summation of doubles
+ *
+ **/
+#ifndef SYMENGINE_EXACT_SUM_H
+#define SYMENGINE_EXACT_SUM_H
+
+#include <vector>
+
+namespace SymEngine
+{
+
+//! Sum of doubles kept exactly as a list of non-overlapping partial sums
+//! (Shewchuk's algorithm, as in Python's `math.fsum`). The result is the
+//! exact sum rounded once, so it does not depend on the order in which the
+//! terms were added, even if some partial sums would overflow: the terms
+//! close to the largest double are summed separately, scaled down, and the
+//! result is infinite only if the exact sum overflows. Infinite and NaN
+//! terms are added separately with ordinary arithmetic and decide the
+//! result.
+class ExactSum
+{
+public:
+    void add(double x);
+    //! adds the terms of `s`, as if they had been added to this sum
+    void add(const ExactSum &s);
+    //! \return the sum rounded to the nearest double
+    double round() const;
+
+private:
+    std::vector<double> partials_;
+    //! partials of the terms of magnitude at least 2**970, times 2**-80
+    std::vector<double> large_;
+    double special_ = 0;
+    bool has_special_ = false;
+};
+
+} // SymEngine
+
+#endif
@@ -50,75 +50,52 @@ extern umap_basic_basic inverse_cst;
 
 extern umap_basic_basic inverse_tct;
 
+//! \return `true` if `12*c` is an integer, which is then stored in `n`
+static bool is_twelfth(const Number &c, const Ptr<RCP<const Integer>> &n)
+{
+    if (is_a<Integer>(c)) {
+        *n = static_cast<const Integer &>(c).mulint(*integer(12));
+        return true;
+    }
+    if (not is_a<Rational>(c))
+        return false;
+    const rational_class &q = static_cast<const Rational &>(c).i;
+    integer_class twelve(12);
+    if (not mp_divisible_p(twelve, get_den(q)))
+        return false;
+    *n = integer(get_num(q) * (twelve / get_den(q)));
+    return true;
+}
+
 bool get_pi_shift(const RCP<const Basic> &arg, const Ptr<RCP<const Integer>> &n,
                   const Ptr<RCP<const Basic>> &x)
 {
     if (is_a<Add>(*arg)) {
+        // arg should be of form `theta + n*pi/12`, where `n` is an integer.
+        // `pi` is looked up directly, so that arguments without it are
+        // rejected without building any new expression.
         const Add &s = static_cast<const Add &>(*arg);
-        RCP<const Basic> coef = s.coef_;
-        int size = s.dict_.size();
-        if (size > 1) {
-            // arg should be of form `theta + n*pi/12`
-            // `n` is an integer
-            // `theta` is an `Expression`
-            bool check_pi = false;
-            RCP<const Basic> temp;
-            *x = coef;
-            for (const auto &p : s.dict_) {
-                temp = mul(p.second, integer(12));
-                if (is_a<Constant>(*p.first)
-                    and eq(*(rcp_static_cast<const Constant>(p.first)), *pi)
-                    and is_a<Integer>(*temp)) {
-                    check_pi = true;
-                    *n = rcp_dynamic_cast<const Integer>(temp);
-                } else {
-                    *x = add(mul(p.first, p.second), *x);
-                }
-            }
-            if (check_pi)
-                return true;
-            else // No term with `pi` found
-                return false;
-        } else if (size == 1) {
-            // arg should be of form `a + n*pi/12`
-            // where `a` is a `Number`.
-            auto p = s.dict_.begin();
-            RCP<const Basic> temp = mul(p->second, integer(12));
-            if (is_a<Constant>(*p->first)
-                and eq(*(rcp_static_cast<const Constant>(p->first)), *pi)
-                and is_a<Integer>(*temp)) {
-
-                *n = rcp_dynamic_cast<const Integer>(temp);
-                *x = coef;
-                return true;
-            } else {
-                return false;
-            }
-        } else { // Should never reach here though!
-            // Dict of size < 1
+        auto p = s.dict_.find(pi);
+        if (p == s.dict_.end() or not is_twelfth(*p->second, n))
             return false;
-        }
+        umap_basic_num d = s.dict_;
+        d.erase(pi);
+        *x = Add::from_dict(s.coef_, std::move(d));
+        return true;
     } else if (is_a<Mul>(*arg)) {
         // `arg` is of the form `k*pi/12`
-        const Mul &s = static_cast<const Mul &>(*arg);
-        RCP<const Basic> coef = s.coef_;
-        coef = mul(coef, integer(12));
-        auto p = s.dict_.begin();
         // dict should contain symbol `pi` only
         // and coeff should be a multiple of 12
-        if (s.dict_.size() == 1 and is_a<Constant>(*p->first)
-            and eq(*(rcp_static_cast<const Constant>(p->first)), *pi)
-            and eq(*(rcp_static_cast<const Number>(p->second)), *one)
-            and is_a<Integer>(*coef)) {
-
-            *n = rcp_dynamic_cast<const Integer>(coef);
+        const Mul &s = static_cast<const Mul &>(*arg);
+        auto p = s.dict_.begin();
+        if (s.dict_.size() == 1 and eq(*p->first, *pi)
+            and eq(*p->second, *one) and is_twelfth(*s.coef_, n)) {
             *x = zero;
             return true;
         } else {
             return false;
         }
-    } else if (is_a<Constant>(*arg)
-               and eq(*(rcp_static_cast<const Constant>(arg)), *pi)) {
+    } else if (eq(*arg, *pi)) {
         *n = integer(12);
         *x = zero;
         return true;
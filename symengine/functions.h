@@ -22,8 +22,13 @@ class OneArgFunction : public Function
 private:
     RCP<const Basic> arg_; //! The `arg` in `OneArgFunction(arg)`
 public:
-    //! Constructor
-    OneArgFunction(const RCP<const Basic> &arg) : arg_{arg} {};
+    //! Constructor. The hash of the argument is computed here, so that the
+    //! hash of the function only combines it with the type code. The hash of
+    //! the function itself cannot be computed in a base class constructor.
+    OneArgFunction(const RCP<const Basic> &arg) : arg_{arg}
+    {
+        arg_->hash();
+    };
     //! \return the hash
     inline std::size_t __hash__() const
     {
@@ -69,7 +74,11 @@ private:
 public:
     //! Constructor
     TwoArgFunction(const RCP<const Basic> &a, const RCP<const Basic> &b)
-        : a_{a}, b_{b} {};
+        : a_{a}, b_{b}
+    {
+        a_->hash();
+        b_->hash();
+    };
     //! \return the hash
     inline std::size_t __hash__() const
     {
@@ -129,7 +138,11 @@ private:
 
 public:
     //! Constructor
-    MultiArgFunction(const vec_basic &arg) : arg_{arg} {};
+    MultiArgFunction(const vec_basic &arg) : arg_{arg}
+    {
+        for (const auto &a : arg_)
+            a->hash();
+    };
     //! \return the hash
     inline std::size_t __hash__() const
     {
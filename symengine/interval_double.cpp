@@ -0,0 +1,383 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <symengine/interval_double.h>
+
+namespace SymEngine
+{
+
+namespace
+{
+
+const double inf = std::numeric_limits<double>::infinity();
+const double nan_d = std::numeric_limits<double>::quiet_NaN();
+const double pi_d = 3.141592653589793;
+
+// Maximal error in ulps assumed for the functions of the C math library
+const unsigned libm_ulps = 4;
+const unsigned gamma_ulps = 16;
+
+// Minimum of gamma(x) for x > 0, at x = 1.4616321449683623...
+const double gamma_min_x_lo = 1.461632144968361;
+const double gamma_min_x_hi = 1.461632144968363;
+const double gamma_min_lo = 0.885603194410888;
+const double lgamma_min_lo = -0.12148629053585;
+
+inline double down(double x, unsigned ulps = 1)
+{
+    for (unsigned i = 0; i < ulps; i++)
+        x = std::nextafter(x, -inf);
+    return x;
+}
+
+inline double up(double x, unsigned ulps = 1)
+{
+    for (unsigned i = 0; i < ulps; i++)
+        x = std::nextafter(x, inf);
+    return x;
+}
+
+inline IntervalDouble empty()
+{
+    return IntervalDouble(nan_d, nan_d);
+}
+
+inline IntervalDouble entire()
+{
+    return IntervalDouble(-inf, inf);
+}
+
+// Intersection of `x` with `[a, b]`
+IntervalDouble intersect(const IntervalDouble &x, double a, double b)
+{
+    if (x.is_empty() || x.hi < a || x.lo > b)
+        return empty();
+    return IntervalDouble(std::max(x.lo, a), std::min(x.hi, b));
+}
+
+template <typename F>
+IntervalDouble increasing(const IntervalDouble &x, F f,
+                          unsigned ulps = libm_ulps)
+{
+    if (x.is_empty())
+        return x;
+    return IntervalDouble(down(f(x.lo), ulps), up(f(x.hi), ulps));
+}
+
+template <typename F>
+IntervalDouble decreasing(const IntervalDouble &x, F f,
+                          unsigned ulps = libm_ulps)
+{
+    if (x.is_empty())
+        return x;
+    return IntervalDouble(down(f(x.hi), ulps), up(f(x.lo), ulps));
+}
+
+IntervalDouble clamp(const IntervalDouble &x, double a, double b)
+{
+    return IntervalDouble(std::max(x.lo, a), std::min(x.hi, b));
+}
+
+// true if `x` may contain a point `c + k*period` for an integer `k`. The
+// tolerance is much larger than the rounding errors of the quotients, so
+// that no such point is missed.
+bool contains_periodic(const IntervalDouble &x, double c, double period)
+{
+    double a = (x.lo - c) / period, b = (x.hi - c) / period;
+    double tol = 1e-12 * (1 + std::max(std::abs(a), std::abs(b)));
+    return std::floor(b + tol) >= std::ceil(a - tol);
+}
+
+inline double mul_down(double a, double b)
+{
+    return (a == 0 || b == 0) ? 0 : down(a * b);
+}
+
+inline double mul_up(double a, double b)
+{
+    return (a == 0 || b == 0) ? 0 : up(a * b);
+}
+
+} // anonymous namespace
+
+bool IntervalDouble::is_empty() const
+{
+    return std::isnan(lo) || std::isnan(hi) || lo > hi;
+}
+
+IntervalDouble widen(const IntervalDouble &x, unsigned ulps)
+{
+    return IntervalDouble(down(x.lo, ulps), up(x.hi, ulps));
+}
+
+IntervalDouble operator-(const IntervalDouble &x)
+{
+    return IntervalDouble(-x.hi, -x.lo);
+}
+
+IntervalDouble operator+(const IntervalDouble &x, const IntervalDouble &y)
+{
+    return IntervalDouble(down(x.lo + y.lo), up(x.hi + y.hi));
+}
+
+IntervalDouble operator-(const IntervalDouble &x, const IntervalDouble &y)
+{
+    return IntervalDouble(down(x.lo - y.hi), up(x.hi - y.lo));
+}
+
+IntervalDouble operator*(const IntervalDouble &x, const IntervalDouble &y)
+{
+    if (x.is_empty() || y.is_empty())
+        return empty();
+    double lo = std::min(std::min(mul_down(x.lo, y.lo), mul_down(x.lo, y.hi)),
+                         std::min(mul_down(x.hi, y.lo), mul_down(x.hi, y.hi)));
+    double hi = std::max(std::max(mul_up(x.lo, y.lo), mul_up(x.lo, y.hi)),
+                         std::max(mul_up(x.hi, y.lo), mul_up(x.hi, y.hi)));
+    return IntervalDouble(lo, hi);
+}
+
+IntervalDouble operator/(const IntervalDouble &x, const IntervalDouble &y)
+{
+    return x * inv(y);
+}
+
+IntervalDouble inv(const IntervalDouble &x)
+{
+    if (x.is_empty())
+        return x;
+    if (x.lo > 0 || x.hi < 0)
+        return IntervalDouble(down(1 / x.hi), up(1 / x.lo));
+    if (x.lo == 0 && x.hi > 0)
+        return IntervalDouble(down(1 / x.hi), inf);
+    if (x.hi == 0 && x.lo < 0)
+        return IntervalDouble(-inf, up(1 / x.lo));
+    return entire();
+}
+
+IntervalDouble pow(const IntervalDouble &x, long n)
+{
+    if (x.is_empty() || n == 1)
+        return x;
+    if (n == 0)
+        return IntervalDouble(1);
+    if (n < 0)
+        return inv(pow(x, -n));
+    double a = std::pow(x.lo, n), b = std::pow(x.hi, n);
+    if (n % 2 == 1)
+        return IntervalDouble(down(a, libm_ulps), up(b, libm_ulps));
+    if (x.lo >= 0)
+        return IntervalDouble(std::max(0.0, down(a, libm_ulps)),
+                              up(b, libm_ulps));
+    if (x.hi <= 0)
+        return IntervalDouble(std::max(0.0, down(b, libm_ulps)),
+                              up(a, libm_ulps));
+    return IntervalDouble(0, up(std::max(a, b), libm_ulps));
+}
+
+IntervalDouble pow(const IntervalDouble &x, const IntervalDouble &y)
+{
+    if (y.lo == y.hi && std::trunc(y.lo) == y.lo && std::abs(y.lo) < 1e9)
+        return pow(x, static_cast<long>(y.lo));
+    return exp(y * log(x));
+}
+
+IntervalDouble sqrt(const IntervalDouble &x)
+{
+    IntervalDouble r = intersect(x, 0, inf);
+    if (r.is_empty())
+        return r;
+    return IntervalDouble(std::max(0.0, down(std::sqrt(r.lo))),
+                          up(std::sqrt(r.hi)));
+}
+
+IntervalDouble exp(const IntervalDouble &x)
+{
+    return clamp(increasing(x, [](double t) { return std::exp(t); }), 0, inf);
+}
+
+IntervalDouble log(const IntervalDouble &x)
+{
+    return increasing(intersect(x, 0, inf),
+                      [](double t) { return std::log(t); });
+}
+
+IntervalDouble abs(const IntervalDouble &x)
+{
+    if (x.is_empty() || x.lo >= 0)
+        return x;
+    if (x.hi <= 0)
+        return -x;
+    return IntervalDouble(0, std::max(-x.lo, x.hi));
+}
+
+IntervalDouble max(const IntervalDouble &x, const IntervalDouble &y)
+{
+    if (x.is_empty() || y.is_empty())
+        return empty();
+    return IntervalDouble(std::max(x.lo, y.lo), std::max(x.hi, y.hi));
+}
+
+IntervalDouble min(const IntervalDouble &x, const IntervalDouble &y)
+{
+    if (x.is_empty() || y.is_empty())
+        return empty();
+    return IntervalDouble(std::min(x.lo, y.lo), std::min(x.hi, y.hi));
+}
+
+IntervalDouble sin(const IntervalDouble &x)
+{
+    if (x.is_empty())
+        return x;
+    if (!(x.hi - x.lo < 2 * pi_d))
+        return IntervalDouble(-1, 1);
+    double a = std::sin(x.lo), b = std::sin(x.hi);
+    double lo = down(std::min(a, b), libm_ulps);
+    double hi = up(std::max(a, b), libm_ulps);
+    if (contains_periodic(x, pi_d / 2, 2 * pi_d))
+        hi = 1;
+    if (contains_periodic(x, -pi_d / 2, 2 * pi_d))
+        lo = -1;
+    return clamp(IntervalDouble(lo, hi), -1, 1);
+}
+
+IntervalDouble cos(const IntervalDouble &x)
+{
+    if (x.is_empty())
+        return x;
+    if (!(x.hi - x.lo < 2 * pi_d))
+        return IntervalDouble(-1, 1);
+    double a = std::cos(x.lo), b = std::cos(x.hi);
+    double lo = down(std::min(a, b), libm_ulps);
+    double hi = up(std::max(a, b), libm_ulps);
+    if (contains_periodic(x, 0, 2 * pi_d))
+        hi = 1;
+    if (contains_periodic(x, pi_d, 2 * pi_d))
+        lo = -1;
+    return clamp(IntervalDouble(lo, hi), -1, 1);
+}
+
+IntervalDouble tan(const IntervalDouble &x)
+{
+    if (x.is_empty())
+        return x;
+    if (!(x.hi - x.lo < pi_d) || contains_periodic(x, pi_d / 2, pi_d))
+        return entire();
+    return increasing(x, [](double t) { return std::tan(t); });
+}
+
+IntervalDouble asin(const IntervalDouble &x)
+{
+    return increasing(intersect(x, -1, 1),
+                      [](double t) { return std::asin(t); });
+}
+
+IntervalDouble acos(const IntervalDouble &x)
+{
+    return clamp(decreasing(intersect(x, -1, 1),
+                            [](double t) { return std::acos(t); }),
+                 0, inf);
+}
+
+IntervalDouble atan(const IntervalDouble &x)
+{
+    return increasing(x, [](double t) { return std::atan(t); });
+}
+
+IntervalDouble atan2(const IntervalDouble &y, const IntervalDouble &x)
+{
+    if (x.is_empty() || y.is_empty())
+        return empty();
+    if (x.lo <= 0 && y.lo <= 0 && y.hi >= 0)
+        return IntervalDouble(-up(pi_d), up(pi_d));
+    // Otherwise the box lies in an open half plane without the negative real
+    // axis, where the angle is continuous and its extrema are at the corners
+    double a = std::atan2(y.lo, x.lo), b = std::atan2(y.lo, x.hi);
+    double c = std::atan2(y.hi, x.lo), d = std::atan2(y.hi, x.hi);
+    return IntervalDouble(
+        down(std::min(std::min(a, b), std::min(c, d)), libm_ulps),
+        up(std::max(std::max(a, b), std::max(c, d)), libm_ulps));
+}
+
+IntervalDouble sinh(const IntervalDouble &x)
+{
+    return increasing(x, [](double t) { return std::sinh(t); });
+}
+
+IntervalDouble cosh(const IntervalDouble &x)
+{
+    if (x.is_empty())
+        return x;
+    auto f = [](double t) { return std::cosh(t); };
+    if (x.lo >= 0)
+        return clamp(increasing(x, f), 1, inf);
+    if (x.hi <= 0)
+        return clamp(decreasing(x, f), 1, inf);
+    return IntervalDouble(1, up(f(std::max(-x.lo, x.hi)), libm_ulps));
+}
+
+IntervalDouble tanh(const IntervalDouble &x)
+{
+    return clamp(increasing(x, [](double t) { return std::tanh(t); }), -1, 1);
+}
+
+IntervalDouble asinh(const IntervalDouble &x)
+{
+    return increasing(x, [](double t) { return std::asinh(t); });
+}
+
+IntervalDouble acosh(const IntervalDouble &x)
+{
+    return clamp(increasing(intersect(x, 1, inf),
+                            [](double t) { return std::acosh(t); }),
+                 0, inf);
+}
+
+IntervalDouble atanh(const IntervalDouble &x)
+{
+    return increasing(intersect(x, -1, 1),
+                      [](double t) { return std::atanh(t); });
+}
+
+IntervalDouble erf(const IntervalDouble &x)
+{
+    return clamp(increasing(x, [](double t) { return std::erf(t); }), -1, 1);
+}
+
+IntervalDouble tgamma(const IntervalDouble &x)
+{
+    if (x.is_empty())
+        return x;
+    if (x.lo <= 0)
+        return entire();
+    auto f = [](double t) { return std::tgamma(t); };
+    if (x.lo >= gamma_min_x_hi)
+        return increasing(x, f, gamma_ulps);
+    if (x.hi <= gamma_min_x_lo)
+        return decreasing(x, f, gamma_ulps);
+    return IntervalDouble(gamma_min_lo,
+                          up(std::max(f(x.lo), f(x.hi)), gamma_ulps));
+}
+
+IntervalDouble lgamma(const IntervalDouble &x)
+{
+    if (x.is_empty())
+        return x;
+    if (x.lo <= 0)
+        return entire();
+    // lgamma has zeros at 1 and 2, where its relative error is unbounded
+    const double abs_err = std::ldexp(1.0, -50);
+    auto f = [](double t) { return std::lgamma(t); };
+    IntervalDouble r;
+    if (x.lo >= gamma_min_x_hi) {
+        r = increasing(x, f, gamma_ulps);
+    } else if (x.hi <= gamma_min_x_lo) {
+        r = decreasing(x, f, gamma_ulps);
+    } else {
+        r = IntervalDouble(lgamma_min_lo,
+                           up(std::max(f(x.lo), f(x.hi)), gamma_ulps));
+    }
+    return IntervalDouble(r.lo - abs_err, r.hi + abs_err);
+}
+
+} // SymEngine
@@ -0,0 +1,84 @@
+/**
+ *  \file interval_double.h
+ *  Interval arithmetic in double precision
+ *
+ **/
+#ifndef SYMENGINE_INTERVAL_DOUBLE_H
+#define SYMENGINE_INTERVAL_DOUBLE_H
+
+namespace SymEngine
+{
+
+//! Closed interval `[lo, hi]` of doubles. The functions below return an
+//! interval that contains the exact value of the function at every point of
+//! the arguments. Instead of switching the rounding mode, every bound is
+//! rounded outward by one ulp (a few ulps for the functions of the C math
+//! library, which are not correctly rounded). Points outside of the domain
+//! of a function are ignored; if there are none, the result is empty and
+//! both bounds are NaN.
+struct IntervalDouble {
+    double lo, hi;
+
+    IntervalDouble() : lo(0), hi(0)
+    {
+    }
+    IntervalDouble(double x) : lo(x), hi(x)
+    {
+    }
+    IntervalDouble(double lo_, double hi_) : lo(lo_), hi(hi_)
+    {
+    }
+    bool is_empty() const;
+    bool contains(double x) const
+    {
+        return lo <= x && x <= hi;
+    }
+};
+
+//! \return `x` with the bounds moved outward by `ulps` ulps
+IntervalDouble widen(const IntervalDouble &x, unsigned ulps = 1);
+
+IntervalDouble operator-(const IntervalDouble &x);
+IntervalDouble operator+(const IntervalDouble &x, const IntervalDouble &y);
+IntervalDouble operator-(const IntervalDouble &x, const IntervalDouble &y);
+IntervalDouble operator*(const IntervalDouble &x, const IntervalDouble &y);
+IntervalDouble operator/(const IntervalDouble &x, const IntervalDouble &y);
+//! \return `1/x`, the whole real line if `x` contains zero in its interior
+IntervalDouble inv(const IntervalDouble &x);
+
+IntervalDouble pow(const IntervalDouble &x, long n);
+//! \return `x**y` for `x >= 0`, or `pow(x, n)` if `y` is the integer `n`
+IntervalDouble pow(const IntervalDouble &x, const IntervalDouble &y);
+IntervalDouble sqrt(const IntervalDouble &x);
+IntervalDouble exp(const IntervalDouble &x);
+IntervalDouble log(const IntervalDouble &x);
+IntervalDouble abs(const IntervalDouble &x);
+IntervalDouble max(const IntervalDouble &x, const IntervalDouble &y);
+IntervalDouble min(const IntervalDouble &x, const IntervalDouble &y);
+
+IntervalDouble sin(const IntervalDouble &x);
+IntervalDouble cos(const IntervalDouble &x);
+IntervalDouble tan(const IntervalDouble &x);
+IntervalDouble asin(const IntervalDouble &x);
+IntervalDouble acos(const IntervalDouble &x);
+IntervalDouble atan(const IntervalDouble &x);
+//! \return the range of `atan2(y, x)`, `[-pi, pi]` if the box contains
+//! the origin or crosses the negative real axis
+IntervalDouble atan2(const IntervalDouble &y, const IntervalDouble &x);
+
+IntervalDouble sinh(const IntervalDouble &x);
+IntervalDouble cosh(const IntervalDouble &x);
+IntervalDouble tanh(const IntervalDouble &x);
+IntervalDouble asinh(const IntervalDouble &x);
+IntervalDouble acosh(const IntervalDouble &x);
+IntervalDouble atanh(const IntervalDouble &x);
+
+IntervalDouble erf(const IntervalDouble &x);
+//! The bounds of `tgamma` and `lgamma` are only tight for `x > 0`; the
+//! whole real line is returned otherwise.
+IntervalDouble tgamma(const IntervalDouble &x);
+IntervalDouble lgamma(const IntervalDouble &x);
+
+} // SymEngine
+
+#endif
@@ -0,0 +1,345 @@
+#include <cmath>
+#include <algorithm>
+
+#include <symengine/lambda_batch.h>
+#include <symengine/add.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+#include <symengine/integer.h>
+#include <symengine/rational.h>
+#include <symengine/functions.h>
+#include <symengine/visitor.h>
+#include <symengine/eval_double.h>
+#include <symengine/tape_compiler.h>
+
+namespace SymEngine
+{
+
+namespace
+{
+
+typedef LambdaComplexDoubleBatch::complex_fn complex_fn;
+typedef LambdaComplexDoubleBatch Batch;
+typedef TapeCompiler<std::complex<double>, Batch> BatchTapeCompiler;
+
+//! Compiles expressions to the instructions of LambdaComplexDoubleBatch,
+//! whose operands are values. The values are mapped to slots afterwards,
+//! when the registers are allocated.
+class BatchCompiler : public BaseVisitor<BatchCompiler, BatchTapeCompiler>
+{
+public:
+    BatchCompiler(const vec_basic &inputs)
+        : BaseVisitor<BatchCompiler, BatchTapeCompiler>(inputs)
+    {
+    }
+
+    using BatchTapeCompiler::bvisit;
+
+    void bvisit(const Pow &x)
+    {
+        const RCP<const Basic> &base = x.get_base(), &exp = x.get_exp();
+        if (eq(*base, *E)) {
+            result_ = emit(Batch::EXP, value(exp));
+            return;
+        }
+        if (is_a<Integer>(*exp)) {
+            const Integer &n = static_cast<const Integer &>(*exp);
+            if (mp_fits_slong_p(n.i)) {
+                result_ = power(value(base), mp_get_si(n.i));
+                return;
+            }
+        }
+        if (eq(*exp, *rational(1, 2))) {
+            result_ = function(value(base), sqrt_);
+            return;
+        }
+        // base**exp = exp(exp*log(base))
+        unsigned l = emit(Batch::LOG, value(base));
+        if (free_symbols(*exp).empty())
+            l = scale(l, *exp);
+        else
+            l = emit(Batch::MUL, l, value(exp));
+        result_ = emit(Batch::EXP, l);
+    }
+
+    void bvisit(const Log &x)
+    {
+        result_ = emit(Batch::LOG, value(x.get_arg()));
+    }
+
+    void bvisit(const Sin &x)
+    {
+        result_ = emit(Batch::SIN, value(x.get_arg()));
+    }
+
+    void bvisit(const Cos &x)
+    {
+        result_ = emit(Batch::COS, value(x.get_arg()));
+    }
+
+#define SYMENGINE_BATCH_FUNCTION(Class, expr)                                  \
+    void bvisit(const Class &x)                                                \
+    {                                                                          \
+        struct F {                                                             \
+            static std::complex<double> f(const std::complex<double> &z)       \
+            {                                                                  \
+                return expr;                                                   \
+            }                                                                  \
+        };                                                                     \
+        result_ = function(value(x.get_arg()), F::f);                          \
+    }
+
+    SYMENGINE_BATCH_FUNCTION(Tan, std::tan(z))
+    SYMENGINE_BATCH_FUNCTION(Cot, 1.0 / std::tan(z))
+    SYMENGINE_BATCH_FUNCTION(Csc, 1.0 / std::sin(z))
+    SYMENGINE_BATCH_FUNCTION(Sec, 1.0 / std::cos(z))
+    SYMENGINE_BATCH_FUNCTION(ASin, std::asin(z))
+    SYMENGINE_BATCH_FUNCTION(ACos, std::acos(z))
+    SYMENGINE_BATCH_FUNCTION(ATan, std::atan(z))
+    SYMENGINE_BATCH_FUNCTION(Sinh, std::sinh(z))
+    SYMENGINE_BATCH_FUNCTION(Cosh, std::cosh(z))
+    SYMENGINE_BATCH_FUNCTION(Tanh, std::tanh(z))
+    SYMENGINE_BATCH_FUNCTION(Coth, 1.0 / std::tanh(z))
+    SYMENGINE_BATCH_FUNCTION(Csch, 1.0 / std::sinh(z))
+    SYMENGINE_BATCH_FUNCTION(Sech, 1.0 / std::cosh(z))
+    SYMENGINE_BATCH_FUNCTION(ASinh, std::asinh(z))
+    SYMENGINE_BATCH_FUNCTION(ACosh, std::acosh(z))
+    SYMENGINE_BATCH_FUNCTION(ATanh, std::atanh(z))
+    SYMENGINE_BATCH_FUNCTION(Abs, std::abs(z))
+
+#undef SYMENGINE_BATCH_FUNCTION
+
+private:
+    static std::complex<double> sqrt_(const std::complex<double> &z)
+    {
+        return std::sqrt(z);
+    }
+
+    unsigned function(unsigned a, complex_fn f)
+    {
+        unsigned v = emit(Batch::FUNCTION, a);
+        code_.back().f = f;
+        return v;
+    }
+
+    //! \return `a**n` computed by repeated squaring
+    unsigned power(unsigned a, long n)
+    {
+        unsigned long m = n < 0 ? -(unsigned long)n : n;
+        if (m == 0)
+            return constant(1.0);
+        unsigned r = 0;
+        bool first = true;
+        while (true) {
+            if (m & 1) {
+                r = first ? a : emit(Batch::MUL, r, a);
+                first = false;
+            }
+            m >>= 1;
+            if (m == 0)
+                break;
+            a = emit(Batch::MUL, a, a);
+        }
+        return n < 0 ? emit(Batch::INV, r) : r;
+    }
+};
+
+} // anonymous namespace
+
+void LambdaComplexDoubleBatch::init(const vec_basic &inputs,
+                                    const vec_basic &outputs)
+{
+    BatchCompiler compiler(inputs);
+    std::vector<unsigned> outs;
+    for (const auto &p : outputs)
+        outs.push_back(compiler.value(p));
+
+    const auto &values = compiler.values_;
+    ninputs_ = inputs.size();
+    consts_ = compiler.consts_;
+    code_ = compiler.code_;
+
+    // Every instruction uses its operands a and b except the unary ones
+    // which only use a
+    auto is_binary = [](Op op) { return op == ADD or op == MUL; };
+
+    // The registers of the results are freed after their last use, the
+    // outputs are never freed.
+    std::vector<size_t> last_use(values.size(), 0);
+    for (size_t i = 0; i < code_.size(); i++) {
+        last_use[code_[i].a] = i;
+        if (is_binary(code_[i].op))
+            last_use[code_[i].b] = i;
+    }
+    for (unsigned v : outs)
+        last_use[v] = code_.size();
+
+    std::vector<Slot> slots(values.size());
+    unsigned first_reg = ninputs_ + consts_.size();
+    for (size_t v = 0; v < values.size(); v++) {
+        if (values[v].kind == BatchCompiler::INPUT)
+            slots[v] = values[v].index;
+        else if (values[v].kind == BatchCompiler::CONST)
+            slots[v] = ninputs_ + values[v].index;
+    }
+    std::vector<Slot> free_regs;
+    nregs_ = 0;
+    for (size_t i = 0; i < code_.size(); i++) {
+        Instruction &ins = code_[i];
+        // the destination is allocated before the operands are freed, so
+        // that it never aliases them
+        if (free_regs.empty()) {
+            slots[ins.dst] = first_reg + nregs_++;
+        } else {
+            slots[ins.dst] = free_regs.back();
+            free_regs.pop_back();
+        }
+        bool binary = is_binary(ins.op);
+        for (unsigned v : {ins.a, ins.b}) {
+            if (values[v].kind == BatchCompiler::TEMP and last_use[v] == i)
+                free_regs.push_back(slots[v]);
+            if (not binary or ins.a == ins.b)
+                break;
+        }
+        ins.dst = slots[ins.dst];
+        ins.a = slots[ins.a];
+        ins.b = binary ? slots[ins.b] : 0;
+    }
+    outputs_.clear();
+    for (unsigned v : outs)
+        outputs_.push_back(slots[v]);
+}
+
+void LambdaComplexDoubleBatch::call(double *out_re, double *out_im,
+                                    const double *in_re, const double *in_im,
+                                    std::size_t n) const
+{
+    const unsigned B = block_size;
+    unsigned nslots = ninputs_ + consts_.size() + nregs_;
+    // the constants and the registers, one block each for the real and the
+    // imaginary parts, then a block of zeros and a scratch block
+    std::vector<double> work(2 * B * (consts_.size() + nregs_ + 1), 0.0);
+    std::vector<double *> re(nslots), im(nslots);
+    for (unsigned s = ninputs_; s < nslots; s++) {
+        re[s] = &work[2 * B * (s - ninputs_)];
+        im[s] = re[s] + B;
+    }
+    const double *zeros = &work[work.size() - 2 * B];
+    double *t = &work[work.size() - B];
+    for (size_t i = 0; i < consts_.size(); i++) {
+        std::fill_n(re[ninputs_ + i], B, consts_[i].real());
+        std::fill_n(im[ninputs_ + i], B, consts_[i].imag());
+    }
+
+    for (std::size_t start = 0; start < n; start += B) {
+        const std::size_t m = std::min<std::size_t>(B, n - start);
+        // the inputs are read in place
+        for (unsigned i = 0; i < ninputs_; i++) {
+            re[i] = const_cast<double *>(in_re + i * n + start);
+            im[i] = const_cast<double *>(in_im ? in_im + i * n + start
+                                               : zeros);
+        }
+        for (const Instruction &ins : code_) {
+            double *dr = re[ins.dst], *di = im[ins.dst];
+            const double *ar = re[ins.a], *ai = im[ins.a];
+            const double *br = re[ins.b], *bi = im[ins.b];
+            switch (ins.op) {
+                case ADD:
+                    for (std::size_t k = 0; k < m; k++) {
+                        dr[k] = ar[k] + br[k];
+                        di[k] = ai[k] + bi[k];
+                    }
+                    break;
+                case MUL:
+                    for (std::size_t k = 0; k < m; k++) {
+                        dr[k] = ar[k] * br[k] - ai[k] * bi[k];
+                        di[k] = ar[k] * bi[k] + ai[k] * br[k];
+                    }
+                    break;
+                case SCALE:
+                    for (std::size_t k = 0; k < m; k++) {
+                        dr[k] = ins.c * ar[k];
+                        di[k] = ins.c * ai[k];
+                    }
+                    break;
+                case INV:
+                    // scaled by max(|a|, |b|), so that |z|**2 does not
+                    // overflow or underflow
+                    for (std::size_t k = 0; k < m; k++) {
+                        double s = std::max(std::fabs(ar[k]), std::fabs(ai[k]));
+                        double x = ar[k] / s, y = ai[k] / s;
+                        double d = (x * x + y * y) * s;
+                        dr[k] = x / d;
+                        di[k] = -y / d;
+                    }
+                    break;
+                // sin and cos of the same argument in one loop are merged
+                // into sincos, which has no vector version, so one of them
+                // goes to the scratch block first
+                case EXP:
+                    for (std::size_t k = 0; k < m; k++)
+                        t[k] = std::sin(ai[k]);
+                    for (std::size_t k = 0; k < m; k++) {
+                        double e = std::exp(ar[k]);
+                        dr[k] = e * std::cos(ai[k]);
+                        di[k] = e * t[k];
+                    }
+                    break;
+                case LOG:
+                    for (std::size_t k = 0; k < m; k++) {
+                        dr[k] = std::log(std::hypot(ar[k], ai[k]));
+                        di[k] = std::atan2(ai[k], ar[k]);
+                    }
+                    break;
+                case SIN:
+                    // sin(a + ib) = sin(a)cosh(b) + i cos(a)sinh(b)
+                    for (std::size_t k = 0; k < m; k++)
+                        t[k] = std::cos(ar[k]);
+                    for (std::size_t k = 0; k < m; k++) {
+                        double x = ar[k], y = ai[k];
+                        dr[k] = std::sin(x) * std::cosh(y);
+                        di[k] = t[k] * std::sinh(y);
+                    }
+                    break;
+                case COS:
+                    // cos(a + ib) = cos(a)cosh(b) - i sin(a)sinh(b)
+                    for (std::size_t k = 0; k < m; k++)
+                        t[k] = std::sin(ar[k]);
+                    for (std::size_t k = 0; k < m; k++) {
+                        double x = ar[k], y = ai[k];
+                        dr[k] = std::cos(x) * std::cosh(y);
+                        di[k] = -t[k] * std::sinh(y);
+                    }
+                    break;
+                case FUNCTION:
+                    for (std::size_t k = 0; k < m; k++) {
+                        std::complex<double> z
+                            = ins.f(std::complex<double>(ar[k], ai[k]));
+                        dr[k] = z.real();
+                        di[k] = z.imag();
+                    }
+                    break;
+            }
+        }
+        for (size_t j = 0; j < outputs_.size(); j++) {
+            std::copy_n(re[outputs_[j]], m, out_re + j * n + start);
+            std::copy_n(im[outputs_[j]], m, out_im + j * n + start);
+        }
+    }
+}
+
+void LambdaComplexDoubleBatch::call(std::complex<double> *outs,
+                                    const std::complex<double> *inps) const
+{
+    std::vector<double> in_re(ninputs_), in_im(ninputs_);
+    for (unsigned i = 0; i < ninputs_; i++) {
+        in_re[i] = inps[i].real();
+        in_im[i] = inps[i].imag();
+    }
+    std::vector<double> out_re(outputs_.size()), out_im(outputs_.size());
+    call(out_re.data(), out_im.data(), in_re.data(), in_im.data(), 1);
+    for (size_t j = 0; j < outputs_.size(); j++)
+        outs[j] = std::complex<double>(out_re[j], out_im[j]);
+}
+
+} // SymEngine
@@ -0,0 +1,86 @@
+/**
+ *  \file lambda_batch.h
+ *  Evaluation of expressions at many points at once
+ *
+ **/
+#ifndef SYMENGINE_LAMBDA_BATCH_H
+#define SYMENGINE_LAMBDA_BATCH_H
+
+#include <complex>
+#include <symengine/basic.h>
+
+namespace SymEngine
+{
+
+//! Evaluates expressions in complex double precision at many points at once.
+//! The expressions are compiled to a list of instructions, each of which is
+//! applied to a block of `block_size` points, with the real and imaginary
+//! parts in separate arrays. The loops of the arithmetic instructions are
+//! vectorized by the compiler. The loops of `exp`, `log`, `sin` and `cos`
+//! call the scalar functions of `<cmath>`, so they are only vectorized when
+//! the compiler can use a vector math library, e.g. GCC with `-ffast-math`
+//! on x86-64 glibc, which calls libmvec. Common subexpressions are computed
+//! once, subexpressions without symbols are computed at compile time and
+//! integer powers are computed by repeated squaring. Other functions are
+//! computed one point at a time with `std::complex`.
+class LambdaComplexDoubleBatch
+{
+public:
+    static const unsigned block_size = 256;
+
+    //! Compiles `outputs` as functions of the symbols `inputs`. Throws
+    //! `std::runtime_error` for unsupported expressions.
+    void init(const vec_basic &inputs, const vec_basic &outputs);
+
+    //! Evaluates the outputs at `n` points. The real part of the `i`-th
+    //! input at the `k`-th point is `in_re[i*n + k]`, and the same layout is
+    //! used for `in_im` and for the outputs. `in_im` may be null if all
+    //! inputs are real.
+    void call(double *out_re, double *out_im, const double *in_re,
+              const double *in_im, std::size_t n) const;
+
+    //! Evaluates the outputs at a single point
+    void call(std::complex<double> *outs,
+              const std::complex<double> *inps) const;
+
+    //! \return the number of instructions
+    std::size_t size() const
+    {
+        return code_.size();
+    }
+
+    enum Op {
+        ADD,
+        MUL,
+        SCALE, // multiplication by a real constant
+        INV,
+        EXP,
+        LOG,
+        SIN,
+        COS,
+        FUNCTION, // any other function, evaluated with std::complex
+    };
+    typedef std::complex<double> (*complex_fn)(const std::complex<double> &);
+
+    //! Operand of an instruction: the inputs come first, then the constants
+    //! and then the registers
+    typedef unsigned Slot;
+
+    struct Instruction {
+        Op op;
+        Slot dst, a, b;
+        double c;
+        complex_fn f;
+    };
+
+private:
+    unsigned ninputs_ = 0;
+    std::vector<std::complex<double>> consts_;
+    unsigned nregs_ = 0;
+    std::vector<Instruction> code_;
+    std::vector<Slot> outputs_;
+};
+
+} // SymEngine
+
+#endif
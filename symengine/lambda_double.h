@@ -13,6 +13,7 @@
 #include <symengine/constants.h>
 #include <symengine/visitor.h>
 #include <symengine/eval_double.h>
+#include <symengine/special_double.h>
 
 namespace SymEngine
 {
@@ -91,32 +92,40 @@ public:
         result_ = tmp;
     }
 
+    //! \return the function computing `base**exp`
+    fn power(const Basic &base, const Basic &exp)
+    {
+        if (eq(base, *E)) {
+            fn exp_ = apply(exp);
+            return [=](const std::vector<T> &x) { return std::exp(exp_(x)); };
+        }
+        fn base_ = apply(base);
+        DoublePower p;
+        if (p.init(exp)) {
+            if (eq(exp, *one))
+                return base_;
+            return [=](const std::vector<T> &x) { return p(base_(x)); };
+        }
+        fn exp_ = apply(exp);
+        return [=](const std::vector<T> &x) {
+            return std::pow(base_(x), exp_(x));
+        };
+    }
+
     void bvisit(const Mul &x)
     {
         fn tmp = apply(*x.coef_);
-        fn tmp1, tmp2;
+        fn tmp1;
         for (const auto &p : x.dict_) {
-            tmp1 = apply(*(p.first));
-            tmp2 = apply(*(p.second));
-            tmp = [=](const std::vector<T> &x) {
-                return tmp(x) * std::pow(tmp1(x), tmp2(x));
-            };
+            tmp1 = power(*(p.first), *(p.second));
+            tmp = [=](const std::vector<T> &x) { return tmp(x) * tmp1(x); };
         }
         result_ = tmp;
     }
 
     void bvisit(const Pow &x)
     {
-        fn exp_ = apply(*(x.get_exp()));
-        if (eq(*(x.get_base()), *E)) {
-            result_
-                = [=](const std::vector<T> &x) { return std::exp(exp_(x)); };
-        } else {
-            fn base_ = apply(*(x.get_base()));
-            result_ = [=](const std::vector<T> &x) {
-                return std::pow(base_(x), exp_(x));
-            };
-        }
+        result_ = power(*(x.get_base()), *(x.get_exp()));
     }
 
     void bvisit(const Sin &x)
@@ -292,6 +301,60 @@ public:
             = [=](const std::vector<T> &x) { return std::acosh(1.0 / tmp(x)); };
     };
 
+    void bvisit(const Zeta &x)
+    {
+        fn s = apply(*(x.get_s()));
+        fn a = apply(*(x.get_a()));
+        result_ = [=](const std::vector<T> &x) { return zeta(s(x), a(x)); };
+    };
+
+    void bvisit(const Dirichlet_eta &x)
+    {
+        fn tmp = apply(*(x.get_s()));
+        result_
+            = [=](const std::vector<T> &x) { return dirichlet_eta(tmp(x)); };
+    };
+
+    void bvisit(const LambertW &x)
+    {
+        fn tmp = apply(*(x.get_arg()));
+        result_ = [=](const std::vector<T> &x) { return lambertw(tmp(x)); };
+    };
+
+    void bvisit(const PolyGamma &x)
+    {
+        fn n = apply(*(x.get_arg1()));
+        fn tmp = apply(*(x.get_arg2()));
+        result_ = [=](const std::vector<T> &x) {
+            return polygamma(n(x), tmp(x));
+        };
+    };
+
+    void bvisit(const LowerGamma &x)
+    {
+        fn s = apply(*(x.get_arg1()));
+        fn tmp = apply(*(x.get_arg2()));
+        result_ = [=](const std::vector<T> &x) {
+            return lowergamma(s(x), tmp(x));
+        };
+    };
+
+    void bvisit(const UpperGamma &x)
+    {
+        fn s = apply(*(x.get_arg1()));
+        fn tmp = apply(*(x.get_arg2()));
+        result_ = [=](const std::vector<T> &x) {
+            return uppergamma(s(x), tmp(x));
+        };
+    };
+
+    void bvisit(const Beta &x)
+    {
+        fn a = apply(*(x.get_arg1()));
+        fn b = apply(*(x.get_arg2()));
+        result_ = [=](const std::vector<T> &x) { return beta(a(x), b(x)); };
+    };
+
     void bvisit(const Constant &x)
     {
         if (eq(x, *pi)) {
@@ -322,8 +385,7 @@ class LambdaRealDoubleVisitor
 {
 public:
     // Classes not implemented are
-    // Subs, UpperGamma, LowerGamma, Dirichlet_eta, Zeta
-    // LeviCivita, KroneckerDelta, FunctionSymbol, LambertW
+    // Subs, LeviCivita, KroneckerDelta, FunctionSymbol
     // Derivative, Complex, ComplexDouble, ComplexMPC
 
     using LambdaDoubleVisitor::bvisit;
@@ -399,8 +461,7 @@ class LambdaComplexDoubleVisitor
 {
 public:
     // Classes not implemented are
-    // Subs, UpperGamma, LowerGamma, Dirichlet_eta, Zeta
-    // LeviCivita, KroneckerDelta, FunctionSymbol, LambertW
+    // Subs, LeviCivita, KroneckerDelta, FunctionSymbol
     // Derivative, ATan2, Gamma
 
     using LambdaDoubleVisitor::bvisit;
@@ -434,5 +495,318 @@ public:
     }
 #endif
 };
+//! Compiled form of `eval_interval_double`, for evaluating an expression over
+//! many boxes
+class LambdaIntervalDoubleVisitor
+    : public BaseVisitor<LambdaIntervalDoubleVisitor>
+{
+protected:
+    typedef std::function<IntervalDouble(const std::vector<IntervalDouble> &x)>
+        fn;
+    typedef IntervalDouble (*unary_fn)(const IntervalDouble &);
+    fn result_;
+    vec_basic symbols;
+
+    //! \return a function computing `base**exp`
+    fn power(const Basic &base, const Basic &exp_)
+    {
+        if (eq(base, *E)) {
+            return unary(exp, apply(exp_));
+        }
+        fn base_ = apply(base);
+        if (is_a<Integer>(exp_)) {
+            const integer_class &n = static_cast<const Integer &>(exp_).i;
+            if (mp_fits_slong_p(n)) {
+                long m = mp_get_si(n);
+                return [=](const std::vector<IntervalDouble> &x) {
+                    return pow(base_(x), m);
+                };
+            }
+        } else if (is_a<Rational>(exp_)) {
+            const rational_class &q = static_cast<const Rational &>(exp_).i;
+            if (get_num(q) == 1 && get_den(q) == 2)
+                return unary(sqrt, base_);
+        }
+        fn tmp = apply(exp_);
+        return [=](const std::vector<IntervalDouble> &x) {
+            return pow(base_(x), tmp(x));
+        };
+    }
+
+    static fn unary(unary_fn f, const fn &arg)
+    {
+        return [=](const std::vector<IntervalDouble> &x) { return f(arg(x)); };
+    }
+
+    //! Sets the result to `f(g(arg))`
+    void compose(unary_fn f, unary_fn g, const Basic &arg)
+    {
+        fn tmp = apply(arg);
+        result_ = [=](const std::vector<IntervalDouble> &x) {
+            return f(g(tmp(x)));
+        };
+    }
+
+public:
+    void init(const vec_basic &x, const Basic &b)
+    {
+        symbols = x;
+        apply(b);
+    }
+
+    fn apply(const Basic &b)
+    {
+        b.accept(*this);
+        return result_;
+    }
+
+    IntervalDouble call(const std::vector<IntervalDouble> &vec)
+    {
+        return result_(vec);
+    }
+
+    void bvisit(const Symbol &x)
+    {
+        for (unsigned i = 0; i < symbols.size(); ++i) {
+            if (eq(x, *symbols[i])) {
+                result_ = [=](const std::vector<IntervalDouble> &x) {
+                    return x[i];
+                };
+                return;
+            }
+        }
+        throw std::runtime_error("Symbol not in the symbols vector.");
+    };
+
+    void bvisit(const Number &x)
+    {
+        IntervalDouble tmp = eval_interval_double(x);
+        result_ = [=](const std::vector<IntervalDouble> &x) { return tmp; };
+    }
+
+    void bvisit(const Constant &x)
+    {
+        IntervalDouble tmp = eval_interval_double(x);
+        result_ = [=](const std::vector<IntervalDouble> &x) { return tmp; };
+    }
+
+    void bvisit(const Add &x)
+    {
+        IntervalDouble coef = eval_interval_double(*x.coef_);
+        std::vector<std::pair<IntervalDouble, fn>> terms;
+        for (const auto &p : x.dict_)
+            terms.push_back({eval_interval_double(*p.second), apply(*p.first)});
+        result_ = [=](const std::vector<IntervalDouble> &x) {
+            IntervalDouble tmp = coef;
+            for (const auto &t : terms)
+                tmp = tmp + t.first * t.second(x);
+            return tmp;
+        };
+    }
+
+    void bvisit(const Mul &x)
+    {
+        IntervalDouble coef = eval_interval_double(*x.coef_);
+        std::vector<fn> factors;
+        for (const auto &p : x.dict_)
+            factors.push_back(power(*p.first, *p.second));
+        result_ = [=](const std::vector<IntervalDouble> &x) {
+            IntervalDouble tmp = coef;
+            for (const auto &f : factors)
+                tmp = tmp * f(x);
+            return tmp;
+        };
+    }
+
+    void bvisit(const Pow &x)
+    {
+        result_ = power(*x.get_base(), *x.get_exp());
+    }
+
+    void bvisit(const Sin &x)
+    {
+        result_ = unary(sin, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Cos &x)
+    {
+        result_ = unary(cos, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Tan &x)
+    {
+        result_ = unary(tan, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Cot &x)
+    {
+        compose(inv, tan, *x.get_arg());
+    }
+
+    void bvisit(const Csc &x)
+    {
+        compose(inv, sin, *x.get_arg());
+    }
+
+    void bvisit(const Sec &x)
+    {
+        compose(inv, cos, *x.get_arg());
+    }
+
+    void bvisit(const ASin &x)
+    {
+        result_ = unary(asin, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACos &x)
+    {
+        result_ = unary(acos, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ATan &x)
+    {
+        result_ = unary(atan, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACot &x)
+    {
+        compose(atan, inv, *x.get_arg());
+    }
+
+    void bvisit(const ASec &x)
+    {
+        compose(acos, inv, *x.get_arg());
+    }
+
+    void bvisit(const ACsc &x)
+    {
+        compose(asin, inv, *x.get_arg());
+    }
+
+    void bvisit(const Sinh &x)
+    {
+        result_ = unary(sinh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Cosh &x)
+    {
+        result_ = unary(cosh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Tanh &x)
+    {
+        result_ = unary(tanh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Coth &x)
+    {
+        compose(inv, tanh, *x.get_arg());
+    }
+
+    void bvisit(const Csch &x)
+    {
+        compose(inv, sinh, *x.get_arg());
+    }
+
+    void bvisit(const Sech &x)
+    {
+        compose(inv, cosh, *x.get_arg());
+    }
+
+    void bvisit(const ASinh &x)
+    {
+        result_ = unary(asinh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACosh &x)
+    {
+        result_ = unary(acosh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ATanh &x)
+    {
+        result_ = unary(atanh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACoth &x)
+    {
+        compose(atanh, inv, *x.get_arg());
+    }
+
+    void bvisit(const ACsch &x)
+    {
+        compose(asinh, inv, *x.get_arg());
+    }
+
+    void bvisit(const ASech &x)
+    {
+        compose(acosh, inv, *x.get_arg());
+    }
+
+    void bvisit(const Log &x)
+    {
+        result_ = unary(log, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Abs &x)
+    {
+        result_ = unary(abs, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ATan2 &x)
+    {
+        fn num = apply(*(x.get_num()));
+        fn den = apply(*(x.get_den()));
+        result_ = [=](const std::vector<IntervalDouble> &x) {
+            return atan2(num(x), den(x));
+        };
+    }
+
+    void bvisit(const Gamma &x)
+    {
+        result_ = unary(tgamma, apply(*x.get_args()[0]));
+    }
+
+    void bvisit(const LogGamma &x)
+    {
+        result_ = unary(lgamma, apply(*x.get_args()[0]));
+    }
+
+    void bvisit(const Erf &x)
+    {
+        result_ = unary(erf, apply(*x.get_args()[0]));
+    }
+
+    void bvisit(const Max &x)
+    {
+        std::vector<fn> applys;
+        for (const auto &p : x.get_args())
+            applys.push_back(apply(*p));
+        result_ = [=](const std::vector<IntervalDouble> &x) {
+            IntervalDouble result = applys[0](x);
+            for (unsigned int i = 1; i < applys.size(); i++)
+                result = max(result, applys[i](x));
+            return result;
+        };
+    }
+
+    void bvisit(const Min &x)
+    {
+        std::vector<fn> applys;
+        for (const auto &p : x.get_args())
+            applys.push_back(apply(*p));
+        result_ = [=](const std::vector<IntervalDouble> &x) {
+            IntervalDouble result = applys[0](x);
+            for (unsigned int i = 1; i < applys.size(); i++)
+                result = min(result, applys[i](x));
+            return result;
+        };
+    }
+
+    void bvisit(const Basic &)
+    {
+        throw std::runtime_error("Not implemented.");
+    };
+};
 }
 #endif // SYMENGINE_LAMBDA_DOUBLE_H
@@ -0,0 +1,439 @@
+#include <cmath>
+#include <algorithm>
+
+#include <symengine/lambda_gradient.h>
+#include <symengine/add.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+#include <symengine/integer.h>
+#include <symengine/rational.h>
+#include <symengine/functions.h>
+#include <symengine/visitor.h>
+#include <symengine/eval_double.h>
+#include <symengine/special_double.h>
+#include <symengine/tape_compiler.h>
+
+namespace SymEngine
+{
+
+namespace
+{
+
+typedef LambdaDoubleTape G;
+typedef TapeCompiler<double, G> GradientTapeCompiler;
+
+//! Compiles expressions to the instructions of LambdaDoubleTape
+class GradientCompiler
+    : public BaseVisitor<GradientCompiler, GradientTapeCompiler>
+{
+public:
+    GradientCompiler(const vec_basic &x)
+        : BaseVisitor<GradientCompiler, GradientTapeCompiler>(x)
+    {
+    }
+
+    using GradientTapeCompiler::bvisit;
+
+    void bvisit(const Pow &x)
+    {
+        const RCP<const Basic> &base = x.get_base(), &exp = x.get_exp();
+        if (eq(*base, *E)) {
+            result_ = emit(G::EXP, value(exp));
+        } else if (is_a<Integer>(*exp)
+                   and mp_fits_slong_p(static_cast<const Integer &>(*exp).i)) {
+            long n = mp_get_si(static_cast<const Integer &>(*exp).i);
+            result_ = emit(G::POWI, value(base), 0, n);
+        } else if (eq(*exp, *rational(1, 2))) {
+            result_ = emit(G::SQRT, value(base));
+        } else if (eq(*exp, *rational(-1, 2))) {
+            result_ = emit(G::INV, emit(G::SQRT, value(base)));
+        } else if (free_symbols(*exp).empty()) {
+            result_ = emit(G::POW, value(base), 0, eval_double(*exp));
+        } else {
+            // base**exp = exp(exp*log(base))
+            unsigned l = emit(G::LOG, value(base));
+            result_ = emit(G::EXP, emit(G::MUL, l, value(exp)));
+        }
+    }
+
+#define SYMENGINE_GRADIENT_UNARY(Class, op)                                    \
+    void bvisit(const Class &x)                                                \
+    {                                                                          \
+        result_ = emit(op, value(x.get_args()[0]));                            \
+    }
+#define SYMENGINE_GRADIENT_INV_UNARY(Class, op)                                \
+    void bvisit(const Class &x)                                                \
+    {                                                                          \
+        result_ = emit(G::INV, emit(op, value(x.get_args()[0])));              \
+    }
+#define SYMENGINE_GRADIENT_UNARY_INV(Class, op)                                \
+    void bvisit(const Class &x)                                                \
+    {                                                                          \
+        result_ = emit(op, emit(G::INV, value(x.get_args()[0])));              \
+    }
+
+    SYMENGINE_GRADIENT_UNARY(Log, G::LOG)
+    SYMENGINE_GRADIENT_UNARY(Sin, G::SIN)
+    SYMENGINE_GRADIENT_UNARY(Cos, G::COS)
+    SYMENGINE_GRADIENT_UNARY(Tan, G::TAN)
+    SYMENGINE_GRADIENT_INV_UNARY(Cot, G::TAN)
+    SYMENGINE_GRADIENT_INV_UNARY(Csc, G::SIN)
+    SYMENGINE_GRADIENT_INV_UNARY(Sec, G::COS)
+    SYMENGINE_GRADIENT_UNARY(ASin, G::ASIN)
+    SYMENGINE_GRADIENT_UNARY(ACos, G::ACOS)
+    SYMENGINE_GRADIENT_UNARY(ATan, G::ATAN)
+    SYMENGINE_GRADIENT_UNARY_INV(ACot, G::ATAN)
+    SYMENGINE_GRADIENT_UNARY_INV(ASec, G::ACOS)
+    SYMENGINE_GRADIENT_UNARY_INV(ACsc, G::ASIN)
+    SYMENGINE_GRADIENT_UNARY(Sinh, G::SINH)
+    SYMENGINE_GRADIENT_UNARY(Cosh, G::COSH)
+    SYMENGINE_GRADIENT_UNARY(Tanh, G::TANH)
+    SYMENGINE_GRADIENT_INV_UNARY(Coth, G::TANH)
+    SYMENGINE_GRADIENT_INV_UNARY(Csch, G::SINH)
+    SYMENGINE_GRADIENT_INV_UNARY(Sech, G::COSH)
+    SYMENGINE_GRADIENT_UNARY(ASinh, G::ASINH)
+    SYMENGINE_GRADIENT_UNARY(ACosh, G::ACOSH)
+    SYMENGINE_GRADIENT_UNARY(ATanh, G::ATANH)
+    SYMENGINE_GRADIENT_UNARY_INV(ACoth, G::ATANH)
+    SYMENGINE_GRADIENT_UNARY_INV(ACsch, G::ASINH)
+    SYMENGINE_GRADIENT_UNARY_INV(ASech, G::ACOSH)
+    SYMENGINE_GRADIENT_UNARY(Abs, G::ABS)
+    SYMENGINE_GRADIENT_UNARY(Erf, G::ERF)
+    SYMENGINE_GRADIENT_UNARY(Gamma, G::GAMMA)
+    SYMENGINE_GRADIENT_UNARY(LogGamma, G::LOGGAMMA)
+
+#undef SYMENGINE_GRADIENT_UNARY
+#undef SYMENGINE_GRADIENT_INV_UNARY
+#undef SYMENGINE_GRADIENT_UNARY_INV
+
+    void bvisit(const ATan2 &x)
+    {
+        result_ = emit(G::ATAN2, value(x.get_num()), value(x.get_den()));
+    }
+
+    void bvisit(const Max &x)
+    {
+        result_ = fold(G::MAX, x.get_args());
+    }
+
+    void bvisit(const Min &x)
+    {
+        result_ = fold(G::MIN, x.get_args());
+    }
+
+private:
+    unsigned fold(G::Op op, const vec_basic &args)
+    {
+        unsigned r = value(args[0]);
+        for (size_t i = 1; i < args.size(); i++)
+            r = emit(op, r, value(args[i]));
+        return r;
+    }
+};
+
+//! \return `x**n`
+double powi(double x, long n)
+{
+    unsigned long m = n < 0 ? -(unsigned long)n : n;
+    double r;
+    if (m == 0)
+        r = 1;
+    else if (m <= DoublePower::max_chain)
+        r = DoublePower::chain(x, m);
+    else
+        r = std::pow(x, double(m));
+    return n < 0 ? 1 / r : r;
+}
+
+} // anonymous namespace
+
+std::vector<unsigned> LambdaDoubleTape::compile(const vec_basic &x,
+                                                const vec_basic &outputs)
+{
+    GradientCompiler compiler(x);
+    std::vector<unsigned> r;
+    for (const auto &p : outputs)
+        r.push_back(compiler.value(p));
+    nsymbols_ = x.size();
+    values_.assign(compiler.values_.size(), 0.0);
+    for (size_t v = 0; v < values_.size(); v++) {
+        if (compiler.values_[v].kind == GradientCompiler::CONST)
+            values_[v] = compiler.consts_[compiler.values_[v].index];
+    }
+    tape_ = std::move(compiler.code_);
+    return r;
+}
+
+std::vector<double>
+LambdaDoubleTape::forward(const std::vector<double> &x) const
+{
+    if (x.size() != nsymbols_)
+        throw std::runtime_error("Wrong number of values.");
+    std::vector<double> v(values_);
+    std::copy(x.begin(), x.end(), v.begin());
+    for (const Instruction &o : tape_) {
+        double a = v[o.a], b = v[o.b], r = 0;
+        switch (o.op) {
+            case ADD:
+                r = a + b;
+                break;
+            case MUL:
+                r = a * b;
+                break;
+            case SCALE:
+                r = o.c * a;
+                break;
+            case INV:
+                r = 1 / a;
+                break;
+            case POWI:
+                r = powi(a, long(o.c));
+                break;
+            case POW:
+                r = std::pow(a, o.c);
+                break;
+            case SQRT:
+                r = std::sqrt(a);
+                break;
+            case EXP:
+                r = std::exp(a);
+                break;
+            case LOG:
+                r = std::log(a);
+                break;
+            case SIN:
+                r = std::sin(a);
+                break;
+            case COS:
+                r = std::cos(a);
+                break;
+            case TAN:
+                r = std::tan(a);
+                break;
+            case ASIN:
+                r = std::asin(a);
+                break;
+            case ACOS:
+                r = std::acos(a);
+                break;
+            case ATAN:
+                r = std::atan(a);
+                break;
+            case ATAN2:
+                r = std::atan2(a, b);
+                break;
+            case SINH:
+                r = std::sinh(a);
+                break;
+            case COSH:
+                r = std::cosh(a);
+                break;
+            case TANH:
+                r = std::tanh(a);
+                break;
+            case ASINH:
+                r = std::asinh(a);
+                break;
+            case ACOSH:
+                r = std::acosh(a);
+                break;
+            case ATANH:
+                r = std::atanh(a);
+                break;
+            case ABS:
+                r = std::fabs(a);
+                break;
+            case ERF:
+                r = std::erf(a);
+                break;
+            case GAMMA:
+                r = std::tgamma(a);
+                break;
+            case LOGGAMMA:
+                r = std::lgamma(a);
+                break;
+            case MAX:
+                r = std::max(a, b);
+                break;
+            case MIN:
+                r = std::min(a, b);
+                break;
+        }
+        v[o.dst] = r;
+    }
+    return v;
+}
+
+void LambdaDoubleTape::partials(const Instruction &o,
+                                const std::vector<double> &v, double &da,
+                                double &db)
+{
+    double a = v[o.a], b = v[o.b], r = v[o.dst];
+    db = 0;
+    switch (o.op) {
+        case ADD:
+            da = 1;
+            db = 1;
+            break;
+        case MUL:
+            da = b;
+            db = a;
+            break;
+        case SCALE:
+            da = o.c;
+            break;
+        case INV:
+            da = -r * r;
+            break;
+        case POWI:
+            da = o.c * powi(a, long(o.c) - 1);
+            break;
+        case POW:
+            da = o.c * std::pow(a, o.c - 1);
+            break;
+        case SQRT:
+            da = 0.5 / r;
+            break;
+        case EXP:
+            da = r;
+            break;
+        case LOG:
+            da = 1 / a;
+            break;
+        case SIN:
+            da = std::cos(a);
+            break;
+        case COS:
+            da = -std::sin(a);
+            break;
+        case TAN:
+            da = 1 + r * r;
+            break;
+        case ASIN:
+            da = 1 / std::sqrt(1 - a * a);
+            break;
+        case ACOS:
+            da = -1 / std::sqrt(1 - a * a);
+            break;
+        case ATAN:
+            da = 1 / (1 + a * a);
+            break;
+        case ATAN2: {
+            double h = 1 / (a * a + b * b);
+            da = h * b;
+            db = -h * a;
+            break;
+        }
+        case SINH:
+            da = std::cosh(a);
+            break;
+        case COSH:
+            da = std::sinh(a);
+            break;
+        case TANH:
+            da = 1 - r * r;
+            break;
+        case ASINH:
+            da = 1 / std::sqrt(a * a + 1);
+            break;
+        case ACOSH:
+            da = 1 / std::sqrt(a * a - 1);
+            break;
+        case ATANH:
+            da = 1 / (1 - a * a);
+            break;
+        case ABS:
+            da = a > 0 ? 1 : (a < 0 ? -1 : 0);
+            break;
+        case ERF:
+            // 2/sqrt(pi)*exp(-a**2)
+            da = 1.1283791670955126 * std::exp(-a * a);
+            break;
+        case GAMMA:
+            da = r * polygamma(0.0, a);
+            break;
+        case LOGGAMMA:
+            da = polygamma(0.0, a);
+            break;
+        case MAX:
+        case MIN:
+            da = a == r ? 1 : 0;
+            db = 1 - da;
+            break;
+    }
+}
+
+void LambdaRealDoubleGradient::init(const vec_basic &x, const Basic &b)
+{
+    result_ = compile(x, {b.rcp_from_this()})[0];
+}
+
+double LambdaRealDoubleGradient::call(const std::vector<double> &x) const
+{
+    return forward(x)[result_];
+}
+
+double LambdaRealDoubleGradient::call(const std::vector<double> &x,
+                                      std::vector<double> &grad) const
+{
+    std::vector<double> v = forward(x);
+    // d[i] is the derivative of the result with respect to v[i]
+    std::vector<double> d(v.size(), 0.0);
+    d[result_] = 1;
+    for (auto it = tape_.rbegin(); it != tape_.rend(); ++it) {
+        double g = d[it->dst];
+        if (g == 0)
+            continue;
+        double da, db;
+        partials(*it, v, da, db);
+        d[it->a] += g * da;
+        if (is_binary(it->op))
+            d[it->b] += g * db;
+    }
+    grad.assign(d.begin(), d.begin() + nsymbols_);
+    return v[result_];
+}
+
+void LambdaRealDoubleJVP::init(const vec_basic &x, const vec_basic &outputs)
+{
+    outputs_ = compile(x, outputs);
+}
+
+void LambdaRealDoubleJVP::call(const std::vector<double> &x,
+                               const std::vector<double> &v,
+                               std::vector<double> &f,
+                               std::vector<double> &jv) const
+{
+    std::vector<double> values = forward(x);
+    std::size_t n = nsymbols_, m = outputs_.size();
+    std::size_t k = n == 0 ? 0 : v.size() / n;
+    if (k * n != v.size())
+        throw std::runtime_error("Wrong number of values.");
+    // t[i*k + l] is the derivative of values[i] along the l-th vector
+    std::vector<double> t(values.size() * k, 0.0);
+    for (std::size_t i = 0; i < n; i++)
+        for (std::size_t l = 0; l < k; l++)
+            t[i * k + l] = v[l * n + i];
+    for (const Instruction &o : tape_) {
+        double da, db;
+        partials(o, values, da, db);
+        double *r = &t[o.dst * k];
+        const double *a = &t[o.a * k], *b = &t[o.b * k];
+        if (is_binary(o.op)) {
+            for (std::size_t l = 0; l < k; l++)
+                r[l] = da * a[l] + db * b[l];
+        } else {
+            for (std::size_t l = 0; l < k; l++)
+                r[l] = da * a[l];
+        }
+    }
+    f.resize(m);
+    jv.resize(m * k);
+    for (std::size_t j = 0; j < m; j++) {
+        f[j] = values[outputs_[j]];
+        for (std::size_t l = 0; l < k; l++)
+            jv[l * m + j] = t[outputs_[j] * k + l];
+    }
+}
+
+} // SymEngine
@@ -0,0 +1,133 @@
+/**
+ *  \file lambda_gradient.h
+ *  Evaluation of expressions and their derivatives
+ *
+ **/
+#ifndef SYMENGINE_LAMBDA_GRADIENT_H
+#define SYMENGINE_LAMBDA_GRADIENT_H
+
+#include <symengine/basic.h>
+
+namespace SymEngine
+{
+
+//! Tape of the operations computing expressions in double precision, from
+//! which their derivatives are computed. Every subexpression is computed
+//! once and the subexpressions without symbols are folded to constants.
+class LambdaDoubleTape
+{
+public:
+    //! \return the number of operations on the tape
+    std::size_t size() const
+    {
+        return tape_.size();
+    }
+
+    enum Op {
+        ADD,
+        MUL,
+        SCALE, // multiplication by a constant
+        INV,
+        POWI, // integer power
+        POW,
+        SQRT,
+        EXP,
+        LOG,
+        SIN,
+        COS,
+        TAN,
+        ASIN,
+        ACOS,
+        ATAN,
+        ATAN2,
+        SINH,
+        COSH,
+        TANH,
+        ASINH,
+        ACOSH,
+        ATANH,
+        ABS,
+        ERF,
+        GAMMA,
+        LOGGAMMA,
+        MAX,
+        MIN,
+    };
+
+    //! Stores `op(values[a], values[b])` in `values[dst]`. The symbols are
+    //! the first values, followed by the constants and the results in the
+    //! order they were compiled.
+    struct Instruction {
+        Op op;
+        unsigned dst, a, b;
+        double c;
+    };
+
+protected:
+    unsigned nsymbols_ = 0;
+    //! the constants at their positions, the other values are overwritten
+    std::vector<double> values_;
+    std::vector<Instruction> tape_;
+
+    //! Compiles `outputs` as functions of the symbols `x`. Throws
+    //! `std::runtime_error` for unsupported expressions.
+    //! \return the positions of the outputs in the values
+    std::vector<unsigned> compile(const vec_basic &x, const vec_basic &outputs);
+
+    //! \return the values of the tape at `x`
+    std::vector<double> forward(const std::vector<double> &x) const;
+
+    //! \return true if `op` depends on its operand `b`
+    static bool is_binary(Op op)
+    {
+        return op == ADD or op == MUL or op == ATAN2 or op == MAX or op == MIN;
+    }
+
+    //! Stores the derivatives of `o` with respect to its operands in `da`
+    //! and `db`, given the values `v` computed by forward()
+    static void partials(const Instruction &o, const std::vector<double> &v,
+                         double &da, double &db);
+};
+
+//! Evaluates an expression and its gradient with reverse mode automatic
+//! differentiation: a call runs the tape forward to compute the value of
+//! every operation and then backward to accumulate the partial derivatives,
+//! so that the whole gradient costs a small multiple of one evaluation,
+//! independently of the number of symbols.
+class LambdaRealDoubleGradient : public LambdaDoubleTape
+{
+public:
+    void init(const vec_basic &x, const Basic &b);
+
+    //! \return the value at `x` and stores the gradient in `grad`
+    double call(const std::vector<double> &x, std::vector<double> &grad) const;
+
+    //! \return the value at `x`, without the gradient
+    double call(const std::vector<double> &x) const;
+
+private:
+    unsigned result_ = 0;
+};
+
+//! Evaluates a vector of expressions and the products of their Jacobian with
+//! vectors in forward mode, without forming the Jacobian. The tangents are
+//! carried through the tape along with the values, for several vectors at
+//! once.
+class LambdaRealDoubleJVP : public LambdaDoubleTape
+{
+public:
+    void init(const vec_basic &x, const vec_basic &outputs);
+
+    //! Stores the values of the outputs at `x` in `f` and the products of
+    //! the Jacobian with the `k = v.size()/x.size()` vectors stored one
+    //! after another in `v` in `jv`, also one after another
+    void call(const std::vector<double> &x, const std::vector<double> &v,
+              std::vector<double> &f, std::vector<double> &jv) const;
+
+private:
+    std::vector<unsigned> outputs_;
+};
+
+} // SymEngine
+
+#endif
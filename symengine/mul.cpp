@@ -14,6 +14,7 @@ Mul::Mul(const RCP<const Number> &coef, map_basic_basic &&dict)
     : coef_{coef}, dict_{std::move(dict)}
 {
     SYMENGINE_ASSERT(is_canonical(coef, dict_))
+    hash();
 }
 
 bool Mul::is_canonical(const RCP<const Number> &coef,
@@ -10,386 +10,462 @@
 #include <symengine/constants.h>
 #include <symengine/visitor.h>
 #include <symengine/parser.h>
-#include <vector>
-#include <stack>
-#include <map>
-#include <set>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <limits>
 #include <string>
-#include <functional>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace SymEngine
 {
 
-class ExpressionParser
+namespace
 {
 
-    // OPERATORS and op_precedence used internally, for parsing
-    std::set<char> OPERATORS = {'-', '+', '*', '/', '^', '(', ')', ','};
-    std::map<char, int> op_precedence = {{')', 0}, {',', 0}, {'-', 1}, {'+', 1},
-                                         {'*', 3}, {'/', 4}, {'^', 5}};
-    // symengine supported constants
-    std::map<const std::string, const RCP<const Basic>> constants = {
-
-        {"e", E}, {"E", E}, {"EulerGamma", EulerGamma}, {"pi", pi}, {"I", I}};
-
-    // reference :
-    // http://stackoverflow.com/questions/30393285/stdfunction-fails-to-distinguish-overloaded-functions
-    typedef RCP<const Basic> (*single_arg_func)(const RCP<const Basic> &);
-    typedef RCP<const Basic> (*double_arg_func)(const RCP<const Basic> &,
-                                                const RCP<const Basic> &);
-
-    // cast overlaoded functions below to single_arg, double_arg before they can
-    // be used in the map
-    single_arg_func single_casted_log = log;
-    single_arg_func single_casted_zeta = zeta;
-
-    double_arg_func double_casted_log = log;
-    double_arg_func double_casted_zeta = zeta;
-
-    // maps string to corresponding single argument function
-    std::map<std::string,
-             std::function<RCP<const Basic>(const RCP<const Basic> &)>>
-        single_arg_functions = {
-
-            {"", [](const RCP<const Basic> &x) {return x; }},
-
-            {"sin", sin},
-            {"cos", cos},
-            {"tan", tan},
-            {"cot", cot},
-            {"csc", csc},
-            {"sec", sec},
-
-            {"asin", asin},
-            {"acos", acos},
-            {"atan", atan},
-            {"asec", asec},
-            {"acsc", acsc},
-            {"acot", acot},
-
-            {"sinh", sinh},
-            {"cosh", cosh},
-            {"tanh", tanh},
-            {"coth", coth},
-            {"sech", sech},
-            {"csch", csch},
-
-            {"asinh", asinh},
-            {"acosh", acosh},
-            {"atanh", atanh},
-            {"asech", asech},
-            {"acoth", acoth},
-            {"acsch", acsch},
-
-            {"gamma", gamma},
-            {"sqrt", sqrt},
-            {"abs", abs},
-            {"exp", exp},
-            {"erf", erf},
-            {"loggamma", loggamma},
-            {"lambertw", lambertw},
-            {"dirichlet_eta", dirichlet_eta},
-            {"ln", single_casted_log},
-            {"log", single_casted_log},
-            {"zeta", single_casted_zeta}};
-
-    // maps string to corresponding double argument function
-    std::map<std::string,
-             std::function<RCP<const Basic>(const RCP<const Basic> &,
-                                            const RCP<const Basic> &)>>
-        double_arg_functions = {
-
-            {"pow", pow},
-            {"beta", beta},
-            {"log", double_casted_log},
-            {"zeta", double_casted_zeta},
-            {"lowergamma", lowergamma},
-            {"uppergamma", uppergamma},
-            {"polygamma", polygamma},
-            {"kronecker_delta", kronecker_delta}};
-
-    // maps string to corresponding multi argument function
-    std::map<std::string, std::function<RCP<const Basic>(vec_basic &)>>
-        multi_arg_functions = {
-
-            {"max", max}, {"min", min}, {"levi_civita", levi_civita}};
-
-    // vector which stores where parsing 'ends' for a particular index
-    // eg. for a '(', it stores where the next ',' or ')' occurs, so as to know
-    // what part of the string is to be parsed 'together'
-    std::vector<int> operator_end;
-
-    // the string to be parsed, obtained after removing all spaces from input
-    // string
-    std::string s;
-    // it's length
-    unsigned int s_len;
-
-    // parses a string from [l, r)
-    RCP<const Basic> parse_string(unsigned int l, unsigned int h)
-    {
-        // the result of a particular parse from l->h
-        RCP<const Basic> result;
-        // the current expr being processed
-        std::string expr = "";
-        // has the result been set even once?
-        bool result_set = false;
-        // is the current expr being parsed numeric?
-        bool is_not_numeric = false;
-        // number of '.' in the expression
-        int num_dots = 0;
-
-        // a parse_string is called empty in scenarios like "x+"
-        if (l == h)
-            throw std::runtime_error("Expected token!");
-
-        for (unsigned int iter = l; iter < h; ++iter) {
-            if (is_operator(iter)) {
-                // if an operator is encountered, which is not '(' a result must
-                // be evaluated (if not already)!
-                if (!result_set)
-                    if (s[iter] != '(')
-                        result = set_result(expr, is_not_numeric, num_dots);
-
-                // continue the parsing after operator_end[iter], as we have
-                // already parsed till there
-                // using the recursive call to parse_string
-                if (s[iter] == '+') {
-                    result = add(result,
-                                 parse_string(iter + 1, operator_end[iter]));
-                    iter = operator_end[iter] - 1;
+typedef RCP<const Basic> (*single_arg_func)(const RCP<const Basic> &);
+typedef RCP<const Basic> (*double_arg_func)(const RCP<const Basic> &,
+                                            const RCP<const Basic> &);
+typedef RCP<const Basic> (*multi_arg_func)(const vec_basic &);
+
+// A function known to the parser, with the implementations for the numbers
+// of arguments it accepts (or nullptr)
+struct ParserFunction {
+    const char *name;
+    single_arg_func single;
+    double_arg_func double_;
+    multi_arg_func multi;
+};
 
-                } else if (s[iter] == '*') {
-                    result = mul(result,
-                                 parse_string(iter + 1, operator_end[iter]));
-                    iter = operator_end[iter] - 1;
+// Sorted by name, so that it can be searched by bisection
+const ParserFunction parser_functions[] = {
+    {"abs", abs, nullptr, nullptr},
+    {"acos", acos, nullptr, nullptr},
+    {"acosh", acosh, nullptr, nullptr},
+    {"acot", acot, nullptr, nullptr},
+    {"acoth", acoth, nullptr, nullptr},
+    {"acsc", acsc, nullptr, nullptr},
+    {"acsch", acsch, nullptr, nullptr},
+    {"asec", asec, nullptr, nullptr},
+    {"asech", asech, nullptr, nullptr},
+    {"asin", asin, nullptr, nullptr},
+    {"asinh", asinh, nullptr, nullptr},
+    {"atan", atan, nullptr, nullptr},
+    {"atanh", atanh, nullptr, nullptr},
+    {"beta", nullptr, beta, nullptr},
+    {"cos", cos, nullptr, nullptr},
+    {"cosh", cosh, nullptr, nullptr},
+    {"cot", cot, nullptr, nullptr},
+    {"coth", coth, nullptr, nullptr},
+    {"csc", csc, nullptr, nullptr},
+    {"csch", csch, nullptr, nullptr},
+    {"dirichlet_eta", dirichlet_eta, nullptr, nullptr},
+    {"erf", erf, nullptr, nullptr},
+    {"exp", exp, nullptr, nullptr},
+    {"gamma", gamma, nullptr, nullptr},
+    {"kronecker_delta", nullptr, kronecker_delta, nullptr},
+    {"lambertw", lambertw, nullptr, nullptr},
+    {"levi_civita", nullptr, nullptr, levi_civita},
+    {"ln", log, nullptr, nullptr},
+    {"log", log, log, nullptr},
+    {"loggamma", loggamma, nullptr, nullptr},
+    {"lowergamma", nullptr, lowergamma, nullptr},
+    {"max", nullptr, nullptr, max},
+    {"min", nullptr, nullptr, min},
+    {"polygamma", nullptr, polygamma, nullptr},
+    {"pow", nullptr, pow, nullptr},
+    {"sec", sec, nullptr, nullptr},
+    {"sech", sech, nullptr, nullptr},
+    {"sin", sin, nullptr, nullptr},
+    {"sinh", sinh, nullptr, nullptr},
+    {"sqrt", sqrt, nullptr, nullptr},
+    {"tan", tan, nullptr, nullptr},
+    {"tanh", tanh, nullptr, nullptr},
+    {"uppergamma", nullptr, uppergamma, nullptr},
+    {"zeta", zeta, zeta, nullptr},
+};
 
-                } else if (s[iter] == '-') {
-                    result = sub(result,
-                                 parse_string(iter + 1, operator_end[iter]));
-                    iter = operator_end[iter] - 1;
+// Compares the token `[first, last)` with the null terminated `name`
+int compare_name(const char *first, const char *last, const char *name)
+{
+    for (; first != last and *name != '\0'; ++first, ++name) {
+        if (*first != *name)
+            return (*first < *name) ? -1 : 1;
+    }
+    if (first != last)
+        return 1;
+    return (*name == '\0') ? 0 : -1;
+}
 
-                } else if (s[iter] == '/') {
-                    result = div(result,
-                                 parse_string(iter + 1, operator_end[iter]));
-                    iter = operator_end[iter] - 1;
+const ParserFunction *find_function(const char *first, const char *last)
+{
+    const ParserFunction *begin = parser_functions;
+    const ParserFunction *end
+        = parser_functions
+          + sizeof(parser_functions) / sizeof(parser_functions[0]);
+    const ParserFunction *it = std::lower_bound(
+        begin, end, 0, [first, last](const ParserFunction &f, int) {
+            return compare_name(first, last, f.name) > 0;
+        });
+    if (it != end and compare_name(first, last, it->name) == 0)
+        return it;
+    return nullptr;
+}
 
-                } else if (s[iter] == '^') {
-                    result = pow(result,
-                                 parse_string(iter + 1, operator_end[iter]));
-                    iter = operator_end[iter] - 1;
+// symengine supported constants
+bool find_constant(const char *first, const char *last, RCP<const Basic> &c)
+{
+    if (compare_name(first, last, "E") == 0
+        or compare_name(first, last, "e") == 0)
+        c = E;
+    else if (compare_name(first, last, "pi") == 0)
+        c = pi;
+    else if (compare_name(first, last, "I") == 0)
+        c = I;
+    else if (compare_name(first, last, "EulerGamma") == 0)
+        c = EulerGamma;
+    else
+        return false;
+    return true;
+}
 
-                } else if (s[iter] == '(') {
-                    result = functionify(iter, expr);
+bool is_operator(char c)
+{
+    return c != '\0' and std::strchr("-+*/^(),", c) != nullptr;
+}
 
-                } else {
-                    continue;
-                }
-                // result has definitely been set
-                result_set = true;
+bool is_space(char c)
+{
+    return c == ' ' or c == '\t' or c == '\n' or c == '\r';
+}
+}
 
-            } else {
-                // if not an operator, we append it to the current expr
-                expr += s[iter];
-                // check wether it's numeric or not
-                if (s[iter] == '.') {
-                    num_dots++;
+void ExpressionParser::error(const char *msg, const char *where) const
+{
+    throw std::runtime_error(std::string(msg) + " at position "
+                             + std::to_string(where - begin_) + "!");
+}
 
-                } else {
-                    int ascii = s[iter] - '0';
-                    if (ascii < 0 or ascii > 9)
-                        is_not_numeric = true;
-                }
-                // if the parsing was to finish after this, result must be set
-                // occurs when no operator present eg. "3"
-                if (iter == h - 1)
-                    result = set_result(expr, is_not_numeric, num_dots);
-            }
+// reads the next token, `**` is read as `^`
+void ExpressionParser::next()
+{
+    while (pos_ != end_ and is_space(*pos_))
+        ++pos_;
+    tok_ = pos_;
+    if (pos_ == end_) {
+        kind_ = END;
+    } else if (is_operator(*pos_)) {
+        kind_ = OPERATOR;
+        if (*pos_ == '*' and pos_ + 1 != end_ and pos_[1] == '*')
+            ++pos_;
+        ++pos_;
+    } else {
+        // names and numbers run up to the next operator or space
+        bool numeric = true;
+        for (; pos_ != end_ and not is_operator(*pos_)
+               and not is_space(*pos_);
+             ++pos_) {
+            if ((*pos_ < '0' or *pos_ > '9') and *pos_ != '.')
+                numeric = false;
         }
-
-        return result;
+        kind_ = numeric ? NUMBER : NAME;
     }
+    tok_end_ = pos_;
+}
 
-    // returns true if the s[iter] is an operator
-    bool is_operator(int iter)
-    {
-        if (iter >= 0 and iter < (int)s_len)
-            if (OPERATORS.find(s[iter]) != OPERATORS.end())
-                return true;
-        return false;
+char ExpressionParser::op() const
+{
+    if (kind_ != OPERATOR)
+        return '\0';
+    return (tok_end_ - tok_ == 2) ? '^' : *tok_;
+}
+
+void ExpressionParser::expect(char c)
+{
+    if (op() != c) {
+        if (c == ')')
+            error("Mismatching parantheses", tok_);
+        error("Unexpected token", tok_);
     }
+    next();
+}
 
-    // is called on detecting a "func(", thus "func" must be a type of
-    // function and everything inside arguments of the function
-    RCP<const Basic> functionify(unsigned int &iter, const std::string &expr)
-    {
-        vec_basic params;
+// sum := ['-' | '+'] product (('+' | '-') product)*
+// A leading sign is only accepted at the start of the input, or after '('
+// or ','.
+RCP<const Basic> ExpressionParser::parse_sum()
+{
+    vec_basic terms;
+    bool negate = false;
+    if (op() == '-' or op() == '+') {
+        negate = (op() == '-');
+        next();
+    }
+    terms.push_back(parse_product(negate));
+    while (op() == '+' or op() == '-') {
+        negate = (op() == '-');
+        next();
+        terms.push_back(parse_product(negate));
+    }
+    if (terms.size() == 1)
+        return terms[0];
+    return add(terms);
+}
 
-        while (s[iter] != ')') {
-            params.push_back(parse_string(iter + 1, operator_end[iter]));
-            iter = operator_end[iter];
+// product := power (('*' | '/') power)*
+RCP<const Basic> ExpressionParser::parse_product(bool negate)
+{
+    vec_basic factors;
+    if (negate)
+        factors.push_back(minus_one);
+    factors.push_back(parse_power());
+    while (op() == '*' or op() == '/') {
+        bool divide = (op() == '/');
+        next();
+        RCP<const Basic> f = parse_power();
+        if (divide) {
+            if (is_a_Number(*f)
+                and rcp_static_cast<const Number>(f)->is_zero())
+                throw std::runtime_error("div: Division by zero");
+            f = pow(f, minus_one);
         }
+        factors.push_back(f);
+    }
+    if (factors.size() == 1)
+        return factors[0];
+    return mul(factors);
+}
 
-        if (params.size() == 1)
-            if (single_arg_functions.find(expr) != single_arg_functions.end())
-                return single_arg_functions[expr](params[0]);
-
-        if (params.size() == 2)
-            if (double_arg_functions.find(expr) != double_arg_functions.end())
-                return double_arg_functions[expr](params[0], params[1]);
-
-        if (multi_arg_functions.find(expr) != multi_arg_functions.end())
-            return multi_arg_functions[expr](params);
+// power := primary ['^' power]
+RCP<const Basic> ExpressionParser::parse_power()
+{
+    RCP<const Basic> base = parse_primary();
+    if (op() != '^')
+        return base;
+    next();
+    return pow(base, parse_power());
+}
 
-        return function_symbol(expr, params);
+// primary := number | name | name '(' args ')' | '(' sum ')'
+RCP<const Basic> ExpressionParser::parse_primary()
+{
+    const char *first = tok_, *last = tok_end_;
+    if (kind_ == NUMBER) {
+        next();
+        return parse_number(first, last);
     }
+    if (kind_ == NAME) {
+        next();
+        if (op() == '(')
+            return parse_call(first, last);
+        return parse_name(first, last);
+    }
+    if (op() == '(') {
+        next();
+        RCP<const Basic> r = parse_sum();
+        expect(')');
+        return r;
+    }
+    if (kind_ == END)
+        error("Expected token", tok_);
+    error("Unexpected token", tok_);
+    return zero;
+}
 
-    // return a <Basic> by parsing the 'expr' passed from parse_string
-    RCP<const Basic> set_result(const std::string &expr,
-                                const bool &is_not_numeric, const int &num_dots)
-    {
-        // for handling cases like "-2"
-        // expr will be "" in this case, but we must return 0
-        if (expr == "")
-            return zero;
-
-        // if the expr wasn't numeric, it's either a constant, or a user
-        // declared symbol
-        // otherwise it's an integer (yet to add float/double support)
-        if (is_not_numeric) {
-            if (constants.find(expr) != constants.end())
-                return constants[expr];
-            return symbol(expr);
+RCP<const Basic> ExpressionParser::parse_call(const char *first,
+                                              const char *last)
+{
+    vec_basic params;
+    next();
+    params.push_back(parse_sum());
+    while (op() == ',') {
+        next();
+        params.push_back(parse_sum());
+    }
+    expect(')');
+
+    const ParserFunction *f = find_function(first, last);
+    if (f != nullptr) {
+        if (params.size() == 1 and f->single != nullptr)
+            return f->single(params[0]);
+        if (params.size() == 2 and f->double_ != nullptr)
+            return f->double_(params[0], params[1]);
+        if (f->multi != nullptr)
+            return f->multi(params);
+    }
+    return function_symbol(std::string(first, last), params);
+}
 
-        } else {
-            if (num_dots > 1) {
-                throw std::runtime_error("Invalid symbol or number!");
+RCP<const Basic> ExpressionParser::parse_number(const char *first,
+                                                const char *last)
+{
+    const char *dot = std::find(first, last, '.');
+    if (dot != last) {
+        if (std::find(dot + 1, last, '.') != last)
+            error("Invalid symbol or number", first);
+        return real_double(std::atof(std::string(first, last).c_str()));
+    }
+    if (last - first <= std::numeric_limits<long>::digits10) {
+        long n = 0;
+        for (const char *c = first; c != last; ++c)
+            n = 10 * n + (*c - '0');
+        return integer(integer_class(n));
+    }
+    return integer(integer_class(std::string(first, last).c_str()));
+}
 
-            } else if (num_dots == 1) {
-                return real_double(std::atof(expr.c_str()));
+RCP<const Basic> ExpressionParser::parse_name(const char *first,
+                                              const char *last)
+{
+    RCP<const Basic> c;
+    if (find_constant(first, last, c))
+        return c;
+    // Models repeat the same few names many times, so create every symbol
+    // once and share it
+    std::string name(first, last);
+    auto it = symbols_.find(name);
+    if (it != symbols_.end())
+        return it->second;
+    c = symbol(name);
+    symbols_.insert(std::make_pair(std::move(name), c));
+    return c;
+}
 
-            } else {
-                return integer(std::atoi(expr.c_str()));
-            }
-        }
+RCP<const Basic> ExpressionParser::parse(const char *first, const char *last)
+{
+    begin_ = pos_ = first;
+    end_ = last;
+    next();
+    RCP<const Basic> r = parse_sum();
+    if (kind_ != END) {
+        if (op() == ')')
+            error("Mismatching parantheses", tok_);
+        error("Unexpected token", tok_);
     }
+    return r;
+}
 
-    bool operator_error(char prev, char current)
-    {
-        if (prev == '(') {
-            if (current == ')')
-                return true;
-
-        } else if (prev == '-') {
-            if (current != '(' and current != ',' and current != ')')
-                return true;
+RCP<const Basic> parse(const std::string &s)
+{
+    ExpressionParser p;
+    return p.parse(s);
+}
 
-        } else {
-            if (current != ')')
-                return true;
+vec_basic parse_many(const char *first, const char *last,
+                     unsigned int nthreads)
+{
+    // Split at the separators first, so that the expressions can be handed
+    // out to the threads independently
+    std::vector<std::pair<const char *, const char *>> exprs;
+    const char *start = first;
+    for (const char *c = first; c != last; ++c) {
+        if (*c == '\n' or *c == ';') {
+            exprs.push_back(std::make_pair(start, c));
+            start = c + 1;
         }
-        return false;
     }
-
-public:
-    // does all the preprocessing related to parsing
-    RCP<const Basic> parse_expr(const std::string &in)
+    exprs.push_back(std::make_pair(start, last));
+    exprs.erase(std::remove_if(exprs.begin(), exprs.end(),
+                               [](const std::pair<const char *,
+                                                  const char *> &e) {
+                                   return std::all_of(e.first, e.second,
+                                                      is_space);
+                               }),
+                exprs.end());
+
+    if (nthreads == 0) {
+#ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+#else
+        nthreads = 1;
+#endif
+    }
+    int n = exprs.size();
+    vec_basic result(n);
+    // Exceptions must not leave the parallel region, remember the first one
+    int failed = n;
+    std::exception_ptr error;
+#pragma omp parallel num_threads(nthreads)
     {
-        // stack to maintain right brackets, to match with corresponding left
-        // brackets
-        std::stack<unsigned int> right_bracket;
-        // stack to maintain operators, in order of their precedence
-        // (essentially how BODMAS was implemented)
-        std::stack<std::pair<int, unsigned int>> op_stack;
-
-        bool last_char_was_op = false;
-        char last_char = 'x';
-        s = "";
-
-        // removing spaces from the string
-        for (unsigned int i = 0; i < in.length(); ++i) {
-            if (in[i] == ' ') {
-                continue;
-
-            } else if (in[i] == '*' and i + 1 < in.length()
-                       and in[i + 1] == '*') {
-                s += '^';
-                i++;
-
-            } else {
-                s += in[i];
-            }
-        }
-        s_len = s.length();
-        operator_end.clear();
-        operator_end.resize(s_len, -1);
-        // the 'defacto' end of any operator
-        // won't ever be pushed out of the stack
-        op_stack.push(std::make_pair(-1, s_len));
-        right_bracket.push(s_len);
-
-        for (int i = s_len - 1; i >= 0; i--) {
-            if (is_operator(i)) {
-                char x = s[i];
-
-                if (x == '(') {
-                    // find the matching right bracket in op_stack
-                    while (op_stack.top().second != right_bracket.top())
-                        op_stack.pop();
-                    // it's end is the index of the ')' (maybe pseudo created by
-                    // a ',')
-                    operator_end[i] = right_bracket.top();
-
-                    // this should never happen, every '(' should have a
-                    // matcihng ')' in the bracket stack
-                    if (operator_end[i] == (int)s_len)
-                        throw std::runtime_error("Mismatching parantheses!");
-                    right_bracket.pop();
-                    op_stack.pop();
-
-                } else if (x == ')' or x == ',') {
-                    // ',' acts as a pseudo ')', for the intended '('
-                    if (x == ',') {
-                        // it's end is the actual ')'
-                        operator_end[i] = right_bracket.top();
-                        right_bracket.pop();
-                    }
-                    op_stack.push(std::make_pair(op_precedence[x], i));
-                    right_bracket.push(i);
-
-                } else {
-                    // if it's a normal operator, remove operators with higher
-                    // precedence
-                    while (op_precedence[x] < op_stack.top().first)
-                        op_stack.pop();
-                    // whatever is on the top now, it's the 'end'
-                    operator_end[i] = op_stack.top().second;
-                    op_stack.push(std::make_pair(op_precedence[x], i));
+        // Every thread has its own parser, and thus its own symbols
+        ExpressionParser p;
+#pragma omp for schedule(dynamic, 64)
+        for (int i = 0; i < n; i++) {
+            try {
+                result[i] = p.parse(exprs[i].first, exprs[i].second);
+            } catch (...) {
+#pragma omp critical
+                if (i < failed) {
+                    failed = i;
+                    error = std::current_exception();
                 }
-
-                if (last_char_was_op and operator_error(last_char, x))
-                    throw std::runtime_error("Operator inconsistency!");
-                last_char_was_op = true;
-
-            } else {
-                last_char_was_op = false;
             }
-
-            last_char = s[i];
         }
-        // extra right_brackets in the string
-        if (right_bracket.top() != s_len)
-            throw std::runtime_error("Mismatching parantheses!");
-
-        // final answer is parse_string from [0, len)
-        return parse_string(0, s_len);
     }
-};
+    if (error) {
+        // Parse errors get the position of the expression, anything else is
+        // rethrown as is
+        try {
+            std::rethrow_exception(error);
+        } catch (std::runtime_error &e) {
+            throw std::runtime_error("Expression " + std::to_string(failed + 1)
+                                     + ": " + e.what());
+        }
+    }
+    return result;
+}
 
-RCP<const Basic> parse(const std::string &s)
+vec_basic parse_file(const std::string &filename, unsigned int nthreads)
 {
-    ExpressionParser p;
-    return p.parse_expr(s);
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open " + filename);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Cannot read " + filename);
+    }
+    std::size_t size = st.st_size;
+    if (size == 0) {
+        close(fd);
+        return {};
+    }
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        throw std::runtime_error("Cannot read " + filename);
+    const char *first = static_cast<const char *>(data);
+    try {
+        vec_basic result = parse_many(first, first + size, nthreads);
+        munmap(data, size);
+        return result;
+    } catch (...) {
+        munmap(data, size);
+        throw;
+    }
+#else
+    std::ifstream in(filename, std::ios::in | std::ios::binary);
+    if (not in)
+        throw std::runtime_error("Cannot open " + filename);
+    std::string s((std::istreambuf_iterator<char>(in)),
+                  std::istreambuf_iterator<char>());
+    return parse_many(s, nthreads);
+#endif
 }
 
 } // SymEngine
@@ -7,8 +7,63 @@
 namespace SymEngine
 {
 
+//! Parser of expressions like "sin(x) + 2*y**3". A parser can be reused for
+//! many expressions, and symbols with the same name are created only once
+//! per parser.
+class ExpressionParser
+{
+public:
+    //! Parses the expression `[first, last)`
+    RCP<const Basic> parse(const char *first, const char *last);
+    RCP<const Basic> parse(const std::string &s)
+    {
+        return parse(s.data(), s.data() + s.size());
+    }
+
+private:
+    enum TokenKind { END, NAME, NUMBER, OPERATOR };
+
+    // the input and the current position in it
+    const char *begin_;
+    const char *end_;
+    const char *pos_;
+
+    // the current token is `[tok_, tok_end_)`
+    TokenKind kind_;
+    const char *tok_;
+    const char *tok_end_;
+
+    // symbols created so far, by name
+    std::unordered_map<std::string, RCP<const Basic>> symbols_;
+
+    void error(const char *msg, const char *where) const;
+    void next();
+    char op() const;
+    void expect(char c);
+    RCP<const Basic> parse_sum();
+    RCP<const Basic> parse_product(bool negate);
+    RCP<const Basic> parse_power();
+    RCP<const Basic> parse_primary();
+    RCP<const Basic> parse_call(const char *first, const char *last);
+    RCP<const Basic> parse_number(const char *first, const char *last);
+    RCP<const Basic> parse_name(const char *first, const char *last);
+};
+
 RCP<const Basic> parse(const std::string &s);
 
+//! Parses the expressions in `[first, last)` separated by newlines or
+//! semicolons, skipping empty ones. The expressions are divided among
+//! `nthreads` threads (all available OpenMP threads if 0).
+vec_basic parse_many(const char *first, const char *last,
+                     unsigned int nthreads = 0);
+inline vec_basic parse_many(const std::string &s, unsigned int nthreads = 0)
+{
+    return parse_many(s.data(), s.data() + s.size(), nthreads);
+}
+//! Parses the expressions in the file `filename` like `parse_many`. The file
+//! is memory mapped where available.
+vec_basic parse_file(const std::string &filename, unsigned int nthreads = 0);
+
 } // SymEngine
 
-#endif
\ No newline at end of file
+#endif
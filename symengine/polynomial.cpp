@@ -123,18 +123,79 @@ integer_class UnivariateIntPolynomial::max_abs_coef() const
 
 integer_class UnivariateIntPolynomial::eval(const integer_class &x) const
 {
-    unsigned int last_deg = poly_.dict_.rbegin()->first;
     integer_class result(0), x_pow;
+    if (poly_.dict_.empty())
+        return result;
+    unsigned int last_deg = poly_.dict_.rbegin()->first;
 
+    // Horner's scheme, skipping the gaps between the terms with a power
     for (auto it = poly_.dict_.rbegin(); it != poly_.dict_.rend(); ++it) {
+        if (last_deg - it->first == 1) {
+            result *= x;
+        } else if (last_deg != it->first) {
+            mp_pow_ui(x_pow, x, last_deg - it->first);
+            result *= x_pow;
+        }
+        last_deg = it->first;
+        result += it->second;
+    }
+    if (last_deg > 0) {
+        mp_pow_ui(x_pow, x, last_deg);
+        result *= x_pow;
+    }
+    return result;
+}
 
-        mp_pow_ui(x_pow, x, last_deg - (*it).first);
-        last_deg = (*it).first;
-        result = (*it).second + x_pow * result;
+std::vector<integer_class>
+UnivariateIntPolynomial::multieval(const std::vector<integer_class> &x) const
+{
+    std::vector<integer_class> result(x.size());
+    if (poly_.dict_.empty())
+        return result;
+    // Dense coefficients, so that Horner's scheme runs without map lookups or
+    // powers for the gaps
+    std::vector<integer_class> c(poly_.dict_.rbegin()->first + 1);
+    for (const auto &t : poly_.dict_)
+        c[t.first] = t.second;
+
+    int n = x.size();
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < n; i++) {
+        integer_class &r = result[i];
+        r = c.back();
+        for (std::size_t k = c.size() - 1; k-- > 0;) {
+            r *= x[i];
+            r += c[k];
+        }
     }
-    mp_pow_ui(x_pow, x, last_deg);
-    result *= x_pow;
+    return result;
+}
 
+std::vector<double>
+UnivariateIntPolynomial::multieval(const std::vector<double> &x) const
+{
+    std::vector<double> result(x.size(), 0.0);
+    if (poly_.dict_.empty())
+        return result;
+    std::vector<double> c(poly_.dict_.rbegin()->first + 1, 0.0);
+    for (const auto &t : poly_.dict_)
+        c[t.first] = mp_get_d(t.second);
+
+    // Horner's scheme run over blocks of points, the inner loop has no
+    // dependencies between the points and is vectorized by the compiler.
+    const std::size_t block = 256;
+    double *r = result.data();
+    const double *px = x.data();
+    for (std::size_t lo = 0; lo < x.size(); lo += block) {
+        std::size_t hi = std::min(lo + block, x.size());
+        for (std::size_t j = lo; j < hi; j++)
+            r[j] = c.back();
+        for (std::size_t k = c.size() - 1; k-- > 0;) {
+            const double ck = c[k];
+            for (std::size_t j = lo; j < hi; j++)
+                r[j] = r[j] * px[j] + ck;
+        }
+    }
     return result;
 }
 
@@ -315,6 +315,13 @@ public:
     integer_class max_abs_coef() const;
     //! Evaluates the UnivariateIntPolynomial at value x
     integer_class eval(const integer_class &x) const;
+    //! Evaluates the UnivariateIntPolynomial at every value in `x` by
+    //! Horner's scheme over the dense coefficients
+    std::vector<integer_class>
+    multieval(const std::vector<integer_class> &x) const;
+    //! Evaluates the UnivariateIntPolynomial in double precision at every
+    //! value in `x`
+    std::vector<double> multieval(const std::vector<double> &x) const;
 
     //! \return `true` if `0`
     bool is_zero() const;
@@ -0,0 +1,593 @@
+#include <cstdint>
+#include <symengine/polynomial_gcd.h>
+
+namespace SymEngine
+{
+
+namespace
+{
+
+typedef std::uint64_t ulong_p;
+//! dense univariate polynomial modulo p, coefficients from lowest degree up
+typedef std::vector<ulong_p> upoly_p;
+//! sparse multivariate polynomial modulo p, sorted in lex order
+typedef std::map<vec_uint, ulong_p> mpoly_p;
+//! sparse multivariate polynomial over the integers, sorted in lex order
+typedef std::map<vec_uint, integer_class> mpoly_z;
+//! multivariate polynomial modulo p with the last variable split off: every
+//! monomial in the other variables maps to a dense polynomial in the last one
+typedef std::map<vec_uint, upoly_p> mpoly_py;
+
+// All primes are below 2**31, so products of residues fit in 64 bits.
+inline ulong_p mulmod(ulong_p a, ulong_p b, ulong_p p)
+{
+    return (a * b) % p;
+}
+
+inline ulong_p submod(ulong_p a, ulong_p b, ulong_p p)
+{
+    return (a >= b) ? a - b : a + p - b;
+}
+
+ulong_p powmod(ulong_p a, ulong_p e, ulong_p p)
+{
+    ulong_p r = 1;
+    while (e > 0) {
+        if (e & 1)
+            r = mulmod(r, a, p);
+        a = mulmod(a, a, p);
+        e >>= 1;
+    }
+    return r;
+}
+
+inline ulong_p invmod(ulong_p a, ulong_p p)
+{
+    return powmod(a, p - 2, p);
+}
+
+ulong_p reduce(const integer_class &a, const integer_class &p)
+{
+    integer_class r;
+    mp_fdiv_r(r, a, p);
+    return mp_get_ui(r);
+}
+
+inline integer_class lift(ulong_p a)
+{
+    return integer_class(static_cast<unsigned long>(a));
+}
+
+// ------------------------ dense univariate modulo p ------------------------
+
+void up_trim(upoly_p &a)
+{
+    while (not a.empty() and a.back() == 0)
+        a.pop_back();
+}
+
+ulong_p up_eval(const upoly_p &a, ulong_p r, ulong_p p)
+{
+    ulong_p res = 0;
+    for (auto it = a.rbegin(); it != a.rend(); ++it)
+        res = (mulmod(res, r, p) + *it) % p;
+    return res;
+}
+
+upoly_p up_mul(const upoly_p &a, const upoly_p &b, ulong_p p)
+{
+    if (a.empty() or b.empty())
+        return {};
+    upoly_p c(a.size() + b.size() - 1, 0);
+    for (std::size_t i = 0; i < a.size(); i++)
+        for (std::size_t j = 0; j < b.size(); j++)
+            c[i + j] = (c[i + j] + mulmod(a[i], b[j], p)) % p;
+    return c;
+}
+
+void up_scale(upoly_p &a, ulong_p c, ulong_p p)
+{
+    for (auto &x : a)
+        x = mulmod(x, c, p);
+    up_trim(a);
+}
+
+void up_divrem(const upoly_p &a, const upoly_p &b, ulong_p p, upoly_p &q,
+               upoly_p &r)
+{
+    SYMENGINE_ASSERT(not b.empty())
+    r = a;
+    q.clear();
+    if (r.size() < b.size())
+        return;
+    q.assign(r.size() - b.size() + 1, 0);
+    ulong_p inv = invmod(b.back(), p);
+    for (std::size_t k = q.size(); k-- > 0;) {
+        ulong_p c = mulmod(r[k + b.size() - 1], inv, p);
+        q[k] = c;
+        if (c == 0)
+            continue;
+        for (std::size_t j = 0; j < b.size(); j++)
+            r[k + j] = submod(r[k + j], mulmod(c, b[j], p), p);
+    }
+    up_trim(r);
+}
+
+upoly_p up_divexact(const upoly_p &a, const upoly_p &b, ulong_p p)
+{
+    upoly_p q, r;
+    up_divrem(a, b, p, q, r);
+    SYMENGINE_ASSERT(r.empty())
+    return q;
+}
+
+//! \return the monic gcd of `a` and `b`
+upoly_p up_gcd(upoly_p a, upoly_p b, ulong_p p)
+{
+    upoly_p q, r;
+    while (not b.empty()) {
+        up_divrem(a, b, p, q, r);
+        a.swap(b);
+        b.swap(r);
+    }
+    if (not a.empty())
+        up_scale(a, invmod(a.back(), p), p);
+    return a;
+}
+
+// ----------------------- sparse multivariate modulo p ----------------------
+
+void mp_scale(mpoly_p &a, ulong_p c, ulong_p p)
+{
+    for (auto &t : a)
+        t.second = mulmod(t.second, c, p);
+}
+
+void mp_make_monic(mpoly_p &a, ulong_p p)
+{
+    if (not a.empty())
+        mp_scale(a, invmod(a.rbegin()->second, p), p);
+}
+
+//! \return true if `c` divides `a`
+bool mp_divides(const mpoly_p &c, const mpoly_p &a, ulong_p p)
+{
+    if (c.empty())
+        return a.empty();
+    const vec_uint &lm = c.rbegin()->first;
+    ulong_p inv = invmod(c.rbegin()->second, p);
+    mpoly_p r = a;
+    vec_uint shift(lm.size()), key(lm.size());
+    while (not r.empty()) {
+        auto lt = std::prev(r.end());
+        for (std::size_t i = 0; i < lm.size(); i++) {
+            if (lt->first[i] < lm[i])
+                return false;
+            shift[i] = lt->first[i] - lm[i];
+        }
+        ulong_p q = mulmod(lt->second, inv, p);
+        for (const auto &t : c) {
+            for (std::size_t i = 0; i < lm.size(); i++)
+                key[i] = t.first[i] + shift[i];
+            ulong_p s = mulmod(q, t.second, p);
+            if (s == 0)
+                continue;
+            auto it = r.find(key);
+            if (it == r.end()) {
+                r.insert(std::make_pair(key, p - s));
+            } else {
+                it->second = submod(it->second, s, p);
+                if (it->second == 0)
+                    r.erase(it);
+            }
+        }
+    }
+    return true;
+}
+
+mpoly_py split_last(const mpoly_p &a)
+{
+    mpoly_py res;
+    for (const auto &t : a) {
+        vec_uint key(t.first.begin(), t.first.end() - 1);
+        upoly_p &u = res[key];
+        unsigned int d = t.first.back();
+        if (u.size() <= d)
+            u.resize(d + 1, 0);
+        u[d] = t.second;
+    }
+    return res;
+}
+
+mpoly_p join_last(const mpoly_py &a)
+{
+    mpoly_p res;
+    for (const auto &t : a) {
+        vec_uint key = t.first;
+        key.push_back(0);
+        for (unsigned int d = 0; d < t.second.size(); d++) {
+            if (t.second[d] != 0) {
+                key.back() = d;
+                res.insert(std::make_pair(key, t.second[d]));
+            }
+        }
+    }
+    return res;
+}
+
+mpoly_p eval_last(const mpoly_py &a, ulong_p r, ulong_p p)
+{
+    mpoly_p res;
+    for (const auto &t : a) {
+        ulong_p v = up_eval(t.second, r, p);
+        if (v != 0)
+            res.insert(res.end(), std::make_pair(t.first, v));
+    }
+    return res;
+}
+
+//! \return gcd of the coefficients of `a` in the last variable
+upoly_p content_last(const mpoly_py &a, ulong_p p)
+{
+    upoly_p c;
+    for (const auto &t : a) {
+        c = up_gcd(c, t.second, p);
+        if (c.size() == 1)
+            break;
+    }
+    return c;
+}
+
+void divide_last(mpoly_py &a, const upoly_p &c, ulong_p p)
+{
+    for (auto &t : a)
+        t.second = up_divexact(t.second, c, p);
+}
+
+unsigned int degree_last(const mpoly_py &a)
+{
+    unsigned int d = 0;
+    for (const auto &t : a)
+        d = std::max(d, static_cast<unsigned int>(t.second.size() - 1));
+    return d;
+}
+
+bool is_constant(const mpoly_p &a)
+{
+    if (a.size() != 1)
+        return false;
+    for (unsigned int e : a.begin()->first)
+        if (e != 0)
+            return false;
+    return true;
+}
+
+//! Monic gcd of `a` and `b` in `nvars` variables modulo `p`, computed by
+//! evaluating the last variable, recursing, and interpolating the images.
+mpoly_p pgcd(const mpoly_p &a, const mpoly_p &b, unsigned int nvars,
+             ulong_p p)
+{
+    mpoly_p res;
+    if (a.empty() or b.empty()) {
+        res = a.empty() ? b : a;
+        mp_make_monic(res, p);
+        return res;
+    }
+    if (nvars == 0) {
+        res.insert(std::make_pair(vec_uint(), ulong_p(1)));
+        return res;
+    }
+    if (nvars == 1) {
+        upoly_p ua, ub;
+        for (const auto &t : a) {
+            ua.resize(t.first[0] + 1, 0);
+            ua[t.first[0]] = t.second;
+        }
+        for (const auto &t : b) {
+            ub.resize(t.first[0] + 1, 0);
+            ub[t.first[0]] = t.second;
+        }
+        upoly_p g = up_gcd(ua, ub, p);
+        for (unsigned int d = 0; d < g.size(); d++)
+            if (g[d] != 0)
+                res.insert(std::make_pair(vec_uint({d}), g[d]));
+        return res;
+    }
+
+    // Remove the contents in the last variable
+    mpoly_py as = split_last(a), bs = split_last(b);
+    upoly_p ca = content_last(as, p), cb = content_last(bs, p);
+    upoly_p c = up_gcd(ca, cb, p);
+    divide_last(as, ca, p);
+    divide_last(bs, cb, p);
+    mpoly_p ap = join_last(as), bp = join_last(bs);
+
+    // The leading coefficient of the gcd divides `g`, so every image is
+    // scaled to have leading coefficient `g(r)`.
+    upoly_p g = up_gcd(as.rbegin()->second, bs.rbegin()->second, p);
+    unsigned int bound
+        = g.size() - 1 + std::min(degree_last(as), degree_last(bs));
+
+    mpoly_py h;
+    upoly_p q;
+    vec_uint hlm;
+    for (ulong_p r = 0; r < p; r++) {
+        ulong_p gr = up_eval(g, r, p);
+        if (gr == 0)
+            continue;
+        mpoly_p cr
+            = pgcd(eval_last(as, r, p), eval_last(bs, r, p), nvars - 1, p);
+        if (is_constant(cr)) {
+            // The primitive parts are coprime
+            mpoly_py cs;
+            cs[vec_uint(nvars - 1, 0)] = c;
+            return join_last(cs);
+        }
+        mp_scale(cr, gr, p);
+        const vec_uint &lm = cr.rbegin()->first;
+        if (q.empty() or lm < hlm) {
+            // First image, or all previous images were unlucky
+            h.clear();
+            for (const auto &t : cr)
+                h[t.first] = {t.second};
+            q = {p - r, 1};
+            hlm = lm;
+        } else if (lm > hlm) {
+            // Unlucky evaluation point
+            continue;
+        } else {
+            // Newton interpolation: h += (cr - h(r)) / q(r) * q
+            ulong_p qinv = invmod(up_eval(q, r, p), p);
+            for (const auto &t : cr)
+                h[t.first];
+            for (auto it = h.begin(); it != h.end();) {
+                auto ct = cr.find(it->first);
+                ulong_p v = (ct == cr.end()) ? 0 : ct->second;
+                ulong_p d = mulmod(submod(v, up_eval(it->second, r, p), p),
+                                   qinv, p);
+                if (d != 0) {
+                    upoly_p &u = it->second;
+                    u.resize(std::max(u.size(), q.size()), 0);
+                    for (std::size_t k = 0; k < q.size(); k++)
+                        u[k] = (u[k] + mulmod(d, q[k], p)) % p;
+                    up_trim(u);
+                }
+                if (it->second.empty())
+                    it = h.erase(it);
+                else
+                    ++it;
+            }
+            q = up_mul(q, {p - r, 1}, p);
+        }
+        if (q.size() - 1 > bound) {
+            mpoly_py hs = h;
+            divide_last(hs, content_last(hs, p), p);
+            mpoly_p cand = join_last(hs);
+            if (mp_divides(cand, ap, p) and mp_divides(cand, bp, p)) {
+                for (auto &t : hs)
+                    t.second = up_mul(t.second, c, p);
+                res = join_last(hs);
+                mp_make_monic(res, p);
+                return res;
+            }
+        }
+    }
+    throw std::runtime_error("gcd: ran out of evaluation points");
+}
+
+// ------------------------ sparse multivariate over Z -----------------------
+
+integer_class mz_content(const mpoly_z &a)
+{
+    integer_class c(0);
+    for (const auto &t : a) {
+        mp_gcd(c, c, t.second);
+        if (c == 1)
+            break;
+    }
+    return c;
+}
+
+//! \return true if `c` divides `a`
+bool mz_divides(const mpoly_z &c, const mpoly_z &a)
+{
+    if (c.empty())
+        return a.empty();
+    const vec_uint &lm = c.rbegin()->first;
+    const integer_class &lc = c.rbegin()->second;
+    mpoly_z r = a;
+    vec_uint shift(lm.size()), key(lm.size());
+    integer_class q, rem, s;
+    while (not r.empty()) {
+        auto lt = std::prev(r.end());
+        for (std::size_t i = 0; i < lm.size(); i++) {
+            if (lt->first[i] < lm[i])
+                return false;
+            shift[i] = lt->first[i] - lm[i];
+        }
+        mp_tdiv_qr(q, rem, lt->second, lc);
+        if (rem != 0)
+            return false;
+        for (const auto &t : c) {
+            for (std::size_t i = 0; i < lm.size(); i++)
+                key[i] = t.first[i] + shift[i];
+            auto it = r.find(key);
+            s = q * t.second;
+            if (it == r.end()) {
+                r.insert(std::make_pair(key, integer_class(-s)));
+            } else {
+                it->second -= s;
+                if (it->second == 0)
+                    r.erase(it);
+            }
+        }
+    }
+    return true;
+}
+
+mpoly_z mz_gcd(const mpoly_z &a, const mpoly_z &b, unsigned int nvars)
+{
+    mpoly_z res;
+    if (a.empty() or b.empty()) {
+        res = a.empty() ? b : a;
+        if (not res.empty() and res.rbegin()->second < 0)
+            for (auto &t : res)
+                t.second = -t.second;
+        return res;
+    }
+    integer_class ca = mz_content(a), cb = mz_content(b), c;
+    mp_gcd(c, ca, cb);
+    if (nvars == 0) {
+        res.insert(std::make_pair(vec_uint(), c));
+        return res;
+    }
+    mpoly_z ap = a, bp = b;
+    for (auto &t : ap)
+        mp_divexact(t.second, t.second, ca);
+    for (auto &t : bp)
+        mp_divexact(t.second, t.second, cb);
+    integer_class g;
+    mp_gcd(g, ap.rbegin()->second, bp.rbegin()->second);
+
+    // h holds the gcd modulo m in the symmetric range
+    mpoly_z h;
+    vec_uint hlm;
+    integer_class m(0), prime(1), half, u;
+    prime <<= 30;
+    while (true) {
+        mp_nextprime(prime, prime);
+        ulong_p p = mp_get_ui(prime);
+        ulong_p gp = reduce(g, prime);
+        if (gp == 0)
+            continue;
+        mpoly_p ai, bi;
+        for (const auto &t : ap) {
+            ulong_p v = reduce(t.second, prime);
+            if (v != 0)
+                ai.insert(ai.end(), std::make_pair(t.first, v));
+        }
+        for (const auto &t : bp) {
+            ulong_p v = reduce(t.second, prime);
+            if (v != 0)
+                bi.insert(bi.end(), std::make_pair(t.first, v));
+        }
+        mpoly_p cp = pgcd(ai, bi, nvars, p);
+        if (is_constant(cp)) {
+            res.insert(std::make_pair(vec_uint(nvars, 0), c));
+            return res;
+        }
+        mp_scale(cp, gp, p);
+        const vec_uint &lm = cp.rbegin()->first;
+        if (m == 0 or lm < hlm) {
+            h.clear();
+            for (const auto &t : cp) {
+                u = lift(t.second);
+                if (2 * t.second > p)
+                    u -= prime;
+                h.insert(h.end(), std::make_pair(t.first, u));
+            }
+            m = prime;
+            hlm = lm;
+            continue;
+        } else if (lm > hlm) {
+            continue;
+        }
+
+        // Chinese remaindering: find u = h (mod m) and u = cp (mod p)
+        ulong_p minv = invmod(reduce(m, prime), p);
+        mpoly_z hn;
+        bool stable = true;
+        auto it = h.begin();
+        auto jt = cp.begin();
+        integer_class mp = m * prime;
+        half = mp / 2;
+        while (it != h.end() or jt != cp.end()) {
+            const vec_uint *key;
+            integer_class hv(0);
+            ulong_p cv = 0;
+            if (jt == cp.end() or (it != h.end() and it->first < jt->first)) {
+                key = &it->first;
+                hv = it->second;
+                ++it;
+            } else if (it == h.end() or jt->first < it->first) {
+                key = &jt->first;
+                cv = jt->second;
+                ++jt;
+            } else {
+                key = &it->first;
+                hv = it->second;
+                cv = jt->second;
+                ++it;
+                ++jt;
+            }
+            ulong_p d = mulmod(submod(cv, reduce(hv, prime), p), minv, p);
+            u = hv + m * lift(d);
+            if (u > half)
+                u -= mp;
+            if (u != hv)
+                stable = false;
+            if (u != 0)
+                hn.insert(hn.end(), std::make_pair(*key, u));
+        }
+        h.swap(hn);
+        m = mp;
+        if (not stable)
+            continue;
+
+        mpoly_z cand = h;
+        integer_class ch = mz_content(cand);
+        if (cand.rbegin()->second < 0)
+            ch = -ch;
+        for (auto &t : cand)
+            mp_divexact(t.second, t.second, ch);
+        if (mz_divides(cand, ap) and mz_divides(cand, bp)) {
+            for (auto &t : cand)
+                t.second *= c;
+            return cand;
+        }
+    }
+}
+
+} // anonymous namespace
+
+RCP<const UnivariateIntPolynomial> gcd_poly(const UnivariateIntPolynomial &a,
+                                            const UnivariateIntPolynomial &b)
+{
+    if (!(a.get_var()->__eq__(*b.get_var())))
+        throw std::runtime_error("Error: variables must agree.");
+
+    mpoly_z pa, pb;
+    for (const auto &t : a.get_dict())
+        pa.insert(pa.end(), std::make_pair(vec_uint({t.first}), t.second));
+    for (const auto &t : b.get_dict())
+        pb.insert(pb.end(), std::make_pair(vec_uint({t.first}), t.second));
+    map_uint_mpz d;
+    for (const auto &t : mz_gcd(pa, pb, 1))
+        d.insert(d.end(), std::make_pair(t.first[0], t.second));
+    return univariate_int_polynomial(a.get_var(), std::move(d));
+}
+
+RCP<const MultivariateIntPolynomial>
+gcd_mult_poly(const MultivariateIntPolynomial &a,
+              const MultivariateIntPolynomial &b)
+{
+    vec_uint v1;
+    vec_uint v2;
+    set_basic s;
+    unsigned int size = reconcile(v1, v2, s, a.vars_, b.vars_);
+    mpoly_z pa, pb;
+    for (const auto &t : a.dict_)
+        pa.insert(std::make_pair(translate<vec_uint>(t.first, v1, size),
+                                 t.second));
+    for (const auto &t : b.dict_)
+        pb.insert(std::make_pair(translate<vec_uint>(t.first, v2, size),
+                                 t.second));
+    umap_uvec_mpz d;
+    for (const auto &t : mz_gcd(pa, pb, size))
+        d.insert(t);
+    // `s` is already sorted, so create() keeps the order of the exponents
+    return MultivariateIntPolynomial::create(vec_basic(s.begin(), s.end()),
+                                             std::move(d));
+}
+
+} // SymEngine
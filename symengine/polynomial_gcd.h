@@ -0,0 +1,30 @@
+/**
+ *  \file polynomial_gcd.h
+ *  Greatest common divisors of polynomials with integer coefficients
+ *
+ **/
+#ifndef SYMENGINE_POLYNOMIAL_GCD_H
+#define SYMENGINE_POLYNOMIAL_GCD_H
+
+#include <symengine/polynomial.h>
+#include <symengine/polynomial_multivariate.h>
+
+namespace SymEngine
+{
+
+//! \return the greatest common divisor of `a` and `b` with a positive
+//! leading coefficient. The gcd is computed modulo word sized primes whose
+//! images are combined by Chinese remaindering.
+RCP<const UnivariateIntPolynomial> gcd_poly(const UnivariateIntPolynomial &a,
+                                            const UnivariateIntPolynomial &b);
+
+//! \return the greatest common divisor of `a` and `b` with a positive
+//! leading coefficient in lex order, computed with Brown's dense modular
+//! algorithm.
+RCP<const MultivariateIntPolynomial>
+gcd_mult_poly(const MultivariateIntPolynomial &a,
+              const MultivariateIntPolynomial &b);
+
+} // SymEngine
+
+#endif
@@ -3,6 +3,7 @@
 #include <symengine/mul.h>
 #include <symengine/polynomial.h>
 #include <symengine/polynomial_multivariate.h>
+#include <symengine/polynomial_packed.h>
 #include <symengine/pow.h>
 
 namespace SymEngine
@@ -96,6 +97,38 @@ MultivariateIntPolynomial::convert(const UnivariateIntPolynomial &o)
     return MultivariateIntPolynomial::create(s, std::move(d));
 }
 
+unsigned int MultivariateIntPolynomial::max_degree() const
+{
+    unsigned int deg = 0;
+    for (const auto &p : degrees_)
+        deg = std::max(deg, p.second);
+    return deg;
+}
+
+RCP<const MultivariateIntPolynomial>
+MultivariateIntPolynomial::mul(const MultivariateIntPolynomial &b) const
+{
+    vec_uint v1;
+    vec_uint v2;
+    set_basic s;
+    unsigned int size = reconcile(v1, v2, s, vars_, b.vars_);
+    MonomialPacker packer(size);
+    // The degree of the product in any variable is bounded by the sum of the
+    // degrees of the factors, so this check rules out overflow of the fields.
+    if (dict_.empty() or b.dict_.empty()
+        or not packer.fits(static_cast<unsigned long>(max_degree())
+                           + b.max_degree()))
+        return MPolyBase::mul(b);
+
+    PackedIntPoly p1, p2, p3;
+    packed_from_dict(p1, dict_, v1, packer);
+    packed_from_dict(p2, b.dict_, v2, packer);
+    packed_mul_parallel(p3, p1, p2);
+    umap_uvec_mpz dict;
+    packed_to_dict(dict, p3, packer);
+    return MultivariateIntPolynomial::from_dict(s, std::move(dict));
+}
+
 unsigned int reconcile(vec_uint &v1, vec_uint &v2, set_basic &s,
                        const set_basic &s1, const set_basic &s2)
 {
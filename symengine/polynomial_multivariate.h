@@ -79,17 +79,20 @@ protected:
             }
         }
 
+        // Calculate the degrees of the polynomial in a single pass over d
+        vec_uint maxdegs(s.size(), 0);
+        for (const auto &bucket : d) {
+            for (unsigned int i = 0; i < maxdegs.size(); i++) {
+                if (bucket.first[i] > 0
+                    && static_cast<unsigned int>(bucket.first[i]) > maxdegs[i])
+                    maxdegs[i] = bucket.first[i];
+            }
+        }
         umap_basic_uint degs;
-        // Calculate the degrees of the polynomial
-        int whichvar = 0;
+        unsigned int whichvar = 0;
         for (auto sym : s) {
-            degs.insert(std::pair<RCP<const Basic>, unsigned int>(sym, 0));
-            for (auto bucket : d) {
-                if (bucket.first[whichvar] > 0
-                    && static_cast<unsigned int>(bucket.first[whichvar])
-                           > degs.find(sym)->second)
-                    degs.find(sym)->second = bucket.first[whichvar];
-            }
+            degs.insert(std::pair<RCP<const Basic>, unsigned int>(
+                sym, maxdegs[whichvar]));
             whichvar++;
         }
         return make_rcp<const MPoly>(s, std::move(degs), std::move(d));
@@ -136,7 +139,7 @@ public:
         for (auto &bucket : d) {
             dict.insert(std::pair<Vec, Coeff>(
                 translate<Vec>(bucket.first, translator, s.size()),
-                bucket.second));
+                std::move(bucket.second)));
         }
         return MPoly::from_dict(s, std::move(dict));
     }
@@ -284,6 +287,12 @@ public:
     }
     static RCP<const MultivariateIntPolynomial>
     convert(const UnivariateIntPolynomial &o);
+    //! \return the largest degree of any variable
+    unsigned int max_degree() const;
+    //! Multiplies using packed monomials when the exponents of the product
+    //! fit, otherwise falls back to `MPolyBase::mul`
+    RCP<const MultivariateIntPolynomial>
+    mul(const MultivariateIntPolynomial &b) const;
 };
 
 // MultivariatePolynomial
@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <iterator>
+#include <symengine/polynomial_packed.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace SymEngine
+{
+
+MonomialPacker::MonomialPacker(unsigned int nvars) : nvars_{nvars}, guard_{0}
+{
+    // Exponents are unsigned ints, so there is no point in wider fields
+    bits_ = (nvars_ == 0) ? 32 : std::min(32u, 64u / nvars_);
+    // Too many variables for a field with a guard bit, fits() rejects it
+    if (bits_ < 2)
+        return;
+    for (unsigned int i = 0; i < nvars_; i++) {
+        guard_ |= packed_monomial(1) << (i * bits_ + bits_ - 1);
+    }
+}
+
+unsigned int MonomialPacker::max_exponent() const
+{
+    return (1u << (bits_ - 1)) - 1;
+}
+
+packed_monomial MonomialPacker::pack(const vec_uint &v) const
+{
+    SYMENGINE_ASSERT(v.size() == nvars_)
+    packed_monomial m = 0;
+    for (unsigned int i = 0; i < nvars_; i++) {
+        m = (m << bits_) | v[i];
+    }
+    return m;
+}
+
+packed_monomial MonomialPacker::pack(const vec_uint &v,
+                                     const vec_uint &translator) const
+{
+    packed_monomial m = 0;
+    for (unsigned int i = 0; i < v.size(); i++) {
+        m |= packed_monomial(v[i]) << ((nvars_ - 1 - translator[i]) * bits_);
+    }
+    return m;
+}
+
+void MonomialPacker::unpack(packed_monomial m, vec_uint &v) const
+{
+    packed_monomial mask = (packed_monomial(1) << bits_) - 1;
+    v.resize(nvars_);
+    for (unsigned int i = nvars_; i-- > 0;) {
+        v[i] = static_cast<unsigned int>(m & mask);
+        m >>= bits_;
+    }
+}
+
+void packed_from_dict(PackedIntPoly &p, const umap_uvec_mpz &d,
+                      const vec_uint &translator,
+                      const MonomialPacker &packer)
+{
+    std::vector<std::pair<packed_monomial, const integer_class *>> terms;
+    terms.reserve(d.size());
+    for (const auto &bucket : d) {
+        terms.push_back(
+            {packer.pack(bucket.first, translator), &bucket.second});
+    }
+    std::sort(terms.begin(), terms.end(),
+              [](const std::pair<packed_monomial, const integer_class *> &a,
+                 const std::pair<packed_monomial, const integer_class *> &b) {
+                  return a.first > b.first;
+              });
+    p.clear();
+    p.monoms_.reserve(terms.size());
+    p.coeffs_.reserve(terms.size());
+    for (const auto &t : terms) {
+        p.monoms_.push_back(t.first);
+        p.coeffs_.push_back(*t.second);
+    }
+}
+
+void packed_to_dict(umap_uvec_mpz &d, const PackedIntPoly &p,
+                    const MonomialPacker &packer)
+{
+    vec_uint v;
+    d.reserve(d.size() + p.size());
+    for (std::size_t k = 0; k < p.size(); k++) {
+        packer.unpack(p.monoms_[k], v);
+        d.insert(std::pair<vec_uint, integer_class>(v, p.coeffs_[k]));
+    }
+}
+
+void packed_add(PackedIntPoly &c, const PackedIntPoly &a,
+                const PackedIntPoly &b)
+{
+    SYMENGINE_ASSERT(&c != &a and &c != &b)
+    c.clear();
+    c.monoms_.reserve(a.size() + b.size());
+    c.coeffs_.reserve(a.size() + b.size());
+    std::size_t i = 0, j = 0;
+    while (i < a.size() and j < b.size()) {
+        if (a.monoms_[i] > b.monoms_[j]) {
+            c.monoms_.push_back(a.monoms_[i]);
+            c.coeffs_.push_back(a.coeffs_[i++]);
+        } else if (a.monoms_[i] < b.monoms_[j]) {
+            c.monoms_.push_back(b.monoms_[j]);
+            c.coeffs_.push_back(b.coeffs_[j++]);
+        } else {
+            integer_class t = a.coeffs_[i] + b.coeffs_[j];
+            if (t != 0) {
+                c.monoms_.push_back(a.monoms_[i]);
+                c.coeffs_.push_back(std::move(t));
+            }
+            i++;
+            j++;
+        }
+    }
+    c.monoms_.insert(c.monoms_.end(), a.monoms_.begin() + i, a.monoms_.end());
+    c.coeffs_.insert(c.coeffs_.end(), a.coeffs_.begin() + i, a.coeffs_.end());
+    c.monoms_.insert(c.monoms_.end(), b.monoms_.begin() + j, b.monoms_.end());
+    c.coeffs_.insert(c.coeffs_.end(), b.coeffs_.begin() + j, b.coeffs_.end());
+}
+
+namespace
+{
+// A product `a[i] * b[j]` waiting in the heap
+struct HeapTerm {
+    packed_monomial m;
+    std::size_t i;
+    std::size_t j;
+};
+
+struct HeapTermLess {
+    bool operator()(const HeapTerm &x, const HeapTerm &y) const
+    {
+        return x.m < y.m;
+    }
+};
+}
+
+void packed_mul(PackedIntPoly &c, const PackedIntPoly &a_,
+                const PackedIntPoly &b_)
+{
+    SYMENGINE_ASSERT(&c != &a_ and &c != &b_)
+    c.clear();
+    if (a_.empty() or b_.empty())
+        return;
+    // The heap holds at most one term per row, so iterate over the rows of
+    // the shorter polynomial.
+    const PackedIntPoly &a = (a_.size() <= b_.size()) ? a_ : b_;
+    const PackedIntPoly &b = (a_.size() <= b_.size()) ? b_ : a_;
+
+    // Monagan and Pearce's variant of Johnson's algorithm: row `i + 1` enters
+    // the heap only once `a[i] * b[0]` has been extracted, which keeps the
+    // heap small for dense products.
+    HeapTermLess less;
+    std::vector<HeapTerm> heap, extracted;
+    heap.reserve(a.size());
+    heap.push_back({a.monoms_[0] + b.monoms_[0], 0, 0});
+    integer_class acc;
+    while (not heap.empty()) {
+        packed_monomial m = heap.front().m;
+        acc = 0;
+        extracted.clear();
+        do {
+            std::pop_heap(heap.begin(), heap.end(), less);
+            const HeapTerm &t = heap.back();
+            mp_addmul(acc, a.coeffs_[t.i], b.coeffs_[t.j]);
+            extracted.push_back(t);
+            heap.pop_back();
+        } while (not heap.empty() and heap.front().m == m);
+
+        for (const auto &t : extracted) {
+            if (t.j == 0 and t.i + 1 < a.size()) {
+                heap.push_back(
+                    {a.monoms_[t.i + 1] + b.monoms_[0], t.i + 1, 0});
+                std::push_heap(heap.begin(), heap.end(), less);
+            }
+            if (t.j + 1 < b.size()) {
+                heap.push_back({a.monoms_[t.i] + b.monoms_[t.j + 1], t.i,
+                                t.j + 1});
+                std::push_heap(heap.begin(), heap.end(), less);
+            }
+        }
+        if (acc != 0) {
+            c.monoms_.push_back(m);
+            c.coeffs_.push_back(acc);
+        }
+    }
+}
+
+void packed_mul_range(PackedIntPoly &c, const PackedIntPoly &a_,
+                      const PackedIntPoly &b_, packed_monomial lo,
+                      packed_monomial hi)
+{
+    SYMENGINE_ASSERT(&c != &a_ and &c != &b_)
+    c.clear();
+    if (a_.empty() or b_.empty())
+        return;
+    const PackedIntPoly &a = (a_.size() <= b_.size()) ? a_ : b_;
+    const PackedIntPoly &b = (a_.size() <= b_.size()) ? b_ : a_;
+
+    // Every row starts at its largest product not exceeding `hi`, found by
+    // bisection, and is dropped once its products fall below `lo`.
+    HeapTermLess less;
+    std::vector<HeapTerm> heap, extracted;
+    heap.reserve(a.size());
+    for (std::size_t i = 0; i < a.size(); i++) {
+        if (a.monoms_[i] > hi)
+            continue;
+        auto it = std::lower_bound(b.monoms_.begin(), b.monoms_.end(),
+                                   hi - a.monoms_[i],
+                                   std::greater<packed_monomial>());
+        if (it == b.monoms_.end())
+            continue;
+        std::size_t j = it - b.monoms_.begin();
+        packed_monomial m = a.monoms_[i] + b.monoms_[j];
+        if (m >= lo)
+            heap.push_back({m, i, j});
+    }
+    std::make_heap(heap.begin(), heap.end(), less);
+
+    integer_class acc;
+    while (not heap.empty()) {
+        packed_monomial m = heap.front().m;
+        acc = 0;
+        extracted.clear();
+        do {
+            std::pop_heap(heap.begin(), heap.end(), less);
+            const HeapTerm &t = heap.back();
+            mp_addmul(acc, a.coeffs_[t.i], b.coeffs_[t.j]);
+            extracted.push_back(t);
+            heap.pop_back();
+        } while (not heap.empty() and heap.front().m == m);
+
+        for (const auto &t : extracted) {
+            if (t.j + 1 < b.size()) {
+                packed_monomial next = a.monoms_[t.i] + b.monoms_[t.j + 1];
+                if (next >= lo) {
+                    heap.push_back({next, t.i, t.j + 1});
+                    std::push_heap(heap.begin(), heap.end(), less);
+                }
+            }
+        }
+        if (acc != 0) {
+            c.monoms_.push_back(m);
+            c.coeffs_.push_back(acc);
+        }
+    }
+}
+
+void packed_mul_parallel(PackedIntPoly &c, const PackedIntPoly &a,
+                         const PackedIntPoly &b, unsigned int nthreads)
+{
+    if (nthreads == 0) {
+#ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+#else
+        nthreads = 1;
+#endif
+    }
+    // Small products are not worth the overhead of splitting
+    if (nthreads <= 1 or a.size() * b.size() < 10000) {
+        packed_mul(c, a, b);
+        return;
+    }
+
+    // Sample the products on a grid, so that the ranges split below contain
+    // about the same number of products (and thus work) each.
+    std::vector<packed_monomial> sample;
+    std::size_t g = 16 * nthreads;
+    sample.reserve(g * g);
+    for (std::size_t si = 0; si < g; si++) {
+        for (std::size_t sj = 0; sj < g; sj++) {
+            sample.push_back(a.monoms_[si * a.size() / g]
+                             + b.monoms_[sj * b.size() / g]);
+        }
+    }
+    std::sort(sample.begin(), sample.end(), std::greater<packed_monomial>());
+    sample.erase(std::unique(sample.begin(), sample.end()), sample.end());
+
+    // Range `k` contains the monomials in `[his[k + 1] + 1, his[k]]`
+    std::vector<packed_monomial> his = {a.monoms_[0] + b.monoms_[0]};
+    for (std::size_t k = 1; k < nthreads; k++) {
+        packed_monomial s = sample[k * sample.size() / nthreads];
+        if (s < his.back())
+            his.push_back(s);
+    }
+    int nparts = his.size();
+    std::vector<PackedIntPoly> parts(nparts);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (int k = 0; k < nparts; k++) {
+        packed_monomial lo = (k + 1 < nparts) ? his[k + 1] + 1 : 0;
+        packed_mul_range(parts[k], a, b, lo, his[k]);
+    }
+
+    // The ranges are disjoint and decreasing, so merging is concatenation
+    std::size_t n = 0;
+    for (const auto &part : parts)
+        n += part.size();
+    c.clear();
+    c.monoms_.reserve(n);
+    c.coeffs_.reserve(n);
+    for (auto &part : parts) {
+        c.monoms_.insert(c.monoms_.end(), part.monoms_.begin(),
+                         part.monoms_.end());
+        std::move(part.coeffs_.begin(), part.coeffs_.end(),
+                  std::back_inserter(c.coeffs_));
+    }
+}
+
+} // SymEngine
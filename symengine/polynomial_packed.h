@@ -0,0 +1,108 @@
+/**
+ *  \file polynomial_packed.h
+ *  Sparse multivariate integer polynomials with packed monomials
+ *
+ **/
+#ifndef SYMENGINE_POLYNOMIAL_PACKED_H
+#define SYMENGINE_POLYNOMIAL_PACKED_H
+
+#include <cstdint>
+#include <symengine/basic.h>
+
+namespace SymEngine
+{
+
+typedef std::uint64_t packed_monomial;
+
+//! Packs exponent vectors of `nvars_` variables into a single 64-bit word.
+//! Every variable gets a field of `bits_` bits whose top bit is a guard bit.
+//! The first variable occupies the most significant field, so comparing two
+//! packed words compares the monomials in lex order, and adding two packed
+//! words multiplies the monomials.
+class MonomialPacker
+{
+public:
+    unsigned int nvars_;
+    unsigned int bits_;
+    //! mask with the guard bit of every field set
+    packed_monomial guard_;
+
+    MonomialPacker(unsigned int nvars);
+
+    //! \return largest exponent that can be stored in a field
+    unsigned int max_exponent() const;
+    //! \return true if exponents up to `deg` in every variable can be packed
+    bool fits(unsigned long deg) const
+    {
+        return bits_ >= 2 and deg <= max_exponent();
+    }
+    //! \return true if a sum of packed monomials carried into a guard bit
+    bool overflows(packed_monomial m) const
+    {
+        return (m & guard_) != 0;
+    }
+
+    packed_monomial pack(const vec_uint &v) const;
+    //! Packs `v` placing the exponent `v[i]` in the field `translator[i]`
+    packed_monomial pack(const vec_uint &v, const vec_uint &translator) const;
+    void unpack(packed_monomial m, vec_uint &v) const;
+};
+
+//! Sparse polynomial with integer coefficients whose terms are stored in two
+//! parallel arrays sorted by decreasing packed monomial.
+class PackedIntPoly
+{
+public:
+    std::vector<packed_monomial> monoms_;
+    std::vector<integer_class> coeffs_;
+
+    std::size_t size() const
+    {
+        return monoms_.size();
+    }
+    bool empty() const
+    {
+        return monoms_.empty();
+    }
+    void clear()
+    {
+        monoms_.clear();
+        coeffs_.clear();
+    }
+    bool operator==(const PackedIntPoly &o) const
+    {
+        return monoms_ == o.monoms_ and coeffs_ == o.coeffs_;
+    }
+};
+
+//! Packs the dictionary `d`, the exponent at position `i` of every key of `d`
+//! is placed into the field `translator[i]` of `packer`.
+void packed_from_dict(PackedIntPoly &p, const umap_uvec_mpz &d,
+                      const vec_uint &translator,
+                      const MonomialPacker &packer);
+//! Unpacks `p` into the dictionary `d`
+void packed_to_dict(umap_uvec_mpz &d, const PackedIntPoly &p,
+                    const MonomialPacker &packer);
+
+//! Adds two polynomials by merging their sorted terms: `c = a + b`
+void packed_add(PackedIntPoly &c, const PackedIntPoly &a,
+                const PackedIntPoly &b);
+//! Multiplies two polynomials: `c = a * b`, using Johnson's heap algorithm.
+//! The monomials of the product must fit in the packed fields.
+void packed_mul(PackedIntPoly &c, const PackedIntPoly &a,
+                const PackedIntPoly &b);
+//! Computes only the terms of `a * b` whose monomials lie in `[lo, hi]`
+void packed_mul_range(PackedIntPoly &c, const PackedIntPoly &a,
+                      const PackedIntPoly &b, packed_monomial lo,
+                      packed_monomial hi);
+//! Multiplies two polynomials using `nthreads` threads (all available
+//! OpenMP threads if `nthreads` is 0). The monomial space of the product is
+//! split into ranges of roughly equal size, every thread accumulates the
+//! terms of one range, and the ranges are concatenated at the end. Without
+//! OpenMP the ranges are computed one after another.
+void packed_mul_parallel(PackedIntPoly &c, const PackedIntPoly &a,
+                         const PackedIntPoly &b, unsigned int nthreads = 0);
+
+} // SymEngine
+
+#endif
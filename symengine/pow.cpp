@@ -16,6 +16,7 @@ Pow::Pow(const RCP<const Basic> &base, const RCP<const Basic> &exp)
     : base_{base}, exp_{exp}
 {
     SYMENGINE_ASSERT(is_canonical(*base, *exp))
+    hash();
 }
 
 bool Pow::is_canonical(const Basic &base, const Basic &exp) const
@@ -1,7 +1,15 @@
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <limits>
 #include <symengine/printer.h>
 
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
 namespace SymEngine
 {
 
@@ -15,129 +23,245 @@ std::string ascii_art()
     return a;
 }
 
+namespace
+{
+
+// Same format as printing a double to an ostream with 15 significant digits
+std::string double_to_str(double d)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.*g",
+                  std::numeric_limits<double>::digits10, d);
+    return buf;
+}
+
+// Orders the terms of Add and Mul for printing. The keys of their
+// dictionaries are unique, so `__cmp__` alone gives the same order as
+// `RCPBasicKeyLessCmp`, without the deep equality test.
+template <typename Dict>
+std::vector<const typename Dict::value_type *> sorted_terms(const Dict &d)
+{
+    std::vector<const typename Dict::value_type *> v;
+    v.reserve(d.size());
+    for (const auto &p : d)
+        v.push_back(&p);
+    std::sort(v.begin(), v.end(), [](const typename Dict::value_type *a,
+                                     const typename Dict::value_type *b) {
+        return a->first->__cmp__(*b->first) == -1;
+    });
+    return v;
+}
+
+void write_all(std::FILE *out, const std::string &s)
+{
+    if (std::fwrite(s.data(), 1, s.size(), out) != s.size())
+        throw std::runtime_error("Cannot write the output");
+}
+
+void write_all(int fd, const std::string &s)
+{
+    const char *p = s.data();
+    std::size_t left = s.size();
+    while (left > 0) {
+#ifndef _WIN32
+        auto n = ::write(fd, p, left);
+#else
+        auto n = ::_write(fd, p, static_cast<unsigned int>(left));
+#endif
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error("Cannot write the output");
+        }
+        p += n;
+        left -= n;
+    }
+}
+
+// The buffer of `print_lines` is written out when it grows over this size
+const std::size_t print_block_size = 1 << 16;
+
+template <typename Output>
+void print_lines_to(StrPrinter &printer, std::string &buf,
+                    const vec_basic &v, Output out)
+{
+    buf.clear();
+    for (const auto &b : v) {
+        printer.print(*b);
+        buf += '\n';
+        if (buf.size() >= print_block_size) {
+            write_all(out, buf);
+            buf.clear();
+        }
+    }
+    write_all(out, buf);
+    buf.clear();
+}
+}
+
+void StrPrinter::print_integer(const integer_class &i)
+{
+    if (mp_fits_slong_p(i)) {
+        long n = mp_get_si(i);
+        unsigned long u = n < 0 ? 0UL - static_cast<unsigned long>(n)
+                                : static_cast<unsigned long>(n);
+        char digits[24];
+        char *p = digits + sizeof(digits);
+        do {
+            *--p = static_cast<char>('0' + u % 10);
+            u /= 10;
+        } while (u != 0);
+        if (n < 0)
+            *--p = '-';
+        buf_.append(p, digits + sizeof(digits));
+        return;
+    }
+    mpz_srcptr z = get_mpz_t(i);
+    std::size_t old = buf_.size();
+    // room for the digits, the sign and the terminating null
+    buf_.resize(old + mpz_sizeinbase(z, 10) + 2);
+    mpz_get_str(&buf_[old], 10, z);
+    buf_.resize(old + std::strlen(&buf_[old]));
+}
+
+void StrPrinter::print_rational(const rational_class &i)
+{
+    print_integer(get_num(i));
+    if (get_den(i) != 1) {
+        buf_ += '/';
+        print_integer(get_den(i));
+    }
+}
+
+void StrPrinter::print_args(const vec_basic &v)
+{
+    for (auto p = v.begin(); p != v.end(); p++) {
+        if (p != v.begin()) {
+            buf_ += ", ";
+        }
+        print(**p);
+    }
+}
+
 void StrPrinter::bvisit(const Basic &x)
 {
     std::ostringstream s;
     s << "<" << typeName<Basic>(x) << " instance at " << (const void *)this
       << ">";
-    str_ = s.str();
+    buf_ += s.str();
 }
 
 void StrPrinter::bvisit(const Symbol &x)
 {
-    str_ = x.get_name();
+    buf_ += x.get_name();
 }
 
 void StrPrinter::bvisit(const Integer &x)
 {
-    std::ostringstream s;
-    s << x.i;
-    str_ = s.str();
+    print_integer(x.i);
 }
 
 void StrPrinter::bvisit(const Rational &x)
 {
-    std::ostringstream s;
-    s << x.i;
-    str_ = s.str();
+    print_rational(x.i);
 }
 
 void StrPrinter::bvisit(const Complex &x)
 {
-    std::ostringstream s;
     if (x.real_ != 0) {
-        s << x.real_;
+        print_rational(x.real_);
         // Since Complex is in canonical form, imaginary_ is not 0.
         if (mp_sign(x.imaginary_) == 1) {
-            s << " + ";
+            buf_ += " + ";
         } else {
-            s << " - ";
+            buf_ += " - ";
         }
         // If imaginary_ is not 1 or -1, print the absolute value
         if (x.imaginary_ != mp_sign(x.imaginary_)) {
-            s << mp_abs(x.imaginary_);
-            s << "*I";
+            print_rational(mp_abs(x.imaginary_));
+            buf_ += "*I";
         } else {
-            s << "I";
+            buf_ += "I";
         }
     } else {
         if (x.imaginary_ != mp_sign(x.imaginary_)) {
-            s << x.imaginary_;
-            s << "*I";
+            print_rational(x.imaginary_);
+            buf_ += "*I";
         } else {
             if (mp_sign(x.imaginary_) == 1) {
-                s << "I";
+                buf_ += "I";
             } else {
-                s << "-I";
+                buf_ += "-I";
             }
         }
     }
-    str_ = s.str();
 }
 
 void StrPrinter::bvisit(const RealDouble &x)
 {
-    std::ostringstream s;
-    s.precision(std::numeric_limits<double>::digits10);
-    s << x.i;
-    str_ = s.str();
-    if (str_.find(".") == std::string::npos) {
-        s << ".0";
-        str_ = s.str();
+    std::string s = double_to_str(x.i);
+    buf_ += s;
+    if (s.find(".") == std::string::npos) {
+        buf_ += ".0";
     }
 }
 
 void StrPrinter::bvisit(const ComplexDouble &x)
 {
-    std::ostringstream s;
-    s.precision(std::numeric_limits<double>::digits10);
-    s << x.i.real();
-    if (s.str().find(".") == std::string::npos) {
-        s << ".0";
+    std::string s = double_to_str(x.i.real());
+    buf_ += s;
+    if (s.find(".") == std::string::npos) {
+        buf_ += ".0";
     }
     if (x.i.imag() < 0) {
-        s << " - " << -x.i.imag();
+        buf_ += " - ";
+        s = double_to_str(-x.i.imag());
     } else {
-        s << " + " << x.i.imag();
+        buf_ += " + ";
+        s = double_to_str(x.i.imag());
     }
-    str_ = s.str();
-    if (str_.find(".") == str_.find_last_of(".")) {
-        str_ += ".0*I";
+    buf_ += s;
+    if (s.find(".") == std::string::npos) {
+        buf_ += ".0*I";
     } else {
-        str_ += "*I";
+        buf_ += "*I";
     }
 }
 
 void StrPrinter::bvisit(const Interval &x)
 {
-    std::ostringstream s;
     if (x.left_open_)
-        s << "(";
+        buf_ += "(";
     else
-        s << "[";
-    s << *x.start_ << ", " << *x.end_;
+        buf_ += "[";
+    print(*x.start_);
+    buf_ += ", ";
+    print(*x.end_);
     if (x.right_open_)
-        s << ")";
+        buf_ += ")";
     else
-        s << "]";
-    str_ = s.str();
+        buf_ += "]";
 }
 
 void StrPrinter::bvisit(const EmptySet &x)
 {
-    str_ = "EmptySet";
+    buf_ += "EmptySet";
 }
 
 void StrPrinter::bvisit(const UniversalSet &x)
 {
-    str_ = "UniversalSet";
+    buf_ += "UniversalSet";
 }
 
 void StrPrinter::bvisit(const FiniteSet &x)
 {
-    std::ostringstream s;
-    s << x.container_;
-    str_ = s.str();
+    buf_ += "{";
+    for (auto p = x.container_.begin(); p != x.container_.end(); p++) {
+        if (p != x.container_.begin())
+            buf_ += ", ";
+        print(**p);
+    }
+    buf_ += "}";
 }
 
 #ifdef HAVE_SYMENGINE_MPFR
@@ -146,149 +270,147 @@ void StrPrinter::bvisit(const RealMPFR &x)
     mpfr_exp_t ex;
     char *c = mpfr_get_str(nullptr, &ex, 10, 0, x.i.get_mpfr_t(), MPFR_RNDN);
     std::ostringstream s;
-    str_ = std::string(c);
-    if (str_.at(0) == '-') {
+    std::string str(c);
+    if (str.at(0) == '-') {
         s << '-';
-        str_ = str_.substr(1, str_.length() - 1);
+        str = str.substr(1, str.length() - 1);
     }
     if (ex > 6) {
-        s << str_.at(0) << '.' << str_.substr(1, str_.length() - 1) << 'e'
+        s << str.at(0) << '.' << str.substr(1, str.length() - 1) << 'e'
           << (ex - 1);
     } else if (ex > 0) {
-        s << str_.substr(0, (unsigned long)ex) << ".";
-        s << str_.substr((unsigned long)ex, str_.length() - ex);
+        s << str.substr(0, (unsigned long)ex) << ".";
+        s << str.substr((unsigned long)ex, str.length() - ex);
     } else if (ex > -5) {
         s << "0.";
         for (int i = 0; i < -ex; ++i) {
             s << '0';
         }
-        s << str_;
+        s << str;
     } else {
-        s << str_.at(0) << '.' << str_.substr(1, str_.length() - 1) << 'e'
+        s << str.at(0) << '.' << str.substr(1, str.length() - 1) << 'e'
           << (ex - 1);
     }
     mpfr_free_str(c);
-    str_ = s.str();
+    buf_ += s.str();
 }
 #endif
 #ifdef HAVE_SYMENGINE_MPC
 void StrPrinter::bvisit(const ComplexMPC &x)
 {
     RCP<const Number> imag = x.imaginary_part();
+    print(*x.real_part());
     if (imag->is_negative()) {
-        std::string str = this->apply(imag);
-        str = str.substr(1, str.length() - 1);
-        str_ = this->apply(x.real_part()) + " - " + str + "*I";
+        buf_ += " - ";
+        std::size_t mark = buf_.size();
+        print(*imag);
+        // drop the sign of the imaginary part
+        buf_.erase(mark, 1);
     } else {
-        str_ = this->apply(x.real_part()) + " + " + this->apply(imag) + "*I";
+        buf_ += " + ";
+        print(*imag);
     }
+    buf_ += "*I";
 }
 #endif
 void StrPrinter::bvisit(const Add &x)
 {
-    std::ostringstream o;
     bool first = true;
-    std::map<RCP<const Basic>, RCP<const Number>, RCPBasicKeyLessCmp> dict(
-        x.dict_.begin(), x.dict_.end());
-
     if (neq(*(x.coef_), *zero)) {
-        o << this->apply(x.coef_);
+        print(*x.coef_);
         first = false;
     }
-    for (const auto &p : dict) {
-        std::string t;
-        if (eq(*(p.second), *one)) {
-            t = this->apply(p.first);
-        } else if (eq(*(p.second), *minus_one)) {
-            t = "-" + parenthesizeLT(p.first, PrecedenceEnum::Mul);
-        } else {
-            t = parenthesizeLT(p.second, PrecedenceEnum::Mul) + "*"
-                + parenthesizeLT(p.first, PrecedenceEnum::Mul);
-        }
-
+    for (const auto *p : sorted_terms(x.dict_)) {
+        std::size_t mark = buf_.size();
         if (not first) {
-            if (t[0] == '-') {
-                o << " - " << t.substr(1);
-            } else {
-                o << " + " << t;
-            }
+            buf_ += " + ";
+        }
+        std::size_t term = buf_.size();
+        if (eq(*(p->second), *one)) {
+            print(*p->first);
+        } else if (eq(*(p->second), *minus_one)) {
+            buf_ += "-";
+            printParenthesizedLT(p->first, PrecedenceEnum::Mul);
         } else {
-            o << t;
-            first = false;
+            printParenthesizedLT(p->second, PrecedenceEnum::Mul);
+            buf_ += "*";
+            printParenthesizedLT(p->first, PrecedenceEnum::Mul);
         }
+        // turn " + -t" into " - t"
+        if (not first and buf_.size() > term and buf_[term] == '-') {
+            buf_[mark + 1] = '-';
+            buf_.erase(term, 1);
+        }
+        first = false;
     }
-    str_ = o.str();
 }
 
 void StrPrinter::bvisit(const Mul &x)
 {
-    std::ostringstream o, o2;
     bool num = false;
     unsigned den = 0;
-    std::map<RCP<const Basic>, RCP<const Basic>, RCPBasicKeyLessCmp> dict(
-        x.dict_.begin(), x.dict_.end());
+    auto dict = sorted_terms(x.dict_);
+    auto is_den = [](const RCP<const Basic> &e) {
+        return (is_a<Integer>(*e)
+                and rcp_static_cast<const Integer>(e)->is_negative())
+               || (is_a<Rational>(*e)
+                   and rcp_static_cast<const Rational>(e)->is_negative());
+    };
 
     if (eq(*(x.coef_), *minus_one)) {
-        o << "-";
+        buf_ += "-";
     } else if (neq(*(x.coef_), *one)) {
-        o << parenthesizeLT(x.coef_, PrecedenceEnum::Mul) << "*";
+        printParenthesizedLT(x.coef_, PrecedenceEnum::Mul);
+        buf_ += "*";
         num = true;
     }
 
-    for (const auto &p : dict) {
-        if ((is_a<Integer>(*p.second)
-             and rcp_static_cast<const Integer>(p.second)->is_negative())
-            || (is_a<Rational>(*p.second)
-                and rcp_static_cast<const Rational>(p.second)->is_negative())) {
-            if (eq(*(p.second), *minus_one)) {
-                o2 << parenthesizeLT(p.first, PrecedenceEnum::Mul);
-            } else {
-                o2 << parenthesizeLE(p.first, PrecedenceEnum::Pow);
-                o2 << "**";
-                o2 << parenthesizeLE(neg(p.second), PrecedenceEnum::Pow);
-            }
-            o2 << "*";
+    for (const auto *p : dict) {
+        if (is_den(p->second)) {
             den++;
+            continue;
+        }
+        if (eq(*(p->second), *one)) {
+            printParenthesizedLT(p->first, PrecedenceEnum::Mul);
         } else {
-            if (eq(*(p.second), *one)) {
-                o << parenthesizeLT(p.first, PrecedenceEnum::Mul);
-            } else {
-                o << parenthesizeLE(p.first, PrecedenceEnum::Pow);
-                o << "**";
-                o << parenthesizeLE(p.second, PrecedenceEnum::Pow);
-            }
-            o << "*";
-            num = true;
+            printParenthesizedLE(p->first, PrecedenceEnum::Pow);
+            buf_ += "**";
+            printParenthesizedLE(p->second, PrecedenceEnum::Pow);
         }
+        buf_ += "*";
+        num = true;
     }
 
     if (not num) {
-        o << "1*";
+        buf_ += "1*";
     }
+    buf_.pop_back();
 
-    std::string s = o.str();
-    s = s.substr(0, s.size() - 1);
-
-    if (den != 0) {
-        std::string s2 = o2.str();
-        s2 = s2.substr(0, s2.size() - 1);
-        if (den > 1) {
-            str_ = s + "/(" + s2 + ")";
+    if (den == 0)
+        return;
+    buf_ += (den > 1) ? "/(" : "/";
+    for (const auto *p : dict) {
+        if (not is_den(p->second))
+            continue;
+        if (eq(*(p->second), *minus_one)) {
+            printParenthesizedLT(p->first, PrecedenceEnum::Mul);
         } else {
-            str_ = s + "/" + s2;
+            printParenthesizedLE(p->first, PrecedenceEnum::Pow);
+            buf_ += "**";
+            printParenthesizedLE(neg(p->second), PrecedenceEnum::Pow);
         }
-    } else {
-        str_ = s;
+        buf_ += "*";
     }
+    buf_.pop_back();
+    if (den > 1)
+        buf_ += ")";
 }
 
 void StrPrinter::bvisit(const Pow &x)
 {
-    std::ostringstream o;
-    o << parenthesizeLE(x.get_base(), PrecedenceEnum::Pow);
-    o << "**";
-    o << parenthesizeLE(x.get_exp(), PrecedenceEnum::Pow);
-    str_ = o.str();
+    printParenthesizedLE(x.get_base(), PrecedenceEnum::Pow);
+    buf_ += "**";
+    printParenthesizedLE(x.get_exp(), PrecedenceEnum::Pow);
 }
 
 char _print_sign(const integer_class &i)
@@ -304,7 +426,7 @@ char _print_sign(const integer_class &i)
 // that there is compatibility
 void StrPrinter::bvisit(const UnivariateIntPolynomial &x)
 {
-    std::ostringstream s;
+    const std::string &var = x.get_var()->get_name();
     // bool variable needed to take care of cases like -5, -x, -3*x etc.
     bool first = true;
     // we iterate over the map in reverse order so that highest degree gets
@@ -313,10 +435,12 @@ void StrPrinter::bvisit(const UnivariateIntPolynomial &x)
         // if exponent is 0, then print only coefficient
         if (it->first == 0) {
             if (first) {
-                s << it->second;
+                print_integer(it->second);
             } else {
-                s << " " << _print_sign(it->second) << " "
-                  << mp_abs(it->second);
+                buf_ += ' ';
+                buf_ += _print_sign(it->second);
+                buf_ += ' ';
+                print_integer(mp_abs(it->second));
             }
             first = false;
             continue;
@@ -327,11 +451,13 @@ void StrPrinter::bvisit(const UnivariateIntPolynomial &x)
             // in cases of x**2 - x, print - x
             if (first) {
                 if (it->second == -1)
-                    s << "-";
-                s << x.get_var()->get_name();
+                    buf_ += "-";
+                buf_ += var;
             } else {
-                s << " " << _print_sign(it->second) << " "
-                  << x.get_var()->get_name();
+                buf_ += ' ';
+                buf_ += _print_sign(it->second);
+                buf_ += ' ';
+                buf_ += var;
             }
         }
         // same logic is followed as above
@@ -339,34 +465,36 @@ void StrPrinter::bvisit(const UnivariateIntPolynomial &x)
             // in cases of -2*x, print -2*x
             // in cases of x**2 - 2*x, print - 2*x
             if (first) {
-                s << it->second << "*" << x.get_var()->get_name();
+                print_integer(it->second);
             } else {
-                s << " " << _print_sign(it->second) << " " << mp_abs(it->second)
-                  << "*" << x.get_var()->get_name();
+                buf_ += ' ';
+                buf_ += _print_sign(it->second);
+                buf_ += ' ';
+                print_integer(mp_abs(it->second));
             }
+            buf_ += "*";
+            buf_ += var;
         }
         // if exponent is not 1, print the exponent;
         if (it->first != 1) {
-            s << "**" << it->first;
+            buf_ += "**";
+            buf_ += std::to_string(it->first);
         }
         // corner cases of only first term handled successfully, switch the bool
         first = false;
     }
     if (x.get_dict().size() == 0)
-        s << "0";
-    str_ = s.str();
+        buf_ += "0";
 }
 
 // UnivariatePolynomial printing, tests taken from SymPy and printing ensures
 // that there is compatibility
 void StrPrinter::bvisit(const UnivariatePolynomial &x)
 {
-    std::ostringstream s;
     if (x.get_dict().size() == 0)
-        s << "0";
+        buf_ += "0";
     else
-        s << x.get_poly().__str__(x.get_var()->get_name());
-    str_ = s.str();
+        buf_ += x.get_poly().__str__(x.get_var()->get_name());
 }
 
 void StrPrinter::bvisit(const UnivariateSeries &x)
@@ -374,7 +502,7 @@ void StrPrinter::bvisit(const UnivariateSeries &x)
     std::ostringstream o;
     o << x.get_poly().__str__(x.get_var()) << " + O(" << x.get_var() << "**"
       << x.get_degree() << ")";
-    str_ = o.str();
+    buf_ += o.str();
 }
 
 #ifdef HAVE_SYMENGINE_PIRANHA
@@ -383,96 +511,97 @@ void StrPrinter::bvisit(const URatPSeriesPiranha &x)
     std::ostringstream o;
     o << x.get_poly() << " + O(" << x.get_var() << "**" << x.get_degree()
       << ")";
-    str_ = o.str();
+    buf_ += o.str();
 }
 void StrPrinter::bvisit(const UPSeriesPiranha &x)
 {
     std::ostringstream o;
     o << x.get_poly() << " + O(" << x.get_var() << "**" << x.get_degree()
       << ")";
-    str_ = o.str();
+    buf_ += o.str();
 }
 #endif
 
 void StrPrinter::bvisit(const Log &x)
 {
-    str_ = "log(" + this->apply(x.get_arg()) + ")";
+    buf_ += "log(";
+    print(*x.get_arg());
+    buf_ += ")";
 }
 
 void StrPrinter::bvisit(const Constant &x)
 {
-    str_ = x.get_name();
+    buf_ += x.get_name();
 }
 
 std::string StrPrinter::apply(const vec_basic &d)
 {
-    std::ostringstream o;
-    for (auto p = d.begin(); p != d.end(); p++) {
-        if (p != d.begin()) {
-            o << ", ";
-        }
-        o << this->apply(*p);
-    }
-    return o.str();
+    std::size_t mark = buf_.size();
+    print_args(d);
+    std::string s = buf_.substr(mark);
+    buf_.resize(mark);
+    return s;
 }
+
 void StrPrinter::bvisit(const Function &x)
 {
-    std::ostringstream o;
-    o << names_[x.get_type_code()];
-    o << "(";
-    vec_basic vec = x.get_args();
-    o << this->apply(vec) << ")";
-    str_ = o.str();
+    buf_ += names_[x.get_type_code()];
+    buf_ += "(";
+    print_args(x.get_args());
+    buf_ += ")";
 }
 
 void StrPrinter::bvisit(const FunctionSymbol &x)
 {
-    std::ostringstream o;
-    o << x.get_name();
-    o << "(";
-    vec_basic vec = x.get_args();
-    o << this->apply(vec) << ")";
-    str_ = o.str();
+    buf_ += x.get_name();
+    buf_ += "(";
+    print_args(x.get_args());
+    buf_ += ")";
 }
 
 void StrPrinter::bvisit(const Derivative &x)
 {
-    std::ostringstream o;
-    o << "Derivative(" << this->apply(x.get_arg());
+    buf_ += "Derivative(";
+    print(*x.get_arg());
     multiset_basic m1 = x.get_symbols();
-    std::multiset<RCP<const Basic>, RCPBasicKeyLessCmp> m2(m1.begin(),
-                                                           m1.end());
+    vec_basic m2(m1.begin(), m1.end());
+    std::stable_sort(m2.begin(), m2.end(), [](const RCP<const Basic> &a,
+                                              const RCP<const Basic> &b) {
+        return a->__cmp__(*b) == -1;
+    });
     for (const auto &elem : m2) {
-        o << ", " << this->apply(elem);
+        buf_ += ", ";
+        print(*elem);
     }
-    o << ")";
-    str_ = o.str();
+    buf_ += ")";
 }
 
 void StrPrinter::bvisit(const Subs &x)
 {
-    std::ostringstream o, vars, point;
-    for (auto p = x.get_dict().begin(); p != x.dict_.end(); p++) {
-        if (p != x.get_dict().begin()) {
-            vars << ", ";
-            point << ", ";
-        }
-        vars << apply(p->first);
-        point << apply(p->second);
+    buf_ += "Subs(";
+    print(*x.arg_);
+    buf_ += ", (";
+    for (auto p = x.get_dict().begin(); p != x.get_dict().end(); p++) {
+        if (p != x.get_dict().begin())
+            buf_ += ", ";
+        print(*p->first);
+    }
+    buf_ += "), (";
+    for (auto p = x.get_dict().begin(); p != x.get_dict().end(); p++) {
+        if (p != x.get_dict().begin())
+            buf_ += ", ";
+        print(*p->second);
     }
-    o << "Subs(" << apply(x.arg_) << ", (" << vars.str() << "), ("
-      << point.str() << "))";
-    str_ = o.str();
+    buf_ += "))";
 }
 
 void StrPrinter::bvisit(const NumberWrapper &x)
 {
-    str_ = x.__str__();
+    buf_ += x.__str__();
 }
 
 void StrPrinter::bvisit(const MultivariateIntPolynomial &x)
 {
-    std::ostringstream s;
     bool first = true; // is this the first term being printed out?
     // To change the ordering in which the terms will print out, change
     // vec_uint_compare in dict.h
@@ -481,46 +610,46 @@ void StrPrinter::bvisit(const MultivariateIntPolynomial &x)
     for (vec_uint exps : v) {
         integer_class c = x.dict_.find(exps)->second;
         if (!first) {
-            s << " " << _print_sign(c) << " ";
+            buf_ += ' ';
+            buf_ += _print_sign(c);
+            buf_ += ' ';
         } else if (c < 0) {
-            s << "-";
+            buf_ += "-";
         }
 
         unsigned int i = 0;
-        std::ostringstream expr;
+        std::string expr;
         bool first_var = true;
         for (auto it : x.vars_) {
             if (exps[i] != 0) {
                 if (!first_var) {
-                    expr << "*";
+                    expr += "*";
                 }
-                expr << it->__str__();
+                expr += it->__str__();
                 if (exps[i] > 1)
-                    expr << "**" << exps[i];
+                    expr += "**" + std::to_string(exps[i]);
                 first_var = false;
             }
             i++;
         }
         if (mp_abs(c) != 1) {
-            s << mp_abs(c);
-            if (!expr.str().empty()) {
-                s << "*";
+            print_integer(mp_abs(c));
+            if (!expr.empty()) {
+                buf_ += "*";
             }
-        } else if (expr.str().empty()) {
-            s << "1";
+        } else if (expr.empty()) {
+            buf_ += "1";
         }
-        s << expr.str();
+        buf_ += expr;
         first = false;
     }
 
-    if (s.str().empty())
-        s << "0";
-    str_ = s.str();
+    if (first)
+        buf_ += "0";
 }
 
 void StrPrinter::bvisit(const MultivariatePolynomial &x)
 {
-    std::ostringstream s;
     bool first = true; // is this the first term being printed out?
     // To change the ordering in which the terms will print out, change
     // vec_uint_compare in dict.h
@@ -530,41 +659,64 @@ void StrPrinter::bvisit(const MultivariatePolynomial &x)
         Expression c = x.dict_.find(exps)->second;
         std::string t = parenthesizeLT(c.get_basic(), PrecedenceEnum::Mul);
         if ('-' == t[0] && !first) {
-            s << " - ";
+            buf_ += " - ";
             t = t.substr(1);
         } else if (!first) {
-            s << " + ";
+            buf_ += " + ";
         }
         unsigned int i = 0;
-        std::ostringstream expr;
+        std::string expr;
         bool first_var = true;
         for (auto it : x.vars_) {
             if (exps[i] != 0) {
                 if (!first_var) {
-                    expr << "*";
+                    expr += "*";
                 }
-                expr << it->__str__();
+                expr += it->__str__();
                 if (exps[i] > 1)
-                    expr << "**" << exps[i];
+                    expr += "**" + std::to_string(exps[i]);
                 first_var = false;
             }
             i++;
         }
         if (c != 1 && c != -1) {
-            s << t;
-            if (!expr.str().empty()) {
-                s << "*";
+            buf_ += t;
+            if (!expr.empty()) {
+                buf_ += "*";
             }
-        } else if (expr.str().empty()) {
-            s << "1";
+        } else if (expr.empty()) {
+            buf_ += "1";
         }
-        s << expr.str();
+        buf_ += expr;
         first = false;
     }
 
-    if (s.str().empty())
-        s << "0";
-    str_ = s.str();
+    if (first)
+        buf_ += "0";
+}
+
+void StrPrinter::printParenthesizedLT(const RCP<const Basic> &x,
+                                      PrecedenceEnum prec)
+{
+    Precedence p;
+    bool paren = p.getPrecedence(x) < prec;
+    if (paren)
+        buf_ += "(";
+    print(*x);
+    if (paren)
+        buf_ += ")";
+}
+
+void StrPrinter::printParenthesizedLE(const RCP<const Basic> &x,
+                                      PrecedenceEnum prec)
+{
+    Precedence p;
+    bool paren = p.getPrecedence(x) <= prec;
+    if (paren)
+        buf_ += "(";
+    print(*x);
+    if (paren)
+        buf_ += ")";
 }
 
 std::string StrPrinter::parenthesizeLT(const RCP<const Basic> &x,
@@ -589,16 +741,54 @@ std::string StrPrinter::parenthesizeLE(const RCP<const Basic> &x,
     }
 }
 
+void StrPrinter::print(const Basic &b)
+{
+    b.accept(*this);
+    // visitors of derived printers may set str_ instead of appending
+    if (not str_.empty()) {
+        buf_ += str_;
+        str_.clear();
+    }
+}
+
+void StrPrinter::print(const Basic &b, std::FILE *out)
+{
+    clear_buffer();
+    print(b);
+    write_all(out, buf_);
+    clear_buffer();
+}
+
+void StrPrinter::print(const Basic &b, int fd)
+{
+    clear_buffer();
+    print(b);
+    write_all(fd, buf_);
+    clear_buffer();
+}
+
+void StrPrinter::print_lines(const vec_basic &v, std::FILE *out)
+{
+    print_lines_to(*this, buf_, v, out);
+}
+
+void StrPrinter::print_lines(const vec_basic &v, int fd)
+{
+    print_lines_to(*this, buf_, v, fd);
+}
+
 std::string StrPrinter::apply(const RCP<const Basic> &b)
 {
-    b->accept(*this);
-    return str_;
+    return apply(*b);
 }
 
 std::string StrPrinter::apply(const Basic &b)
 {
-    b.accept(*this);
-    return str_;
+    std::size_t mark = buf_.size();
+    print(b);
+    std::string s = buf_.substr(mark);
+    buf_.resize(mark);
+    return s;
 }
 
 std::vector<std::string> init_str_printer_names()
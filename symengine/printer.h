@@ -1,6 +1,7 @@
 #ifndef SYMENGINE_PRINTER_H
 #define SYMENGINE_PRINTER_H
 
+#include <cstdio>
 #include <symengine/visitor.h>
 
 namespace SymEngine
@@ -202,11 +203,25 @@ public:
     }
 };
 
+//! Prints expressions in the syntax of SymPy. All visitors append to a single
+//! output buffer, so printing an expression does not build a string for every
+//! node. Visitors of derived printers may still set `str_` instead, which is
+//! then appended to the buffer.
 class StrPrinter : public BaseVisitor<StrPrinter>
 {
 protected:
+    //! the output buffer
+    std::string buf_;
     std::string str_;
 
+    void print_integer(const integer_class &i);
+    void print_rational(const rational_class &i);
+    void print_args(const vec_basic &v);
+    //! Prints `x`, in parentheses if its precedence is lower than `prec`
+    void printParenthesizedLT(const RCP<const Basic> &x, PrecedenceEnum prec);
+    //! Prints `x`, in parentheses if its precedence is not higher than `prec`
+    void printParenthesizedLE(const RCP<const Basic> &x, PrecedenceEnum prec);
+
 public:
     static const std::vector<std::string> names_;
     void bvisit(const Basic &x);
@@ -251,6 +266,26 @@ public:
     std::string parenthesizeLE(const RCP<const Basic> &x,
                                PrecedenceEnum precedenceEnum);
 
+    //! Appends `b` to the output buffer
+    void print(const Basic &b);
+    const std::string &get_buffer() const
+    {
+        return buf_;
+    }
+    void clear_buffer()
+    {
+        buf_.clear();
+    }
+
+    //! Prints `b` to `out`
+    void print(const Basic &b, std::FILE *out);
+    //! Prints `b` to the file descriptor `fd`
+    void print(const Basic &b, int fd);
+    //! Prints the expressions `v` to `out`, one per line. The output is
+    //! written in large blocks as the buffer fills up.
+    void print_lines(const vec_basic &v, std::FILE *out);
+    void print_lines(const vec_basic &v, int fd);
+
     std::string apply(const RCP<const Basic> &b);
     std::string apply(const vec_basic &v);
     std::string apply(const Basic &b);
@@ -5,6 +5,7 @@
 #include <symengine/symbol.h>
 #include <symengine/rings.h>
 #include <symengine/monomials.h>
+#include <symengine/rational.h>
 
 namespace SymEngine
 {
@@ -103,4 +104,243 @@ void poly_mul(const umap_vec_mpz &A, const umap_vec_mpz &B, umap_vec_mpz &C)
     */
 }
 
+namespace
+{
+// Collects the terms of an expanded expression as exponent vectors over the
+// generators, numbered in the order in which they are first met.
+class PolyTermCollector
+{
+public:
+    vec_basic gens_;
+    std::vector<std::pair<vec_uint, rational_class>> terms_;
+
+    void collect(const RCP<const Basic> &p)
+    {
+        if (is_a<Add>(*p)) {
+            const Add &a = static_cast<const Add &>(*p);
+            terms_.reserve(a.dict_.size() + 1);
+            if (not a.coef_->is_zero()) {
+                terms_.push_back({vec_uint(), rational_class(0)});
+                get_rational(*a.coef_, terms_.back().second);
+            }
+            for (const auto &t : a.dict_)
+                add_term(t.first, *t.second);
+        } else if (is_a_Number(*p)) {
+            terms_.push_back({vec_uint(), rational_class(0)});
+            get_rational(static_cast<const Number &>(*p),
+                         terms_.back().second);
+        } else {
+            add_term(p, *one);
+        }
+    }
+
+private:
+    umap_basic_uint index_;
+
+    static void get_rational(const Number &c, rational_class &r)
+    {
+        if (is_a<Integer>(c)) {
+            r = static_cast<const Integer &>(c).i;
+        } else if (is_a<Rational>(c)) {
+            r = static_cast<const Rational &>(c).i;
+        } else {
+            throw std::runtime_error("Coefficients must be rational numbers.");
+        }
+    }
+
+    unsigned int generator(const RCP<const Basic> &g)
+    {
+        auto it = index_.find(g);
+        if (it != index_.end())
+            return it->second;
+        unsigned int i = gens_.size();
+        index_.insert(std::make_pair(g, i));
+        gens_.push_back(g);
+        return i;
+    }
+
+    void add_factor(vec_uint &v, const RCP<const Basic> &base,
+                    const RCP<const Basic> &exp)
+    {
+        unsigned int i, e;
+        if (is_a<Integer>(*exp)
+            and static_cast<const Integer &>(*exp).is_positive()
+            and mp_fits_ulong_p(static_cast<const Integer &>(*exp).i)) {
+            i = generator(base);
+            e = mp_get_ui(static_cast<const Integer &>(*exp).i);
+        } else {
+            i = generator(pow(base, exp));
+            e = 1;
+        }
+        if (i >= v.size())
+            v.resize(i + 1, 0);
+        v[i] += e;
+    }
+
+    void add_term(const RCP<const Basic> &term, const Number &coef)
+    {
+        terms_.push_back({vec_uint(), rational_class(0)});
+        vec_uint &v = terms_.back().first;
+        rational_class &c = terms_.back().second;
+        get_rational(coef, c);
+        if (is_a<Mul>(*term)) {
+            const Mul &m = static_cast<const Mul &>(*term);
+            rational_class t;
+            get_rational(*m.coef_, t);
+            c *= t;
+            for (const auto &f : m.dict_)
+                add_factor(v, f.first, f.second);
+        } else if (is_a<Pow>(*term)) {
+            const Pow &q = static_cast<const Pow &>(*term);
+            add_factor(v, q.get_base(), q.get_exp());
+        } else {
+            add_factor(v, term, one);
+        }
+    }
+};
+
+// Least common denominator of the collected coefficients
+integer_class common_denominator(const PolyTermCollector &c)
+{
+    integer_class den(1);
+    for (const auto &t : c.terms_)
+        mp_lcm(den, den, get_den(t.second));
+    return den;
+}
+
+// A generator that can be used as a base in `Mul` and `Pow` directly
+bool is_plain_generator(const Basic &g)
+{
+    return not(is_a_Number(g) or is_a<Add>(g) or is_a<Mul>(g)
+               or is_a<Pow>(g));
+}
+
+RCP<const Number> make_coef(const integer_class &c, const integer_class &den)
+{
+    if (den == 1)
+        return integer(c);
+    rational_class q(c, den);
+    canonicalize(q);
+    return Rational::from_mpq(std::move(q));
+}
+}
+
+RCP<const MultivariateIntPolynomial> basic_to_poly(const RCP<const Basic> &p,
+                                                   integer_class &den)
+{
+    PolyTermCollector c;
+    c.collect(p);
+    den = common_denominator(c);
+    unsigned int n = c.gens_.size();
+    umap_uvec_mpz d;
+    d.reserve(c.terms_.size());
+    integer_class t;
+    for (auto &term : c.terms_) {
+        term.first.resize(n, 0);
+        mp_divexact(t, den, get_den(term.second));
+        t *= get_num(term.second);
+        d[term.first] += t;
+    }
+    return MultivariateIntPolynomial::create(c.gens_, std::move(d));
+}
+
+RCP<const MultivariateIntPolynomial> basic_to_poly(const RCP<const Basic> &p)
+{
+    integer_class den;
+    RCP<const MultivariateIntPolynomial> r = basic_to_poly(p, den);
+    if (den != 1)
+        throw std::runtime_error("Coefficients must be integers.");
+    return r;
+}
+
+RCP<const UnivariateIntPolynomial> basic_to_poly(const RCP<const Basic> &p,
+                                                 const RCP<const Symbol> &x,
+                                                 integer_class &den)
+{
+    PolyTermCollector c;
+    c.collect(p);
+    if (c.gens_.size() > 1 or (c.gens_.size() == 1 and neq(*c.gens_[0], *x)))
+        throw std::runtime_error("Expression is not a polynomial in "
+                                 + x->get_name() + ".");
+    den = common_denominator(c);
+    map_uint_mpz d;
+    integer_class t;
+    for (const auto &term : c.terms_) {
+        mp_divexact(t, den, get_den(term.second));
+        t *= get_num(term.second);
+        d[term.first.empty() ? 0 : term.first[0]] += t;
+    }
+    return UnivariateIntPolynomial::from_dict(x, UIntDict(d));
+}
+
+RCP<const Basic> poly_to_basic(const MultivariateIntPolynomial &p,
+                               const integer_class &den)
+{
+    vec_basic gens(p.vars_.begin(), p.vars_.end());
+    bool plain = true;
+    for (const auto &g : gens)
+        plain = plain and is_plain_generator(*g);
+
+    if (not plain) {
+        // Powers of these generators need canonicalization, e.g.
+        // `(x**(1/2))**2`, so build the terms through the usual functions.
+        vec_basic terms;
+        terms.reserve(p.dict_.size());
+        for (const auto &t : p.dict_) {
+            vec_basic factors = {make_coef(t.second, den)};
+            for (unsigned int i = 0; i < gens.size(); i++) {
+                if (t.first[i] != 0)
+                    factors.push_back(pow(gens[i], integer(t.first[i])));
+            }
+            terms.push_back(mul(factors));
+        }
+        return add(terms);
+    }
+
+    // The monomials are distinct, so the `Add` can be built directly
+    RCP<const Number> coef = zero;
+    umap_basic_num d;
+    d.reserve(p.dict_.size());
+    for (const auto &t : p.dict_) {
+        RCP<const Number> c = make_coef(t.second, den);
+        map_basic_basic m;
+        for (unsigned int i = 0; i < gens.size(); i++) {
+            if (t.first[i] != 0)
+                insert(m, gens[i], integer(t.first[i]));
+        }
+        if (m.empty()) {
+            coef = c;
+        } else if (m.size() == 1) {
+            auto f = m.begin();
+            if (eq(*f->second, *one)) {
+                insert(d, f->first, c);
+            } else {
+                insert(d, make_rcp<const Pow>(f->first, f->second), c);
+            }
+        } else {
+            insert(d, make_rcp<const Mul>(one, std::move(m)), c);
+        }
+    }
+    return Add::from_dict(coef, std::move(d));
+}
+
+RCP<const Basic> poly_to_basic(const UnivariateIntPolynomial &p,
+                               const integer_class &den)
+{
+    RCP<const Number> coef = zero;
+    umap_basic_num d;
+    d.reserve(p.get_dict().size());
+    for (const auto &t : p.get_dict()) {
+        RCP<const Number> c = make_coef(t.second, den);
+        if (t.first == 0) {
+            coef = c;
+        } else if (t.first == 1) {
+            insert(d, p.get_var(), c);
+        } else {
+            insert(d, make_rcp<const Pow>(p.get_var(), integer(t.first)), c);
+        }
+    }
+    return Add::from_dict(coef, std::move(d));
+}
+
 } // SymEngine
@@ -8,6 +8,8 @@
 
 #include <symengine/basic.h>
 #include <symengine/dict.h>
+#include <symengine/polynomial.h>
+#include <symengine/polynomial_multivariate.h>
 
 namespace SymEngine
 {
@@ -19,6 +21,27 @@ void expr2poly(const RCP<const Basic> &p, umap_basic_num &syms,
 //! Multiply two polynomials: `C = A*B`
 void poly_mul(const umap_vec_mpz &A, const umap_vec_mpz &B, umap_vec_mpz &C);
 
+//! Converts the expanded expression `p` into a polynomial such that
+//! `p = poly / den`, where `den` is the least common denominator of the
+//! coefficients. The generators are detected automatically: every base raised
+//! to a positive integer power is a generator, and any other power is a
+//! generator on its own (e.g. `x`, `sin(y)` and `z**(1/2)`).
+RCP<const MultivariateIntPolynomial> basic_to_poly(const RCP<const Basic> &p,
+                                                   integer_class &den);
+//! Same as above, but throws if the coefficients of `p` are not integers
+RCP<const MultivariateIntPolynomial> basic_to_poly(const RCP<const Basic> &p);
+//! Converts the expanded expression `p` into a polynomial in `x` such that
+//! `p = poly / den`. Throws if `p` contains any other generator.
+RCP<const UnivariateIntPolynomial> basic_to_poly(const RCP<const Basic> &p,
+                                                 const RCP<const Symbol> &x,
+                                                 integer_class &den);
+
+//! \return the expanded expression `p / den`
+RCP<const Basic> poly_to_basic(const MultivariateIntPolynomial &p,
+                               const integer_class &den = integer_class(1));
+RCP<const Basic> poly_to_basic(const UnivariateIntPolynomial &p,
+                               const integer_class &den = integer_class(1));
+
 } // SymEngine
 
 #endif
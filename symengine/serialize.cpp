@@ -0,0 +1,1204 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <tuple>
+#include <symengine/serialize.h>
+#include <symengine/visitor.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SymEngine
+{
+
+namespace
+{
+
+// Tags of the nodes in the stream. They are numbered as if all optional
+// types were enabled, so that the format does not depend on the build.
+#define SYMENGINE_INCLUDE_ALL
+#define SYMENGINE_ENUM(type, Class) SERIAL_##type,
+enum SerialTag {
+#include "symengine/type_codes.inc"
+    SERIAL_TAG_COUNT
+};
+#undef SYMENGINE_ENUM
+#undef SYMENGINE_INCLUDE_ALL
+
+const char serial_magic[8] = {'S', 'Y', 'M', 'E', 'N', 'G', 'D', 'G'};
+const unsigned serial_version = 1;
+
+unsigned serial_tag(TypeID id)
+{
+    switch (id) {
+#define SYMENGINE_ENUM(type, Class)                                            \
+    case type:                                                                 \
+        return SERIAL_##type;
+#include "symengine/type_codes.inc"
+#undef SYMENGINE_ENUM
+        default:
+            throw std::runtime_error("serialize: unknown type");
+    }
+}
+
+// Unsigned integers are written as little endian base 128 varints
+void write_uint(std::string &out, std::uint64_t n)
+{
+    while (n >= 0x80) {
+        out.push_back(static_cast<char>((n & 0x7f) | 0x80));
+        n >>= 7;
+    }
+    out.push_back(static_cast<char>(n));
+}
+
+void write_word(std::string &out, std::uint64_t w)
+{
+    for (unsigned i = 0; i < 8; i++) {
+        out.push_back(static_cast<char>(w & 0xff));
+        w >>= 8;
+    }
+}
+
+void write_double(std::string &out, double d)
+{
+    std::uint64_t w;
+    std::memcpy(&w, &d, sizeof(w));
+    write_word(out, w);
+}
+
+void write_string(std::string &out, const std::string &s)
+{
+    write_uint(out, s.size());
+    out.append(s);
+}
+
+// An integer is the number of 64-bit limbs shifted left by one and or'ed with
+// the sign bit, followed by the limbs from the least significant one.
+void write_mpz(std::string &out, mpz_srcptr z)
+{
+    std::size_t n = 0;
+    if (mpz_sgn(z) != 0)
+        n = (mpz_sizeinbase(z, 2) + 63) / 64;
+    write_uint(out, (static_cast<std::uint64_t>(n) << 1)
+                        | (mpz_sgn(z) < 0 ? 1 : 0));
+    std::size_t old = out.size();
+    out.resize(old + 8 * n);
+    mpz_export(&out[old], &n, -1, 8, -1, 0, z);
+}
+
+void write_integer(std::string &out, const integer_class &i)
+{
+    write_mpz(out, get_mpz_t(i));
+}
+
+void write_rational(std::string &out, const rational_class &q)
+{
+    write_integer(out, get_num(q));
+    write_integer(out, get_den(q));
+}
+
+#ifdef HAVE_SYMENGINE_MPFR
+// A floating point number is its precision and a kind, followed by the
+// mantissa and the exponent for regular numbers.
+enum MPFRKind { MPFR_REGULAR, MPFR_NAN, MPFR_INF, MPFR_ZERO };
+
+void write_mpfr(std::string &out, mpfr_srcptr x)
+{
+    write_uint(out, mpfr_get_prec(x));
+    if (mpfr_regular_p(x)) {
+        out.push_back(MPFR_REGULAR);
+        mpz_t m;
+        mpz_init(m);
+        mpfr_exp_t e = mpfr_get_z_2exp(m, x);
+        write_mpz(out, m);
+        mpz_clear(m);
+        // zigzag encoding of the exponent
+        std::uint64_t u = static_cast<std::uint64_t>(e);
+        write_uint(out, e < 0 ? ~(u << 1) : (u << 1));
+    } else if (mpfr_nan_p(x)) {
+        out.push_back(MPFR_NAN);
+    } else {
+        out.push_back(mpfr_inf_p(x) ? MPFR_INF : MPFR_ZERO);
+        out.push_back(mpfr_signbit(x) ? 1 : 0);
+    }
+}
+#endif
+
+//! Writes every unique node once, children before parents
+class DagWriter : public BaseVisitor<DagWriter>
+{
+private:
+    std::string &out_;
+    umap_basic_uint index_;
+    std::vector<std::uint64_t> offsets_;
+    std::size_t start_;
+
+    void write_tag(unsigned tag)
+    {
+        start_ = out_.size();
+        write_uint(out_, tag);
+    }
+
+    void write_node(const Basic &x, const std::vector<unsigned> &refs)
+    {
+        write_tag(serial_tag(x.get_type_code()));
+        write_uint(out_, refs.size());
+        for (unsigned r : refs)
+            write_uint(out_, r);
+    }
+
+public:
+    DagWriter(std::string &out) : out_(out)
+    {
+    }
+
+    //! \return the position of `b` in the stream, writing it if needed
+    unsigned apply(const RCP<const Basic> &b)
+    {
+        auto it = index_.find(b);
+        if (it != index_.end())
+            return it->second;
+        b->accept(*this);
+        unsigned i = index_.size();
+        index_.insert({b, i});
+        offsets_.push_back(start_);
+        return i;
+    }
+
+    unsigned size() const
+    {
+        return index_.size();
+    }
+
+    //! \return the offsets of the nodes in the output
+    const std::vector<std::uint64_t> &offsets() const
+    {
+        return offsets_;
+    }
+
+    void bvisit(const Basic &x)
+    {
+        throw std::runtime_error("serialize: " + x.__str__()
+                                 + " is not supported");
+    }
+
+    void bvisit(const Integer &x)
+    {
+        write_tag(SERIAL_INTEGER);
+        write_integer(out_, x.i);
+    }
+
+    void bvisit(const Rational &x)
+    {
+        write_tag(SERIAL_RATIONAL);
+        write_rational(out_, x.i);
+    }
+
+    void bvisit(const Complex &x)
+    {
+        write_tag(SERIAL_COMPLEX);
+        write_rational(out_, x.real_);
+        write_rational(out_, x.imaginary_);
+    }
+
+    void bvisit(const RealDouble &x)
+    {
+        write_tag(SERIAL_REAL_DOUBLE);
+        write_double(out_, x.i);
+    }
+
+    void bvisit(const ComplexDouble &x)
+    {
+        write_tag(SERIAL_COMPLEX_DOUBLE);
+        write_double(out_, x.i.real());
+        write_double(out_, x.i.imag());
+    }
+
+#ifdef HAVE_SYMENGINE_MPFR
+    void bvisit(const RealMPFR &x)
+    {
+        write_tag(SERIAL_REAL_MPFR);
+        write_mpfr(out_, x.i.get_mpfr_t());
+    }
+#endif
+
+#ifdef HAVE_SYMENGINE_MPC
+    void bvisit(const ComplexMPC &x)
+    {
+        write_tag(SERIAL_COMPLEX_MPC);
+        write_mpfr(out_, mpc_realref(x.i.get_mpc_t()));
+        write_mpfr(out_, mpc_imagref(x.i.get_mpc_t()));
+    }
+#endif
+
+    void bvisit(const Symbol &x)
+    {
+        write_tag(SERIAL_SYMBOL);
+        write_string(out_, x.get_name());
+    }
+
+    void bvisit(const Constant &x)
+    {
+        write_tag(SERIAL_CONSTANT);
+        write_string(out_, x.get_name());
+    }
+
+    void bvisit(const Add &x)
+    {
+        std::vector<unsigned> refs;
+        refs.push_back(apply(x.coef_));
+        for (const auto &p : x.dict_) {
+            refs.push_back(apply(p.first));
+            refs.push_back(apply(p.second));
+        }
+        write_node(x, refs);
+    }
+
+    void bvisit(const Mul &x)
+    {
+        std::vector<unsigned> refs;
+        refs.push_back(apply(x.coef_));
+        for (const auto &p : x.dict_) {
+            refs.push_back(apply(p.first));
+            refs.push_back(apply(p.second));
+        }
+        write_node(x, refs);
+    }
+
+    void bvisit(const Pow &x)
+    {
+        unsigned base = apply(x.get_base());
+        write_node(x, {base, apply(x.get_exp())});
+    }
+
+    void bvisit(const OneArgFunction &x)
+    {
+        write_node(x, {apply(x.get_arg())});
+    }
+
+    void bvisit(const TwoArgFunction &x)
+    {
+        unsigned a = apply(x.get_arg1());
+        write_node(x, {a, apply(x.get_arg2())});
+    }
+
+    void bvisit(const MultiArgFunction &x)
+    {
+        std::vector<unsigned> refs;
+        for (const auto &a : x.get_vec())
+            refs.push_back(apply(a));
+        write_node(x, refs);
+    }
+
+    void bvisit(const FunctionSymbol &x)
+    {
+        std::vector<unsigned> refs;
+        for (const auto &a : x.get_args())
+            refs.push_back(apply(a));
+        write_node(x, refs);
+        write_string(out_, x.get_name());
+    }
+
+    void bvisit(const FunctionWrapper &x)
+    {
+        bvisit(static_cast<const Basic &>(x));
+    }
+
+    void bvisit(const Derivative &x)
+    {
+        std::vector<unsigned> refs;
+        refs.push_back(apply(x.get_arg()));
+        for (const auto &s : x.get_symbols())
+            refs.push_back(apply(s));
+        write_node(x, refs);
+    }
+
+    void bvisit(const Subs &x)
+    {
+        std::vector<unsigned> refs;
+        refs.push_back(apply(x.get_arg()));
+        for (const auto &p : x.get_dict()) {
+            refs.push_back(apply(p.first));
+            refs.push_back(apply(p.second));
+        }
+        write_node(x, refs);
+    }
+
+    void bvisit(const EmptySet &x)
+    {
+        write_node(x, {});
+    }
+
+    void bvisit(const UniversalSet &x)
+    {
+        write_node(x, {});
+    }
+
+    void bvisit(const FiniteSet &x)
+    {
+        std::vector<unsigned> refs;
+        for (const auto &a : x.container_)
+            refs.push_back(apply(a));
+        write_node(x, refs);
+    }
+
+    void bvisit(const Interval &x)
+    {
+        unsigned start = apply(x.start_);
+        write_node(x, {start, apply(x.end_)});
+        out_.push_back(static_cast<char>((x.left_open_ ? 1 : 0)
+                                         | (x.right_open_ ? 2 : 0)));
+    }
+};
+
+inline std::uint64_t load_word(const char *p)
+{
+    std::uint64_t w = 0;
+    for (unsigned i = 0; i < 8; i++)
+        w |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i]))
+             << (8 * i);
+    return w;
+}
+
+//! Reads the primitive values of the stream `[begin_, end_)`
+class DagCursor
+{
+protected:
+    const char *begin_;
+    const char *pos_;
+    const char *end_;
+
+    DagCursor(const char *first, const char *last)
+        : begin_(first), pos_(first), end_(last)
+    {
+    }
+
+    void error(const char *msg) const
+    {
+        throw std::runtime_error(std::string("deserialize: ") + msg);
+    }
+
+    void need(std::uint64_t n) const
+    {
+        if (n > static_cast<std::uint64_t>(end_ - pos_))
+            error("unexpected end of data");
+    }
+
+    std::uint64_t read_uint()
+    {
+        std::uint64_t n = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            need(1);
+            unsigned char c = static_cast<unsigned char>(*pos_++);
+            n |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+            if (c < 0x80)
+                return n;
+        }
+        error("varint too long");
+        return 0;
+    }
+
+    unsigned char read_byte()
+    {
+        need(1);
+        return static_cast<unsigned char>(*pos_++);
+    }
+
+    void seek(std::uint64_t offset)
+    {
+        if (offset >= static_cast<std::uint64_t>(end_ - begin_))
+            error("invalid offset");
+        pos_ = begin_ + offset;
+    }
+
+    std::uint64_t read_word()
+    {
+        need(8);
+        std::uint64_t w = load_word(pos_);
+        pos_ += 8;
+        return w;
+    }
+
+    double read_double()
+    {
+        std::uint64_t w = read_word();
+        double d;
+        std::memcpy(&d, &w, sizeof(d));
+        return d;
+    }
+
+    std::string read_string()
+    {
+        std::uint64_t n = read_uint();
+        need(n);
+        std::string s(pos_, n);
+        pos_ += n;
+        return s;
+    }
+
+    void read_mpz(mpz_ptr z)
+    {
+        std::uint64_t h = read_uint();
+        std::uint64_t n = h >> 1;
+        need(n);
+        need(8 * n);
+        mpz_import(z, n, -1, 8, -1, 0, pos_);
+        pos_ += 8 * n;
+        if (h & 1)
+            mpz_neg(z, z);
+    }
+
+    integer_class read_integer()
+    {
+        mpz_t z;
+        mpz_init(z);
+        read_mpz(z);
+        integer_class i(z);
+        mpz_clear(z);
+        return i;
+    }
+
+    rational_class read_rational()
+    {
+        integer_class num = read_integer();
+        integer_class den = read_integer();
+        if (den == 0)
+            error("zero denominator");
+        rational_class q(num, den);
+        canonicalize(q);
+        return q;
+    }
+
+#ifdef HAVE_SYMENGINE_MPFR
+    void read_mpfr(mpfr_ptr x)
+    {
+        std::uint64_t prec = read_uint();
+        if (prec < MPFR_PREC_MIN or prec > MPFR_PREC_MAX)
+            error("invalid precision");
+        mpfr_set_prec(x, prec);
+        unsigned char kind = read_byte();
+        if (kind == MPFR_REGULAR) {
+            mpz_t m;
+            mpz_init(m);
+            read_mpz(m);
+            std::uint64_t u = read_uint();
+            std::int64_t e = static_cast<std::int64_t>(
+                (u & 1) ? ~(u >> 1) : (u >> 1));
+            mpfr_set_z_2exp(x, m, e, MPFR_RNDN);
+            mpz_clear(m);
+        } else if (kind == MPFR_NAN) {
+            mpfr_set_nan(x);
+        } else if (kind == MPFR_INF or kind == MPFR_ZERO) {
+            int sign = read_byte() ? -1 : 1;
+            if (kind == MPFR_INF)
+                mpfr_set_inf(x, sign);
+            else
+                mpfr_set_zero(x, sign);
+        } else {
+            error("invalid floating point number");
+        }
+    }
+#endif
+
+    std::uint64_t read_index(std::uint64_t limit)
+    {
+        std::uint64_t i = read_uint();
+        if (i >= limit)
+            error("invalid reference");
+        return i;
+    }
+};
+
+//! Rebuilds the nodes of a stream, either all of them in order or lazily
+//! through a table of node offsets, in which case only the nodes that are
+//! reached are read.
+class DagReader : public DagCursor
+{
+private:
+    vec_basic nodes_;
+    const char *offsets_;
+    std::unordered_map<std::uint64_t, RCP<const Basic>> *cache_;
+    // nodes below this index can be referenced by the node being read
+    std::uint64_t limit_;
+
+    RCP<const Basic> read_ref()
+    {
+        std::uint64_t i = read_index(limit_);
+        if (offsets_ == nullptr)
+            return nodes_[i];
+        return node(i);
+    }
+
+    RCP<const Number> number(const RCP<const Basic> &b) const
+    {
+        if (not is_a_Number(*b))
+            error("expected a number");
+        return rcp_static_cast<const Number>(b);
+    }
+
+    RCP<const Basic> read_node();
+
+public:
+    DagReader(const char *first, const char *last)
+        : DagCursor(first, last), offsets_(nullptr), cache_(nullptr),
+          limit_(0)
+    {
+    }
+
+    //! Reads nodes lazily, node `i` starts at the offset stored in the `i`-th
+    //! word of `offsets`. Nodes already read are kept in `cache`.
+    DagReader(const char *first, const char *last, const char *offsets,
+              std::unordered_map<std::uint64_t, RCP<const Basic>> &cache)
+        : DagCursor(first, last), offsets_(offsets), cache_(&cache),
+          limit_(0)
+    {
+    }
+
+    //! \return the node `i`, reading it and its children if needed
+    RCP<const Basic> node(std::uint64_t i)
+    {
+        auto it = cache_->find(i);
+        if (it != cache_->end())
+            return it->second;
+        const char *pos = pos_;
+        std::uint64_t limit = limit_;
+        seek(load_word(offsets_ + 8 * i));
+        limit_ = i;
+        RCP<const Basic> r = read_node();
+        pos_ = pos;
+        limit_ = limit;
+        cache_->insert({i, r});
+        return r;
+    }
+
+    vec_basic read()
+    {
+        need(sizeof(serial_magic));
+        if (std::memcmp(pos_, serial_magic, sizeof(serial_magic)) != 0)
+            error("not a serialized expression");
+        pos_ += sizeof(serial_magic);
+        if (read_uint() != serial_version)
+            error("unsupported version");
+        // every node takes at least one byte
+        std::uint64_t n = read_uint();
+        need(n);
+        nodes_.reserve(n);
+        for (limit_ = 0; limit_ < n; limit_++)
+            nodes_.push_back(read_node());
+        std::uint64_t nroots = read_uint();
+        need(nroots);
+        vec_basic roots;
+        roots.reserve(nroots);
+        for (std::uint64_t i = 0; i < nroots; i++)
+            roots.push_back(read_ref());
+        if (pos_ != end_)
+            error("trailing data");
+        return roots;
+    }
+};
+
+RCP<const Basic> DagReader::read_node()
+{
+    std::uint64_t tag = read_uint();
+    switch (tag) {
+        case SERIAL_INTEGER:
+            return integer(read_integer());
+        case SERIAL_RATIONAL:
+            return Rational::from_mpq(read_rational());
+        case SERIAL_COMPLEX: {
+            rational_class re = read_rational();
+            return Complex::from_mpq(re, read_rational());
+        }
+        case SERIAL_REAL_DOUBLE:
+            return real_double(read_double());
+        case SERIAL_COMPLEX_DOUBLE: {
+            double re = read_double();
+            return complex_double(std::complex<double>(re, read_double()));
+        }
+#ifdef HAVE_SYMENGINE_MPFR
+        case SERIAL_REAL_MPFR: {
+            mpfr_class x;
+            read_mpfr(x.get_mpfr_t());
+            return real_mpfr(std::move(x));
+        }
+#endif
+#ifdef HAVE_SYMENGINE_MPC
+        case SERIAL_COMPLEX_MPC: {
+            mpc_class x;
+            read_mpfr(mpc_realref(x.get_mpc_t()));
+            read_mpfr(mpc_imagref(x.get_mpc_t()));
+            return complex_mpc(std::move(x));
+        }
+#endif
+        case SERIAL_SYMBOL:
+            return symbol(read_string());
+        case SERIAL_CONSTANT: {
+            std::string name = read_string();
+            for (const auto &c : {pi, E, EulerGamma})
+                if (c->get_name() == name)
+                    return c;
+            return constant(name);
+        }
+        default:
+            break;
+    }
+
+    if (tag >= SERIAL_TAG_COUNT)
+        error("unknown tag");
+    std::uint64_t n = read_uint();
+    need(n);
+    vec_basic args;
+    args.reserve(n);
+    for (std::uint64_t i = 0; i < n; i++)
+        args.push_back(read_ref());
+
+    auto check_args = [&](bool ok) {
+        if (not ok)
+            error("invalid number of arguments");
+    };
+
+    switch (tag) {
+        case SERIAL_ADD:
+        case SERIAL_MUL: {
+            check_args(n >= 3 and n % 2 == 1);
+            RCP<const Number> coef = number(args[0]);
+            if (tag == SERIAL_ADD) {
+                umap_basic_num d;
+                for (size_t i = 1; i < n; i += 2)
+                    d.insert({args[i], number(args[i + 1])});
+                return make_rcp<const Add>(coef, std::move(d));
+            }
+            map_basic_basic d;
+            for (size_t i = 1; i < n; i += 2)
+                d.insert({args[i], args[i + 1]});
+            return make_rcp<const Mul>(coef, std::move(d));
+        }
+        case SERIAL_POW:
+            check_args(n == 2);
+            return make_rcp<const Pow>(args[0], args[1]);
+
+#define SYMENGINE_ONE_ARG(TYPE, Class)                                         \
+    case SERIAL_##TYPE:                                                        \
+        check_args(n == 1);                                                    \
+        return make_rcp<const Class>(args[0]);
+#define SYMENGINE_TWO_ARG(TYPE, Class)                                         \
+    case SERIAL_##TYPE:                                                        \
+        check_args(n == 2);                                                    \
+        return make_rcp<const Class>(args[0], args[1]);
+#define SYMENGINE_MULTI_ARG(TYPE, Class)                                       \
+    case SERIAL_##TYPE:                                                        \
+        return make_rcp<const Class>(std::move(args));
+
+            SYMENGINE_ONE_ARG(LOG, Log)
+            SYMENGINE_ONE_ARG(SIN, Sin)
+            SYMENGINE_ONE_ARG(COS, Cos)
+            SYMENGINE_ONE_ARG(TAN, Tan)
+            SYMENGINE_ONE_ARG(COT, Cot)
+            SYMENGINE_ONE_ARG(CSC, Csc)
+            SYMENGINE_ONE_ARG(SEC, Sec)
+            SYMENGINE_ONE_ARG(ASIN, ASin)
+            SYMENGINE_ONE_ARG(ACOS, ACos)
+            SYMENGINE_ONE_ARG(ASEC, ASec)
+            SYMENGINE_ONE_ARG(ACSC, ACsc)
+            SYMENGINE_ONE_ARG(ATAN, ATan)
+            SYMENGINE_ONE_ARG(ACOT, ACot)
+            SYMENGINE_ONE_ARG(SINH, Sinh)
+            SYMENGINE_ONE_ARG(CSCH, Csch)
+            SYMENGINE_ONE_ARG(COSH, Cosh)
+            SYMENGINE_ONE_ARG(SECH, Sech)
+            SYMENGINE_ONE_ARG(TANH, Tanh)
+            SYMENGINE_ONE_ARG(COTH, Coth)
+            SYMENGINE_ONE_ARG(ASINH, ASinh)
+            SYMENGINE_ONE_ARG(ACSCH, ACsch)
+            SYMENGINE_ONE_ARG(ACOSH, ACosh)
+            SYMENGINE_ONE_ARG(ATANH, ATanh)
+            SYMENGINE_ONE_ARG(ACOTH, ACoth)
+            SYMENGINE_ONE_ARG(ASECH, ASech)
+            SYMENGINE_ONE_ARG(LAMBERTW, LambertW)
+            SYMENGINE_ONE_ARG(DIRICHLET_ETA, Dirichlet_eta)
+            SYMENGINE_ONE_ARG(ERF, Erf)
+            SYMENGINE_ONE_ARG(GAMMA, Gamma)
+            SYMENGINE_ONE_ARG(LOGGAMMA, LogGamma)
+            SYMENGINE_ONE_ARG(ABS, Abs)
+            SYMENGINE_TWO_ARG(ATAN2, ATan2)
+            SYMENGINE_TWO_ARG(ZETA, Zeta)
+            SYMENGINE_TWO_ARG(KRONECKERDELTA, KroneckerDelta)
+            SYMENGINE_TWO_ARG(LOWERGAMMA, LowerGamma)
+            SYMENGINE_TWO_ARG(UPPERGAMMA, UpperGamma)
+            SYMENGINE_TWO_ARG(BETA, Beta)
+            SYMENGINE_TWO_ARG(POLYGAMMA, PolyGamma)
+            SYMENGINE_MULTI_ARG(LEVICIVITA, LeviCivita)
+            SYMENGINE_MULTI_ARG(MAX, Max)
+            SYMENGINE_MULTI_ARG(MIN, Min)
+#undef SYMENGINE_ONE_ARG
+#undef SYMENGINE_TWO_ARG
+#undef SYMENGINE_MULTI_ARG
+
+        case SERIAL_FUNCTIONSYMBOL:
+            return make_rcp<const FunctionSymbol>(read_string(), args);
+        case SERIAL_DERIVATIVE: {
+            check_args(n >= 1);
+            multiset_basic symbols(args.begin() + 1, args.end());
+            return make_rcp<const Derivative>(args[0], symbols);
+        }
+        case SERIAL_SUBS: {
+            check_args(n % 2 == 1);
+            map_basic_basic d;
+            for (size_t i = 1; i < n; i += 2)
+                d.insert({args[i], args[i + 1]});
+            return make_rcp<const Subs>(args[0], d);
+        }
+        case SERIAL_EMPTYSET:
+            check_args(n == 0);
+            return emptyset();
+        case SERIAL_UNIVERSALSET:
+            check_args(n == 0);
+            return universalset();
+        case SERIAL_FINITESET:
+            return make_rcp<const FiniteSet>(
+                set_basic(args.begin(), args.end()));
+        case SERIAL_INTERVAL: {
+            check_args(n == 2);
+            unsigned char flags = read_byte();
+            return make_rcp<const Interval>(number(args[0]), number(args[1]),
+                                            flags & 1, flags & 2);
+        }
+        default:
+            error("unsupported tag");
+    }
+    return RCP<const Basic>();
+}
+
+typedef double (*real_function)(double);
+
+//! \return the function of one argument with the tag `tag`, or nullptr
+real_function find_real_function(std::uint64_t tag)
+{
+    switch (tag) {
+        case SERIAL_LOG:
+            return [](double x) { return std::log(x); };
+        case SERIAL_SIN:
+            return [](double x) { return std::sin(x); };
+        case SERIAL_COS:
+            return [](double x) { return std::cos(x); };
+        case SERIAL_TAN:
+            return [](double x) { return std::tan(x); };
+        case SERIAL_COT:
+            return [](double x) { return 1.0 / std::tan(x); };
+        case SERIAL_CSC:
+            return [](double x) { return 1.0 / std::sin(x); };
+        case SERIAL_SEC:
+            return [](double x) { return 1.0 / std::cos(x); };
+        case SERIAL_ASIN:
+            return [](double x) { return std::asin(x); };
+        case SERIAL_ACOS:
+            return [](double x) { return std::acos(x); };
+        case SERIAL_ASEC:
+            return [](double x) { return std::acos(1.0 / x); };
+        case SERIAL_ACSC:
+            return [](double x) { return std::asin(1.0 / x); };
+        case SERIAL_ATAN:
+            return [](double x) { return std::atan(x); };
+        case SERIAL_ACOT:
+            return [](double x) { return std::atan(1.0 / x); };
+        case SERIAL_SINH:
+            return [](double x) { return std::sinh(x); };
+        case SERIAL_CSCH:
+            return [](double x) { return 1.0 / std::sinh(x); };
+        case SERIAL_COSH:
+            return [](double x) { return std::cosh(x); };
+        case SERIAL_SECH:
+            return [](double x) { return 1.0 / std::cosh(x); };
+        case SERIAL_TANH:
+            return [](double x) { return std::tanh(x); };
+        case SERIAL_COTH:
+            return [](double x) { return 1.0 / std::tanh(x); };
+        case SERIAL_ASINH:
+            return [](double x) { return std::asinh(x); };
+        case SERIAL_ACSCH:
+            return [](double x) { return std::asinh(1.0 / x); };
+        case SERIAL_ACOSH:
+            return [](double x) { return std::acosh(x); };
+        case SERIAL_ATANH:
+            return [](double x) { return std::atanh(x); };
+        case SERIAL_ACOTH:
+            return [](double x) { return std::atanh(1.0 / x); };
+        case SERIAL_ASECH:
+            return [](double x) { return std::acosh(1.0 / x); };
+        case SERIAL_GAMMA:
+            return [](double x) { return std::tgamma(x); };
+        case SERIAL_LOGGAMMA:
+            return [](double x) { return std::lgamma(x); };
+        case SERIAL_ERF:
+            return [](double x) { return std::erf(x); };
+        case SERIAL_ABS:
+            return [](double x) { return std::abs(x); };
+        default:
+            return nullptr;
+    }
+}
+
+//! Evaluates the nodes of a stream to doubles like `eval_double`, without
+//! creating them. Node `i` starts at the offset in the `i`-th word of
+//! `offsets`, and every node is evaluated only once.
+class DagEvaluator : public DagCursor
+{
+private:
+    const char *offsets_;
+    std::unordered_map<std::uint64_t, double> values_;
+
+    bool is_constant_e(std::uint64_t i)
+    {
+        const char *pos = pos_;
+        seek(load_word(offsets_ + 8 * i));
+        bool r = read_uint() == SERIAL_CONSTANT
+                 and read_string() == E->get_name();
+        pos_ = pos;
+        return r;
+    }
+
+    double power(std::uint64_t base, std::uint64_t exp)
+    {
+        double e = node(exp);
+        if (is_constant_e(base))
+            return std::exp(e);
+        return std::pow(node(base), e);
+    }
+
+    double read_node(std::uint64_t i);
+
+public:
+    DagEvaluator(const char *first, const char *last, const char *offsets)
+        : DagCursor(first, last), offsets_(offsets)
+    {
+    }
+
+    double node(std::uint64_t i)
+    {
+        auto it = values_.find(i);
+        if (it != values_.end())
+            return it->second;
+        const char *pos = pos_;
+        seek(load_word(offsets_ + 8 * i));
+        double r = read_node(i);
+        pos_ = pos;
+        values_.insert({i, r});
+        return r;
+    }
+};
+
+double DagEvaluator::read_node(std::uint64_t i)
+{
+    std::uint64_t tag = read_uint();
+    switch (tag) {
+        case SERIAL_INTEGER:
+            return mp_get_d(read_integer());
+        case SERIAL_RATIONAL:
+            return mp_get_d(read_rational());
+        case SERIAL_REAL_DOUBLE:
+            return read_double();
+#ifdef HAVE_SYMENGINE_MPFR
+        case SERIAL_REAL_MPFR: {
+            mpfr_class x;
+            read_mpfr(x.get_mpfr_t());
+            return mpfr_get_d(x.get_mpfr_t(), MPFR_RNDN);
+        }
+#endif
+        case SERIAL_SYMBOL:
+            throw std::runtime_error("Symbol cannot be evaluated.");
+        case SERIAL_CONSTANT: {
+            std::string name = read_string();
+            if (name == pi->get_name())
+                return std::atan2(0, -1);
+            if (name == E->get_name())
+                return std::exp(1);
+            if (name == EulerGamma->get_name())
+                return 0.5772156649015328606065;
+            throw std::runtime_error("Constant " + name
+                                     + " is not implemented.");
+        }
+        default:
+            break;
+    }
+
+    if (tag >= SERIAL_TAG_COUNT)
+        error("unknown tag");
+    std::uint64_t n = read_uint();
+    need(n);
+    std::vector<std::uint64_t> args(n);
+    for (auto &a : args)
+        a = read_index(i);
+
+    double r;
+    switch (tag) {
+        case SERIAL_ADD:
+        case SERIAL_MUL:
+            if (n % 2 == 0)
+                error("invalid number of arguments");
+            r = node(args[0]);
+            for (size_t k = 1; k < n; k += 2) {
+                if (tag == SERIAL_ADD)
+                    r += node(args[k + 1]) * node(args[k]);
+                else
+                    r *= power(args[k], args[k + 1]);
+            }
+            return r;
+        case SERIAL_POW:
+            if (n != 2)
+                error("invalid number of arguments");
+            return power(args[0], args[1]);
+        case SERIAL_ATAN2:
+            if (n != 2)
+                error("invalid number of arguments");
+            r = node(args[0]);
+            return std::atan2(r, node(args[1]));
+        case SERIAL_MAX:
+        case SERIAL_MIN:
+            if (n == 0)
+                error("invalid number of arguments");
+            r = node(args[0]);
+            for (size_t k = 1; k < n; k++) {
+                double t = node(args[k]);
+                r = (tag == SERIAL_MAX) ? std::max(r, t) : std::min(r, t);
+            }
+            return r;
+        default:
+            break;
+    }
+    real_function f = find_real_function(tag);
+    if (f == nullptr or n != 1)
+        throw std::runtime_error("Not implemented.");
+    return f(node(args[0]));
+}
+
+// Layout of an archive: the magic, then the version, the numbers of nodes and
+// of entries and the positions of the offsets table and of the index as
+// 64-bit little endian words. The nodes follow the header, then the offsets
+// of the nodes, then the index entries, sorted by the hash and the name, each
+// made of the hash, the position and length of the name and the node, and at
+// last the names.
+const char archive_magic[8] = {'S', 'Y', 'M', 'E', 'N', 'G', 'A', 'R'};
+const unsigned archive_version = 1;
+const std::uint64_t archive_header_size = 48;
+const std::uint64_t archive_entry_size = 32;
+
+//! 64-bit FNV-1a hash, which does not depend on the platform
+std::uint64_t name_hash(const std::string &name)
+{
+    std::uint64_t h = 14695981039346656037ULL;
+    for (char c : name) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+}
+
+std::string serialize(const vec_basic &v)
+{
+    std::string body;
+    DagWriter writer(body);
+    std::vector<unsigned> roots;
+    roots.reserve(v.size());
+    for (const auto &b : v)
+        roots.push_back(writer.apply(b));
+
+    std::string out(serial_magic, sizeof(serial_magic));
+    write_uint(out, serial_version);
+    write_uint(out, writer.size());
+    out.append(body);
+    write_uint(out, roots.size());
+    for (unsigned r : roots)
+        write_uint(out, r);
+    return out;
+}
+
+vec_basic deserialize(const char *first, const char *last)
+{
+    return DagReader(first, last).read();
+}
+
+void write_archive(
+    const std::string &filename,
+    const std::vector<std::pair<std::string, RCP<const Basic>>> &entries)
+{
+    std::string body;
+    DagWriter writer(body);
+    std::vector<std::tuple<std::uint64_t, std::string, unsigned>> index;
+    index.reserve(entries.size());
+    for (const auto &e : entries)
+        index.emplace_back(name_hash(e.first), e.first, writer.apply(e.second));
+    std::sort(index.begin(), index.end());
+    for (size_t i = 1; i < index.size(); i++)
+        if (std::get<1>(index[i]) == std::get<1>(index[i - 1]))
+            throw std::runtime_error("write_archive: duplicate name "
+                                     + std::get<1>(index[i]));
+
+    std::uint64_t offsets_pos = archive_header_size + body.size();
+    std::uint64_t index_pos = offsets_pos + 8 * writer.size();
+    std::string out(archive_magic, sizeof(archive_magic));
+    write_word(out, archive_version);
+    write_word(out, writer.size());
+    write_word(out, index.size());
+    write_word(out, offsets_pos);
+    write_word(out, index_pos);
+    out.append(body);
+    for (std::uint64_t offset : writer.offsets())
+        write_word(out, archive_header_size + offset);
+    std::uint64_t name_pos = index_pos + archive_entry_size * index.size();
+    for (const auto &e : index) {
+        write_word(out, std::get<0>(e));
+        write_word(out, name_pos);
+        write_word(out, std::get<1>(e).size());
+        write_word(out, std::get<2>(e));
+        name_pos += std::get<1>(e).size();
+    }
+    for (const auto &e : index)
+        out.append(std::get<1>(e));
+
+    std::ofstream f(filename, std::ios::out | std::ios::binary);
+    if (not f)
+        throw std::runtime_error("Cannot open " + filename);
+    f.write(out.data(), out.size());
+    if (not f)
+        throw std::runtime_error("Cannot write " + filename);
+}
+
+ExpressionArchive::ExpressionArchive(const std::string &filename)
+    : data_(nullptr), size_(0), map_(nullptr)
+{
+    map_file(filename);
+    try {
+        if (size_ < archive_header_size
+            or std::memcmp(data_, archive_magic, sizeof(archive_magic)) != 0)
+            throw std::runtime_error(filename + " is not an archive");
+        if (load_word(data_ + 8) != archive_version)
+            throw std::runtime_error(filename + ": unsupported version");
+        nnodes_ = load_word(data_ + 16);
+        nentries_ = load_word(data_ + 24);
+        offsets_pos_ = load_word(data_ + 32);
+        index_pos_ = load_word(data_ + 40);
+        if (offsets_pos_ < archive_header_size or offsets_pos_ > size_
+            or nnodes_ > (size_ - offsets_pos_) / 8
+            or index_pos_ != offsets_pos_ + 8 * nnodes_
+            or nentries_ > (size_ - index_pos_) / archive_entry_size)
+            throw std::runtime_error(filename + " is corrupted");
+        for (std::uint64_t i = 0; i < nentries_; i++) {
+            const char *e = data_ + index_pos_ + archive_entry_size * i;
+            std::uint64_t pos = load_word(e + 8), len = load_word(e + 16);
+            if (pos > size_ or len > size_ - pos
+                or load_word(e + 24) >= nnodes_)
+                throw std::runtime_error(filename + " is corrupted");
+        }
+    } catch (...) {
+        unmap_file();
+        throw;
+    }
+}
+
+void ExpressionArchive::map_file(const std::string &filename)
+{
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open " + filename);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Cannot read " + filename);
+    }
+    size_ = st.st_size;
+    if (size_ > 0) {
+        map_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map_ == MAP_FAILED) {
+            map_ = nullptr;
+            close(fd);
+            throw std::runtime_error("Cannot read " + filename);
+        }
+        data_ = static_cast<const char *>(map_);
+    }
+    close(fd);
+#else
+    std::ifstream in(filename, std::ios::in | std::ios::binary);
+    if (not in)
+        throw std::runtime_error("Cannot open " + filename);
+    buffer_.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+}
+
+void ExpressionArchive::unmap_file()
+{
+#ifndef _WIN32
+    if (map_ != nullptr)
+        munmap(map_, size_);
+    map_ = nullptr;
+#endif
+}
+
+ExpressionArchive::~ExpressionArchive()
+{
+    unmap_file();
+}
+
+std::string ExpressionArchive::name(std::size_t i) const
+{
+    if (i >= nentries_)
+        throw std::runtime_error("ExpressionArchive: index out of range");
+    const char *e = data_ + index_pos_ + archive_entry_size * i;
+    return std::string(data_ + load_word(e + 8), load_word(e + 16));
+}
+
+std::uint64_t ExpressionArchive::find(const std::string &name) const
+{
+    std::uint64_t h = name_hash(name);
+    std::uint64_t lo = 0, hi = nentries_;
+    while (lo < hi) {
+        std::uint64_t mid = lo + (hi - lo) / 2;
+        std::uint64_t hm = load_word(data_ + index_pos_
+                                     + archive_entry_size * mid);
+        if (hm < h or (hm == h and this->name(mid) < name))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < nentries_ and this->name(lo) == name)
+        return lo;
+    return nentries_;
+}
+
+bool ExpressionArchive::has(const std::string &name) const
+{
+    return find(name) != nentries_;
+}
+
+std::uint64_t ExpressionArchive::node(const std::string &name) const
+{
+    std::uint64_t i = find(name);
+    if (i == nentries_)
+        throw std::runtime_error("ExpressionArchive: no expression named "
+                                 + name);
+    return load_word(data_ + index_pos_ + archive_entry_size * i + 24);
+}
+
+RCP<const Basic> ExpressionArchive::get(const std::string &name)
+{
+    const char *nodes_end = data_ + offsets_pos_;
+    return DagReader(data_, nodes_end, nodes_end, cache_).node(node(name));
+}
+
+double ExpressionArchive::eval_double(const std::string &name) const
+{
+    const char *nodes_end = data_ + offsets_pos_;
+    return DagEvaluator(data_, nodes_end, nodes_end).node(node(name));
+}
+
+} // SymEngine
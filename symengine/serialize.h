@@ -0,0 +1,89 @@
+/**
+ *  \file serialize.h
+ *  Binary serialization of expression DAGs
+ *
+ **/
+#ifndef SYMENGINE_SERIALIZE_H
+#define SYMENGINE_SERIALIZE_H
+
+#include <cstdint>
+#include <symengine/basic.h>
+#include <symengine/dict.h>
+
+namespace SymEngine
+{
+
+//! Serializes the expressions `v` into a compact binary string. Every unique
+//! subexpression is written once, after all of its children, and children are
+//! referenced by their position in the stream. Integers are stored as raw
+//! limbs. Polynomials, series and wrapper classes are not supported.
+std::string serialize(const vec_basic &v);
+inline std::string serialize(const RCP<const Basic> &b)
+{
+    return serialize(vec_basic{b});
+}
+
+//! Reads back the expressions written by `serialize` from `[first, last)`.
+//! Throws `std::runtime_error` if the data is not valid.
+vec_basic deserialize(const char *first, const char *last);
+inline vec_basic deserialize(const std::string &s)
+{
+    return deserialize(s.data(), s.data() + s.size());
+}
+
+//! Writes the named expressions `entries` to the archive `filename`. The
+//! nodes are stored like in `serialize`, together with a table of their
+//! offsets and an index of the names, so that single expressions can be read
+//! without reading the whole archive.
+void write_archive(
+    const std::string &filename,
+    const std::vector<std::pair<std::string, RCP<const Basic>>> &entries);
+
+//! Read-only archive of named expressions written by `write_archive`. The
+//! file is memory mapped where available, and only the nodes of the
+//! expressions that are accessed are read.
+class ExpressionArchive
+{
+public:
+    explicit ExpressionArchive(const std::string &filename);
+    ~ExpressionArchive();
+    ExpressionArchive(const ExpressionArchive &) = delete;
+    ExpressionArchive &operator=(const ExpressionArchive &) = delete;
+
+    //! \return number of expressions in the archive
+    std::size_t size() const
+    {
+        return nentries_;
+    }
+    //! \return name of the `i`-th expression, in the order of the index
+    std::string name(std::size_t i) const;
+    bool has(const std::string &name) const;
+    //! \return the expression `name`. The nodes read are cached and shared
+    //! between expressions, so this method is not thread safe.
+    RCP<const Basic> get(const std::string &name);
+    //! Evaluates the expression `name` like `eval_double`, directly from the
+    //! archive without creating the expression.
+    double eval_double(const std::string &name) const;
+
+private:
+    const char *data_;
+    std::size_t size_;
+    void *map_;
+    std::string buffer_;
+    std::uint64_t nnodes_;
+    std::uint64_t nentries_;
+    std::uint64_t offsets_pos_;
+    std::uint64_t index_pos_;
+    std::unordered_map<std::uint64_t, RCP<const Basic>> cache_;
+
+    void map_file(const std::string &filename);
+    void unmap_file();
+    //! \return the entry of `name` in the index, or `nentries_`
+    std::uint64_t find(const std::string &name) const;
+    //! \return the node of the entry `name`, throws if there is none
+    std::uint64_t node(const std::string &name) const;
+};
+
+} // SymEngine
+
+#endif
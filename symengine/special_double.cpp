@@ -0,0 +1,423 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include <symengine/special_double.h>
+
+namespace SymEngine
+{
+
+namespace
+{
+
+typedef std::complex<double> complex_double;
+
+const double pi_d = 3.141592653589793;
+const double euler_gamma_d = 0.5772156649015329;
+const double eps = std::numeric_limits<double>::epsilon();
+const double nan_d = std::numeric_limits<double>::quiet_NaN();
+
+// B_{2j}/(2j)! for j = 1, ..., 12
+const double bernoulli_fact[] = {
+    0.08333333333333333,     -0.001388888888888889,   3.306878306878307e-05,
+    -8.267195767195768e-07,  2.08767569878681e-08,    -5.284190138687493e-10,
+    1.3382536530684679e-11,  -3.3896802963225827e-13, 8.586062056277845e-15,
+    -2.174868698558062e-16,  5.5090028283602295e-18,  -1.3954464685812522e-19};
+
+// B_{2j}/(2j) for j = 1, ..., 7
+const double bernoulli_2j[] = {0.08333333333333333,   -0.008333333333333333,
+                               0.003968253968253968,  -0.004166666666666667,
+                               0.007575757575757576,  -0.021092796092796094,
+                               0.08333333333333333};
+
+// Lanczos approximation with g = 7
+const double lanczos_g = 7;
+const double lanczos_p[] = {0.99999999999980993,     676.5203681218851,
+                            -1259.1392167224028,     771.32342877765313,
+                            -176.61502916214059,     12.507343278686905,
+                            -0.13857109526572012,    9.9843695780195716e-6,
+                            1.5056327351493116e-7};
+
+template <typename T>
+bool is_nonpositive_integer(const T &x)
+{
+    return std::imag(x) == 0 and std::real(x) <= 0
+           and std::real(x) == std::floor(std::real(x));
+}
+
+inline double gamma_(double x)
+{
+    return std::tgamma(x);
+}
+
+inline complex_double gamma_(const complex_double &x)
+{
+    return tgamma(x);
+}
+
+// 1 - 2**(1 - s)
+inline double one_minus_pow2(double s)
+{
+    return -std::expm1((1 - s) * std::log(2.0));
+}
+
+inline complex_double one_minus_pow2(const complex_double &s)
+{
+    return 1.0 - std::exp((1.0 - s) * std::log(2.0));
+}
+
+complex_double lgamma_lanczos(complex_double z)
+{
+    if (z.real() < 0.5) {
+        return std::log(pi_d) - std::log(std::sin(pi_d * z))
+               - lgamma_lanczos(1.0 - z);
+    }
+    z -= 1.0;
+    complex_double x = lanczos_p[0];
+    for (unsigned i = 1; i < 9; i++)
+        x += lanczos_p[i] / (z + double(i));
+    complex_double t = z + lanczos_g + 0.5;
+    return 0.5 * std::log(2 * pi_d) + (z + 0.5) * std::log(t) - t
+           + std::log(x);
+}
+
+inline double lgamma_(double x)
+{
+    return std::lgamma(x);
+}
+
+inline complex_double lgamma_(const complex_double &x)
+{
+    return lgamma_lanczos(x);
+}
+
+template <typename T>
+T hurwitz_zeta(const T &s, const T &a);
+
+// zeta(s) for Re(s) < 0 from the functional equation
+// zeta(s) = (2*pi)**s/pi*sin(pi*s/2)*gamma(1 - s)*zeta(1 - s)
+template <typename T>
+T riemann_zeta_reflection(const T &s)
+{
+    // trivial zeros, where sin(pi*s/2) is not exactly zero in floating point
+    if (is_nonpositive_integer(s) and std::fmod(std::real(s), 2) == 0)
+        return 0.0;
+    T r = std::sin(0.5 * pi_d * s) * hurwitz_zeta(1.0 - s, T(1)) / pi_d;
+    if (std::real(s) > -170)
+        return r * std::pow(2 * pi_d, s) * gamma_(1.0 - s);
+    // gamma(1 - s) overflows before the product does
+    return r * std::exp(s * std::log(2 * pi_d) + lgamma_(1.0 - s));
+}
+
+template <typename T>
+T hurwitz_zeta(const T &s, const T &a)
+{
+    if (s == T(1))
+        return std::numeric_limits<double>::infinity();
+    if (std::real(s) < 0) {
+        // The sum below cancels catastrophically for Re(s) < 0. For a
+        // positive integer a, zeta(s, a) = zeta(s) - sum(k**(-s), k < a).
+        if (std::imag(a) != 0 or std::real(a) < 1
+            or std::real(a) != std::floor(std::real(a)))
+            throw std::runtime_error(
+                "zeta(s, a) with Re(s) < 0 is only implemented for positive "
+                "integers a.");
+        T r = riemann_zeta_reflection(s);
+        for (double k = 1; k < std::real(a); k++)
+            r -= std::pow(T(k), -s);
+        return r;
+    }
+    // Direct sum of the first n terms, then the Euler-Maclaurin formula for
+    // the rest. n grows with |s| so that the correction terms decrease fast.
+    double n = std::max(10.0, std::ceil(std::abs(s)))
+               + std::max(0.0, std::ceil(-std::real(a)));
+    n = std::min(n, 1e4);
+    T sum = 0;
+    for (double k = 0; k < n; k++)
+        sum += std::pow(a + k, -s);
+    T w = a + n;
+    T w_s = std::pow(w, -s);
+    sum += w * w_s / (s - 1.0) + 0.5 * w_s;
+    // s*(s+1)*...*(s+2j-2) * w**(-s-2j+1)
+    T fact = s * w_s / w;
+    T w2 = 1.0 / (w * w);
+    for (unsigned j = 0; j < 12; j++) {
+        T term = bernoulli_fact[j] * fact;
+        sum += term;
+        if (std::abs(term) <= eps * std::abs(sum))
+            break;
+        fact *= (s + (2.0 * j + 1)) * (s + (2.0 * j + 2)) * w2;
+    }
+    return sum;
+}
+
+template <typename T>
+T eta(const T &s)
+{
+    if (s == T(1))
+        return std::log(2.0);
+    return one_minus_pow2(s) * hurwitz_zeta(s, T(1));
+}
+
+// Halley's iteration on w*exp(w) - x
+template <typename T>
+T lambertw_(const T &x)
+{
+    if (x == T(0))
+        return x;
+    const double e = 2.718281828459045;
+    T w;
+    if (std::abs(x + 1 / e) < 1) {
+        // series at the branch point -1/e
+        T p = std::sqrt(2.0 * (e * x + 1.0));
+        w = -1.0 + p * (1.0 + p * (-1.0 / 3 + p * (11.0 / 72)));
+    } else if (std::abs(x) < 3) {
+        w = std::log(1.0 + x);
+    } else {
+        T l1 = std::log(x), l2 = std::log(l1);
+        w = l1 - l2 + l2 / l1;
+    }
+    for (unsigned i = 0; i < 30; i++) {
+        T ew = std::exp(w);
+        T f = w * ew - x;
+        T wp1 = w + 1.0;
+        if (f == T(0) or wp1 == T(0))
+            break;
+        T dw = f / (ew * wp1 - (w + 2.0) * f / (2.0 * wp1));
+        w -= dw;
+        if (std::abs(dw) <= 4 * eps * std::abs(w))
+            break;
+    }
+    return w;
+}
+
+template <typename T>
+T digamma(T x)
+{
+    if (is_nonpositive_integer(x))
+        return nan_d;
+    if (std::real(x) < 0.5)
+        return digamma(1.0 - x) - pi_d / std::tan(pi_d * x);
+    T r = 0;
+    while (std::real(x) < 10) {
+        r -= 1.0 / x;
+        x += 1.0;
+    }
+    T x2 = 1.0 / (x * x);
+    T s = 0;
+    for (int j = 6; j >= 0; j--)
+        s = (s + bernoulli_2j[j]) * x2;
+    return r + std::log(x) - 0.5 / x - s;
+}
+
+template <typename T>
+T polygamma_(const T &n, const T &x)
+{
+    if (std::imag(n) != 0 or std::real(n) < 0
+        or std::real(n) != std::floor(std::real(n)))
+        return nan_d;
+    double m = std::real(n);
+    if (m == 0)
+        return digamma(x);
+    // (-1)**(n+1) * n! * zeta(n+1, x)
+    double c = std::tgamma(m + 1);
+    if (std::fmod(m, 2) == 0)
+        c = -c;
+    return c * hurwitz_zeta(T(m + 1), x);
+}
+
+// x**s * exp(-x)
+template <typename T>
+T power_exp(const T &s, const T &x)
+{
+    if (std::real(x) > 0)
+        return std::exp(s * std::log(x) - x);
+    return std::pow(x, s) * std::exp(-x);
+}
+
+// lowergamma(s, x) as a power series
+template <typename T>
+T lowergamma_series(const T &s, const T &x)
+{
+    T a = s, del = 1.0 / s, sum = del;
+    for (unsigned n = 0; n < 10000; n++) {
+        a += 1.0;
+        del *= x / a;
+        sum += del;
+        if (std::abs(del) <= eps * std::abs(sum))
+            break;
+    }
+    return sum * power_exp(s, x);
+}
+
+// uppergamma(s, x) as a continued fraction, evaluated with Lentz's method
+template <typename T>
+T uppergamma_cf(const T &s, const T &x)
+{
+    const double tiny = 1e-300;
+    T b = x + 1.0 - s, c = 1.0 / tiny, d = 1.0 / b, h = d;
+    for (unsigned i = 1; i < 10000; i++) {
+        T an = -double(i) * (double(i) - s);
+        b += 2.0;
+        d = an * d + b;
+        if (std::abs(d) < tiny)
+            d = tiny;
+        c = b + an / c;
+        if (std::abs(c) < tiny)
+            c = tiny;
+        d = 1.0 / d;
+        T del = d * c;
+        h *= del;
+        if (std::abs(del - 1.0) <= eps)
+            break;
+    }
+    return h * power_exp(s, x);
+}
+
+// uppergamma(-m, x) for an integer m >= 0, from the series of
+// uppergamma(0, x) = E1(x) and uppergamma(s+1, x) = s*uppergamma(s, x)
+// + x**s*exp(-x)
+template <typename T>
+T uppergamma_negint(double m, const T &x)
+{
+    T term = 1, sum = 0;
+    for (unsigned k = 1; k < 10000; k++) {
+        term *= -x / double(k);
+        sum += term / double(k);
+        if (std::abs(term) <= eps * std::abs(sum) * k)
+            break;
+    }
+    T r = -euler_gamma_d - std::log(x) - sum;
+    for (double s = -1; s >= -m; s--)
+        r = (r - power_exp(T(s), x)) / s;
+    return r;
+}
+
+template <typename T>
+bool use_series(const T &s, const T &x)
+{
+    if (std::real(x) < 0)
+        return true;
+    // For Re(s) <= 0 the terms of the series alternate in sign and cancel
+    // for large x, while the continued fraction converges for any s once x
+    // is not small.
+    if (std::real(s) <= 0)
+        return std::abs(x) < 1;
+    return std::abs(x) < std::abs(s) + 1;
+}
+
+template <typename T>
+T lowergamma_(const T &s, const T &x)
+{
+    if (is_nonpositive_integer(s))
+        return nan_d;
+    if (use_series(s, x))
+        return lowergamma_series(s, x);
+    return gamma_(s) - uppergamma_cf(s, x);
+}
+
+template <typename T>
+T uppergamma_(const T &s, const T &x)
+{
+    if (use_series(s, x)) {
+        if (is_nonpositive_integer(s))
+            return uppergamma_negint(-std::real(s), x);
+        return gamma_(s) - lowergamma_series(s, x);
+    }
+    return uppergamma_cf(s, x);
+}
+
+} // anonymous namespace
+
+double zeta(double s, double a)
+{
+    return hurwitz_zeta(s, a);
+}
+
+complex_double zeta(const complex_double &s, const complex_double &a)
+{
+    return hurwitz_zeta(s, a);
+}
+
+double dirichlet_eta(double s)
+{
+    return eta(s);
+}
+
+complex_double dirichlet_eta(const complex_double &s)
+{
+    return eta(s);
+}
+
+double lambertw(double x)
+{
+    const double branch_point = -0.36787944117144233;
+    if (x < branch_point)
+        return nan_d;
+    if (x == branch_point)
+        return -1;
+    return lambertw_(x);
+}
+
+complex_double lambertw(const complex_double &x)
+{
+    return lambertw_(x);
+}
+
+double polygamma(double n, double x)
+{
+    return polygamma_(n, x);
+}
+
+complex_double polygamma(const complex_double &n, const complex_double &x)
+{
+    return polygamma_(n, x);
+}
+
+double lowergamma(double s, double x)
+{
+    return lowergamma_(s, x);
+}
+
+complex_double lowergamma(const complex_double &s, const complex_double &x)
+{
+    return lowergamma_(s, x);
+}
+
+double uppergamma(double s, double x)
+{
+    return uppergamma_(s, x);
+}
+
+complex_double uppergamma(const complex_double &s, const complex_double &x)
+{
+    return uppergamma_(s, x);
+}
+
+double beta(double x, double y)
+{
+    if (x > 0 and y > 0) {
+        if (x + y < 170)
+            return std::tgamma(x) * std::tgamma(y) / std::tgamma(x + y);
+        return std::exp(std::lgamma(x) + std::lgamma(y) - std::lgamma(x + y));
+    }
+    return std::tgamma(x) * std::tgamma(y) / std::tgamma(x + y);
+}
+
+complex_double beta(const complex_double &x, const complex_double &y)
+{
+    if (x.imag() == 0 and y.imag() == 0)
+        return beta(x.real(), y.real());
+    return std::exp(lgamma_lanczos(x) + lgamma_lanczos(y)
+                    - lgamma_lanczos(x + y));
+}
+
+complex_double tgamma(const complex_double &x)
+{
+    if (x.imag() == 0)
+        return std::tgamma(x.real());
+    return std::exp(lgamma_lanczos(x));
+}
+
+} // SymEngine
@@ -0,0 +1,53 @@
+/**
+ *  \file special_double.h
+ *  Special functions in double and complex double precision
+ *
+ **/
+#ifndef SYMENGINE_SPECIAL_DOUBLE_H
+#define SYMENGINE_SPECIAL_DOUBLE_H
+
+#include <complex>
+
+namespace SymEngine
+{
+
+//! Hurwitz zeta function, computed with the Euler-Maclaurin formula. For
+//! `Re(s) < 0` it is computed from the functional equation of the Riemann
+//! zeta function, so `a` must be a positive integer, otherwise
+//! `std::runtime_error` is thrown.
+double zeta(double s, double a);
+std::complex<double> zeta(const std::complex<double> &s,
+                          const std::complex<double> &a);
+
+double dirichlet_eta(double s);
+std::complex<double> dirichlet_eta(const std::complex<double> &s);
+
+//! Principal branch of the Lambert W function, NaN for `x < -1/e`
+double lambertw(double x);
+std::complex<double> lambertw(const std::complex<double> &x);
+
+//! Polygamma function, `n` must be a non-negative integer
+double polygamma(double n, double x);
+std::complex<double> polygamma(const std::complex<double> &n,
+                               const std::complex<double> &x);
+
+//! Lower incomplete gamma function `int(t**(s-1)*exp(-t), t, 0, x)`
+double lowergamma(double s, double x);
+std::complex<double> lowergamma(const std::complex<double> &s,
+                                const std::complex<double> &x);
+
+//! Upper incomplete gamma function `int(t**(s-1)*exp(-t), t, x, oo)`
+double uppergamma(double s, double x);
+std::complex<double> uppergamma(const std::complex<double> &s,
+                                const std::complex<double> &x);
+
+double beta(double x, double y);
+std::complex<double> beta(const std::complex<double> &x,
+                          const std::complex<double> &y);
+
+//! Gamma function, computed with the Lanczos approximation
+std::complex<double> tgamma(const std::complex<double> &x);
+
+} // SymEngine
+
+#endif
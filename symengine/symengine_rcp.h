@@ -14,6 +14,11 @@
 
 #if defined(WITH_SYMENGINE_THREAD_SAFE)
 #include <atomic>
+#if defined(WITH_SYMENGINE_IMMORTAL_CONSTANTS)
+// Objects can be made immortal, so that RCP copies of them do not touch the
+// atomic reference counter
+#define SYMENGINE_IMMORTAL_OBJECTS
+#endif
 #endif
 
 #else
@@ -105,13 +110,13 @@ public:
     explicit RCP(T *p) : ptr_(p)
     {
         SYMENGINE_ASSERT(ptr_ != nullptr)
-        (ptr_->refcount_)++;
+        incref(ptr_);
     }
     // Copy constructor
     RCP(const RCP<T> &rp) : ptr_(rp.ptr_)
     {
         if (not is_null())
-            (ptr_->refcount_)++;
+            incref(ptr_);
     }
     // Copy constructor
     template <class T2>
@@ -119,7 +124,7 @@ public:
         : ptr_(r_ptr.get())
     {
         if (not is_null())
-            (ptr_->refcount_)++;
+            incref(ptr_);
     }
     // Move constructor
     RCP(RCP<T> &&rp) SYMENGINE_NOEXCEPT : ptr_(rp.ptr_)
@@ -135,7 +140,7 @@ public:
     }
     ~RCP() SYMENGINE_NOEXCEPT
     {
-        if (ptr_ != nullptr and --(ptr_->refcount_) == 0)
+        if (ptr_ != nullptr and decref(ptr_))
             delete ptr_;
     }
     T *operator->() const
@@ -175,8 +180,8 @@ public:
     {
         T *r_ptr_ptr_ = r_ptr.ptr_;
         if (not r_ptr.is_null())
-            (r_ptr_ptr_->refcount_)++;
-        if (not is_null() and --(ptr_->refcount_) == 0)
+            incref(r_ptr_ptr_);
+        if (not is_null() and decref(ptr_))
             delete ptr_;
         ptr_ = r_ptr_ptr_;
         return *this;
@@ -189,7 +194,7 @@ public:
     }
     void reset()
     {
-        if (not is_null() and --(ptr_->refcount_) == 0)
+        if (not is_null() and decref(ptr_))
             delete ptr_;
         ptr_ = nullptr;
     }
@@ -201,6 +206,24 @@ public:
 
 private:
     T *ptr_;
+
+    static void incref(T *p)
+    {
+#if defined(SYMENGINE_IMMORTAL_OBJECTS)
+        if (p->immortal_)
+            return;
+#endif
+        (p->refcount_)++;
+    }
+    //! \return true if the last reference to `p` was released
+    static bool decref(T *p)
+    {
+#if defined(SYMENGINE_IMMORTAL_OBJECTS)
+        if (p->immortal_)
+            return false;
+#endif
+        return --(p->refcount_) == 0;
+    }
 };
 
 template <class T>
@@ -313,6 +336,19 @@ public:
 #endif
     }
 
+    //! Makes this object immortal: it is never deleted, and RCPs to it no
+    //! longer update its atomic reference counter, which avoids contention
+    //! on objects shared by many threads. It must be called before the
+    //! object is shared between threads. Does nothing unless SymEngine is
+    //! built with WITH_SYMENGINE_THREAD_SAFE and
+    //! WITH_SYMENGINE_IMMORTAL_CONSTANTS.
+    void make_immortal() const
+    {
+#if defined(SYMENGINE_IMMORTAL_OBJECTS)
+        immortal_ = true;
+#endif
+    }
+
     // Everything below is private interface
 private:
 #if defined(WITH_SYMENGINE_RCP)
@@ -331,10 +367,20 @@ private:
 #else
     mutable unsigned int refcount_; // reference counter
 #endif // WITH_SYMENGINE_THREAD_SAFE
+#if defined(SYMENGINE_IMMORTAL_OBJECTS)
+    // Only written before the object is shared, so it is not atomic
+    mutable bool immortal_;
+
+public:
+    EnableRCPFromThis() : refcount_(0), immortal_(false)
+    {
+    }
+#else
 public:
     EnableRCPFromThis() : refcount_(0)
     {
     }
+#endif
 
 private:
 #else
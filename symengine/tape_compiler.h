@@ -0,0 +1,197 @@
+/**
+ *  \file tape_compiler.h
+ *  Compilation of expressions to lists of instructions
+ *
+ **/
+#ifndef SYMENGINE_TAPE_COMPILER_H
+#define SYMENGINE_TAPE_COMPILER_H
+
+#include <complex>
+#include <symengine/basic.h>
+#include <symengine/symbol.h>
+#include <symengine/add.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+#include <symengine/functions.h>
+#include <symengine/visitor.h>
+#include <symengine/eval_double.h>
+
+namespace SymEngine
+{
+
+//! Compiles expressions to the instructions `Tape::Instruction`, whose
+//! operands are values: the inputs, the constants of type `T` and the
+//! results of the instructions. Every subexpression is computed once and
+//! the subexpressions without symbols are folded to constants.
+//!
+//! `Tape::Op` must have `ADD`, `MUL` and `SCALE` (multiplication by the real
+//! constant `c`). The back ends derive from this class, as in
+//! `BaseVisitor<Compiler, TapeCompiler<T, Tape>>`, and add the visitors of
+//! `Pow` and of the functions they support.
+template <typename T, typename Tape>
+class TapeCompiler : public BaseVisitor<TapeCompiler<T, Tape>>
+{
+public:
+    typedef typename Tape::Op Op;
+    typedef typename Tape::Instruction Instruction;
+
+    enum Kind { INPUT, CONST, TEMP };
+    struct Value {
+        Kind kind;
+        unsigned index;
+    };
+
+    //! The inputs come first, the other values are in the order they were
+    //! created. `index` is the position in the inputs, in `consts_` or in
+    //! `code_`.
+    std::vector<Value> values_;
+    std::vector<T> consts_;
+    std::vector<Instruction> code_;
+
+    TapeCompiler(const vec_basic &inputs)
+    {
+        for (size_t i = 0; i < inputs.size(); i++) {
+            if (not is_a<Symbol>(*inputs[i]))
+                throw std::runtime_error("Inputs must be symbols.");
+            cache_[inputs[i]] = new_value(INPUT, i);
+        }
+    }
+
+    //! \return the value of `x`, compiling it if it was not seen before
+    unsigned value(const RCP<const Basic> &x)
+    {
+        auto it = cache_.find(x);
+        if (it != cache_.end())
+            return it->second;
+        unsigned v;
+        if (is_constant(x)) {
+            v = constant(evaluate(*x, T()));
+        } else if (is_a<Symbol>(*x)) {
+            throw std::runtime_error("Symbol not in the symbols vector.");
+        } else {
+            x->accept(*this);
+            v = result_;
+        }
+        cache_[x] = v;
+        return v;
+    }
+
+    void bvisit(const Add &x)
+    {
+        unsigned r = 0;
+        bool first = true;
+        if (not x.coef_->is_exact_zero()) {
+            r = value(x.coef_);
+            first = false;
+        }
+        for (const auto &p : x.dict_) {
+            unsigned t = scale(value(p.first), *p.second);
+            r = first ? t : emit(Tape::ADD, r, t);
+            first = false;
+        }
+        result_ = r;
+    }
+
+    void bvisit(const Mul &x)
+    {
+        unsigned r = 0;
+        bool first = true;
+        for (const auto &p : x.dict_) {
+            unsigned t = value(pow(p.first, p.second));
+            r = first ? t : emit(Tape::MUL, r, t);
+            first = false;
+        }
+        result_ = scale(r, *x.coef_);
+    }
+
+    void bvisit(const Basic &)
+    {
+        throw std::runtime_error("Not implemented.");
+    }
+
+protected:
+    umap_basic_uint cache_;
+    //! whether the subexpressions seen so far are free of symbols
+    std::unordered_map<RCP<const Basic>, bool, RCPBasicHash, RCPBasicKeyEq>
+        constant_;
+    unsigned result_;
+
+    //! \return true if `x` has no free symbols. Every subexpression is
+    //! checked once, so that compiling stays linear in the size of the tree.
+    bool is_constant(const RCP<const Basic> &x)
+    {
+        auto it = cache_.find(x);
+        if (it != cache_.end())
+            return values_[it->second].kind == CONST;
+        auto c = constant_.find(x);
+        if (c != constant_.end())
+            return c->second;
+        bool r = true;
+        if (is_a_sub<Symbol>(*x)) {
+            r = false;
+        } else if (is_a<Subs>(*x)) {
+            // the substituted variables are bound
+            r = free_symbols(*x).empty();
+        } else {
+            for (const auto &p : x->get_args()) {
+                if (not is_constant(p)) {
+                    r = false;
+                    break;
+                }
+            }
+        }
+        constant_[x] = r;
+        return r;
+    }
+
+    unsigned new_value(Kind kind, unsigned index)
+    {
+        values_.push_back({kind, index});
+        return values_.size() - 1;
+    }
+
+    unsigned constant(const T &c)
+    {
+        consts_.push_back(c);
+        return new_value(CONST, consts_.size() - 1);
+    }
+
+    unsigned emit(Op op, unsigned a, unsigned b = 0, double c = 0)
+    {
+        unsigned v = new_value(TEMP, code_.size());
+        // value-initialized, so that the members of the back end are zero
+        Instruction ins = Instruction();
+        ins.op = op;
+        ins.dst = v;
+        ins.a = a;
+        ins.b = b;
+        ins.c = c;
+        code_.push_back(ins);
+        return v;
+    }
+
+    //! \return `c*a`, with a multiplication by a real constant if `c` is real
+    unsigned scale(unsigned a, const Basic &c)
+    {
+        T d = evaluate(c, T());
+        if (d == T(1))
+            return a;
+        if (std::imag(d) == 0)
+            return emit(Tape::SCALE, a, 0, std::real(d));
+        return emit(Tape::MUL, a, constant(d));
+    }
+
+    static double evaluate(const Basic &x, double)
+    {
+        return eval_double(x);
+    }
+
+    static std::complex<double> evaluate(const Basic &x, std::complex<double>)
+    {
+        return eval_complex_double(x);
+    }
+};
+
+} // SymEngine
+
+#endif
@@ -1,5 +1,8 @@
 #include "catch.hpp"
 #include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <set>
 #include <iostream>
 
 #include <symengine/basic.h>
@@ -15,6 +18,7 @@
 #include <symengine/visitor.h>
 #include <symengine/eval_double.h>
 #include <symengine/derivative.h>
+#include <symengine/serialize.h>
 
 using SymEngine::Basic;
 using SymEngine::Add;
@@ -55,6 +59,11 @@ using SymEngine::rational_class;
 using SymEngine::pi;
 using SymEngine::diff;
 using SymEngine::sdiff;
+using SymEngine::serialize;
+using SymEngine::deserialize;
+using SymEngine::write_archive;
+using SymEngine::ExpressionArchive;
+using SymEngine::integer_class;
 
 using namespace SymEngine::literals;
 
@@ -88,6 +97,35 @@ TEST_CASE("Symbol hash: Basic", "[basic]")
     REQUIRE(seed1 == seed2);
 }
 
+TEST_CASE("Eager hash and eq: Basic", "[basic]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Basic> a = add(x, mul(y, pow(x, integer(2))));
+    RCP<const Basic> b = add(x, mul(y, pow(x, integer(2))));
+    RCP<const Basic> c = add(x, mul(y, pow(x, integer(3))));
+    RCP<const Basic> f = SymEngine::sin(c);
+
+    // The hashes of Add, Mul, Pow and of the arguments of functions are
+    // computed when they are constructed
+    REQUIRE(a->cached_hash() != 0);
+    REQUIRE(a->cached_hash() == a->__hash__());
+    REQUIRE(pow(x, integer(2))->cached_hash() != 0);
+    REQUIRE(c->cached_hash() != 0);
+
+    REQUIRE(eq(*a, *a));
+    REQUIRE(eq(*a, *b));
+    REQUIRE(a.get() != b.get());
+    REQUIRE(neq(*a, *c));
+    REQUIRE(neq(*f, *SymEngine::sin(a)));
+    REQUIRE(eq(*f, *SymEngine::sin(c)));
+
+    umap_basic_num d;
+    d[a] = integer(1);
+    REQUIRE(d.find(b) != d.end());
+    REQUIRE(d.find(c) == d.end());
+}
+
 TEST_CASE("Symbol dict: Basic", "[basic]")
 {
     umap_basic_num ubn;
@@ -848,3 +886,112 @@ TEST_CASE("args: Basic", "[basic]")
     r1 = log(pi);
     REQUIRE(vec_basic_eq_perm(r1->get_args(), {pi}));
 }
+
+TEST_CASE("serialize: Basic", "[basic]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Basic> f = function_symbol("f", {x, y});
+    RCP<const Integer> big = integer(integer_class("-123456789012345678901"
+                                                   "234567890123456789"));
+    RCP<const Basic> s = add(x, y);
+    vec_basic v = {
+        zero,
+        big,
+        Rational::from_two_ints(*integer(-3), *integer(7)),
+        Complex::from_two_nums(*integer(2), *big),
+        SymEngine::real_double(-1.5),
+        SymEngine::complex_double(std::complex<double>(0.25, -3)),
+        add(mul(big, pow(sin(s), integer(2))), mul(cos(s), s)),
+        SymEngine::add({pi, SymEngine::E, SymEngine::EulerGamma, SymEngine::I}),
+        SymEngine::max({x, y, one}),
+        SymEngine::zeta(x, y),
+        SymEngine::kronecker_delta(x, y),
+        SymEngine::levi_civita({x, y, integer(3)}),
+        SymEngine::polygamma(integer(2), x),
+        SymEngine::abs(log(x)),
+        f,
+        diff(f, x),
+        diff(function_symbol("f", mul(integer(2), x)), x),
+        SymEngine::interval(zero, one, true, false),
+        SymEngine::finiteset({x, y, big}),
+        SymEngine::emptyset(),
+        SymEngine::universalset(),
+    };
+    std::string data = serialize(v);
+    vec_basic w = deserialize(data);
+    REQUIRE(w.size() == v.size());
+    for (size_t i = 0; i < v.size(); i++) {
+        REQUIRE(eq(*v[i], *w[i]));
+        REQUIRE(v[i]->__hash__() == w[i]->__hash__());
+    }
+
+    // shared subexpressions are written only once
+    RCP<const Basic> e = x;
+    for (int i = 0; i < 20; i++)
+        e = add(mul(e, e), one);
+    data = serialize(e);
+    REQUIRE(data.size() < 300);
+    w = deserialize(data);
+    REQUIRE(w.size() == 1);
+    REQUIRE(eq(*w[0], *e));
+    REQUIRE(serialize(vec_basic{e, e}).size() <= data.size() + 2);
+
+    CHECK_THROWS_AS(deserialize(data.substr(0, data.size() - 1)),
+                    std::runtime_error);
+    CHECK_THROWS_AS(deserialize(data + "x"), std::runtime_error);
+    CHECK_THROWS_AS(deserialize("SYMENGDX" + data.substr(8)),
+                    std::runtime_error);
+    CHECK_THROWS_AS(serialize(SymEngine::univariate_int_polynomial(
+                        x, SymEngine::map_uint_mpz{{1, 2_z}})),
+                    std::runtime_error);
+}
+
+TEST_CASE("ExpressionArchive: Basic", "[basic]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Basic> c
+        = add(pi, Rational::from_two_ints(*integer(1), *integer(3)));
+    RCP<const Basic> e1 = add(mul(sin(c), pow(SymEngine::E, c)), sqrt(c));
+    RCP<const Basic> e2 = SymEngine::max({c, SymEngine::atan2(one, c)});
+    RCP<const Basic> e3 = mul(x, c);
+    const char *filename = "test_archive.bin";
+    write_archive(filename, {{"e1", e1}, {"e2", e2}, {"e3", e3}, {"c", c}});
+
+    {
+        ExpressionArchive a(filename);
+        REQUIRE(a.size() == 4);
+        std::set<std::string> names;
+        for (size_t i = 0; i < a.size(); i++)
+            names.insert(a.name(i));
+        REQUIRE(names == std::set<std::string>({"c", "e1", "e2", "e3"}));
+        REQUIRE(a.has("e2"));
+        REQUIRE(not a.has("e4"));
+
+        REQUIRE(std::abs(a.eval_double("e1") - eval_double(*e1)) < 1e-12);
+        REQUIRE(std::abs(a.eval_double("e2") - eval_double(*e2)) < 1e-12);
+        CHECK_THROWS_AS(a.eval_double("e3"), std::runtime_error);
+
+        RCP<const Basic> r3 = a.get("e3");
+        REQUIRE(eq(*r3, *e3));
+        REQUIRE(eq(*a.get("e1"), *e1));
+        REQUIRE(eq(*a.get("e2"), *e2));
+        // nodes are shared between the expressions read
+        REQUIRE(a.get("c").get() == a.get("c").get());
+        size_t shared = 0;
+        for (const auto &arg : r3->get_args())
+            shared += (arg.get() == a.get("c").get());
+        REQUIRE(shared == 1);
+        CHECK_THROWS_AS(a.get("e4"), std::runtime_error);
+    }
+
+    CHECK_THROWS_AS(write_archive(filename, {{"a", x}, {"a", c}}),
+                    std::runtime_error);
+    {
+        std::ofstream out(filename);
+        out << "not an archive";
+    }
+    CHECK_THROWS_AS(ExpressionArchive a(filename), std::runtime_error);
+    std::remove(filename);
+    CHECK_THROWS_AS(ExpressionArchive a(filename), std::runtime_error);
+}
@@ -1110,6 +1110,18 @@ TEST_CASE("Get pi shift: functions", "[functions]")
     REQUIRE(b == true);
     REQUIRE(eq(*n, *i8));
     REQUIRE(eq(*r1, *add(mul(i2, x), mul(i2, symbol("y")))));
+
+    // arg neq theta + n*pi/12 (n is not integer, theta is an expression)
+    r = add(add(x, symbol("y")), mul(pi, div(i2, integer(5))));
+    b = get_pi_shift(r, outArg(n), outArg(r1));
+    REQUIRE(b == false);
+
+    // arg = theta + n*pi/12 (theta is a single term)
+    r = add(mul(i3, x), mul(pi, integer(-5)));
+    b = get_pi_shift(r, outArg(n), outArg(r1));
+    REQUIRE(b == true);
+    REQUIRE(eq(*n, *integer(-60)));
+    REQUIRE(eq(*r1, *mul(i3, x)));
 }
 
 TEST_CASE("Sin table: functions", "[functions]")
@@ -13,6 +13,8 @@
 #include <symengine/visitor.h>
 #include <symengine/eval_double.h>
 #include <symengine/parser.h>
+#include <cstdio>
+#include <fstream>
 
 using SymEngine::Basic;
 using SymEngine::Add;
@@ -38,6 +40,10 @@ using SymEngine::real_double;
 using SymEngine::RealDouble;
 using SymEngine::E;
 using SymEngine::parse;
+using SymEngine::parse_many;
+using SymEngine::parse_file;
+using SymEngine::ExpressionParser;
+using SymEngine::vec_basic;
 using SymEngine::max;
 using SymEngine::min;
 using SymEngine::loggamma;
@@ -322,4 +328,109 @@ TEST_CASE("Parsing: errors", "[parser]")
 
     s = "max(,3,2)";
     CHECK_THROWS_AS(parse(s), std::runtime_error);
+
+    s = "x y";
+    CHECK_THROWS_AS(parse(s), std::runtime_error);
+
+    s = "1/0";
+    CHECK_THROWS_AS(parse(s), std::runtime_error);
+
+    // The position of the offending token is reported
+    s = "sin(x) + (y *)";
+    try {
+        parse(s);
+        REQUIRE(false);
+    } catch (std::runtime_error &e) {
+        REQUIRE(std::string(e.what()) == "Unexpected token at position 13!");
+    }
+}
+
+TEST_CASE("Parsing: associativity and long input", "[parser]")
+{
+    std::string s;
+    RCP<const Basic> res;
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+
+    s = "2**3**2";
+    res = parse(s);
+    REQUIRE(eq(*res, *integer(512)));
+
+    s = "x - y - x";
+    res = parse(s);
+    REQUIRE(eq(*res, *neg(y)));
+
+    s = "-x**2";
+    res = parse(s);
+    REQUIRE(eq(*res, *neg(pow(x, integer(2)))));
+
+    s = "x/y/x";
+    res = parse(s);
+    REQUIRE(eq(*res, *div(one, y)));
+
+    s = "123456789012345678901234567890 - 1";
+    res = parse(s);
+    REQUIRE(res->__str__() == "123456789012345678901234567889");
+
+    s = "\tx +\n y";
+    res = parse(s);
+    REQUIRE(eq(*res, *add(x, y)));
+
+    s = "x";
+    for (int i = 1; i < 500; i++)
+        s += " + x**" + std::to_string(i) + "*y";
+    res = parse(s);
+    REQUIRE(is_a<Add>(*res));
+    REQUIRE(static_cast<const Add &>(*res).dict_.size() == 500);
+}
+
+TEST_CASE("Parsing: many expressions", "[parser]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    vec_basic res;
+
+    ExpressionParser p;
+    RCP<const Basic> a = p.parse("x + y");
+    RCP<const Basic> b = p.parse("2*x");
+    REQUIRE(eq(*a, *add(x, y)));
+    REQUIRE(eq(*b, *mul(integer(2), x)));
+    // The parser creates every symbol once
+    REQUIRE(static_cast<const Add &>(*a).dict_.find(x)->first.get()
+            == static_cast<const Mul &>(*b).dict_.begin()->first.get());
+
+    res = parse_many("x + 1; sin(y)\n\n  \n2*x**2;");
+    REQUIRE(res.size() == 3);
+    REQUIRE(eq(*res[0], *add(x, one)));
+    REQUIRE(eq(*res[1], *sin(y)));
+    REQUIRE(eq(*res[2], *mul(integer(2), pow(x, integer(2)))));
+    REQUIRE(parse_many("").empty());
+
+    std::string s;
+    for (int i = 0; i < 1000; i++)
+        s += "x**" + std::to_string(i) + " + y\n";
+    res = parse_many(s, 4);
+    REQUIRE(res.size() == 1000);
+    REQUIRE(eq(*res[999], *add(pow(x, integer(999)), y)));
+
+    try {
+        parse_many("x\ny + (z\n3");
+        REQUIRE(false);
+    } catch (std::runtime_error &e) {
+        REQUIRE(std::string(e.what())
+                == "Expression 2: Mismatching parantheses at position 6!");
+    }
+
+    const char *filename = "test_parser_many.txt";
+    {
+        std::ofstream out(filename);
+        out << "x*y\nlog(x)\n-3\n";
+    }
+    res = parse_file(filename);
+    std::remove(filename);
+    REQUIRE(res.size() == 3);
+    REQUIRE(eq(*res[0], *mul(x, y)));
+    REQUIRE(eq(*res[1], *log(x)));
+    REQUIRE(eq(*res[2], *integer(-3)));
+    CHECK_THROWS_AS(parse_file(filename), std::runtime_error);
 }
@@ -11,6 +11,8 @@
 #include <symengine/pow.h>
 #include <symengine/rings.h>
 #include <symengine/monomials.h>
+#include <symengine/functions.h>
+#include <symengine/rational.h>
 
 using SymEngine::Basic;
 using SymEngine::Add;
@@ -32,6 +34,16 @@ using SymEngine::umap_vec_mpz;
 using SymEngine::RCP;
 using SymEngine::rcp_dynamic_cast;
 using SymEngine::print_stack_on_segfault;
+using SymEngine::basic_to_poly;
+using SymEngine::poly_to_basic;
+using SymEngine::MultivariateIntPolynomial;
+using SymEngine::UnivariateIntPolynomial;
+using SymEngine::integer_class;
+using SymEngine::Rational;
+using SymEngine::sin;
+using SymEngine::sqrt;
+using SymEngine::one;
+using SymEngine::zero;
 
 TEST_CASE("monomial_mul: poly", "[poly]")
 {
@@ -94,3 +106,58 @@ TEST_CASE("expand: poly", "[poly]")
                      .count()
               << "ms" << std::endl;
 }
+
+TEST_CASE("basic_to_poly: poly", "[poly]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Symbol> z = symbol("z");
+    RCP<const Basic> e, r;
+    RCP<const MultivariateIntPolynomial> p;
+    integer_class den;
+
+    e = expand(pow(add(add(x, mul(integer(2), y)), integer(-3)), integer(3)));
+    p = basic_to_poly(e);
+    REQUIRE(p->vars_.size() == 2);
+    REQUIRE(p->dict_.size() == 10);
+    REQUIRE(eq(*poly_to_basic(*p), *e));
+
+    // Rational coefficients are cleared by the common denominator
+    e = add(add(mul(Rational::from_two_ints(1, 2), pow(x, integer(2))),
+                mul(Rational::from_two_ints(-2, 3), mul(x, z))),
+            Rational::from_two_ints(5, 4));
+    p = basic_to_poly(e, den);
+    REQUIRE(den == 12);
+    REQUIRE(p->__str__() == "15 - 8*x*z + 6*x**2");
+    REQUIRE(eq(*poly_to_basic(*p, den), *e));
+    CHECK_THROWS_AS(basic_to_poly(e), std::runtime_error);
+
+    // Other generators
+    e = add(mul(integer(3), mul(sin(x), pow(y, integer(2)))),
+            mul(sqrt(x), sin(x)));
+    p = basic_to_poly(e, den);
+    REQUIRE(den == 1);
+    REQUIRE(p->vars_.size() == 3);
+    REQUIRE(eq(*poly_to_basic(*p), *e));
+    r = expand(mul(e, e));
+    REQUIRE(eq(*poly_to_basic(*p->mul(*p)), *r));
+
+    // Single terms and numbers
+    REQUIRE(eq(*poly_to_basic(*basic_to_poly(x)), *x));
+    e = mul(integer(-7), pow(x, integer(4)));
+    REQUIRE(eq(*poly_to_basic(*basic_to_poly(e)), *e));
+    REQUIRE(eq(*poly_to_basic(*basic_to_poly(integer(5))), *integer(5)));
+    REQUIRE(eq(*poly_to_basic(*basic_to_poly(zero)), *zero));
+    CHECK_THROWS_AS(basic_to_poly(SymEngine::real_double(1.5)),
+                    std::runtime_error);
+
+    // Univariate
+    RCP<const UnivariateIntPolynomial> q;
+    e = add(add(pow(x, integer(3)), mul(Rational::from_two_ints(3, 2), x)),
+            one);
+    q = basic_to_poly(e, x, den);
+    REQUIRE(den == 2);
+    REQUIRE(q->__str__() == "2*x**3 + 3*x + 2");
+    REQUIRE(eq(*poly_to_basic(*q, den), *e));
+    CHECK_THROWS_AS(basic_to_poly(add(e, y), x, den), std::runtime_error);
+}
@@ -4,6 +4,7 @@
 
 #include <symengine/mul.h>
 #include <symengine/polynomial.h>
+#include <symengine/polynomial_gcd.h>
 #include <symengine/pow.h>
 #include <symengine/dict.h>
 
@@ -203,6 +204,38 @@ TEST_CASE("Evaluation of UnivariateIntPolynomial", "[UnivariateIntPolynomial]")
         = univariate_int_polynomial(x, {{0, 1_z}, {1, 2_z}, {2, 1_z}});
 
     REQUIRE(a->eval(2_z) == 9);
+    REQUIRE(a->eval(-1_z) == 0);
+
+    RCP<const UnivariateIntPolynomial> b
+        = univariate_int_polynomial(x, {{3, 2_z}, {7, -1_z}});
+    REQUIRE(b->eval(2_z) == -112);
+    REQUIRE(univariate_int_polynomial(x, map_uint_mpz{})->eval(5_z) == 0);
+
+    std::vector<double> xd = {0.0, 1.0, -2.0, 0.5};
+    std::vector<double> yd = a->multieval(xd);
+    REQUIRE(yd.size() == 4);
+    REQUIRE(yd[0] == 1.0);
+    REQUIRE(yd[1] == 4.0);
+    REQUIRE(yd[2] == 1.0);
+    REQUIRE(yd[3] == 2.25);
+
+    map_uint_mpz d;
+    for (unsigned int i = 0; i <= 150; i++) {
+        if (i % 7 != 3)
+            d[i] = integer_class(i * i) - 1000;
+    }
+    RCP<const UnivariateIntPolynomial> c
+        = univariate_int_polynomial(x, std::move(d));
+    std::vector<integer_class> xs;
+    for (int i = -100; i < 101; i++)
+        xs.push_back(integer_class(i * 37 % 211));
+    std::vector<integer_class> ys = c->multieval(xs);
+    REQUIRE(ys.size() == xs.size());
+    bool same = true;
+    for (std::size_t i = 0; i < xs.size(); i++)
+        same = same and ys[i] == c->eval(xs[i]);
+    REQUIRE(same);
+    REQUIRE(a->multieval(std::vector<integer_class>{}).empty());
 }
 
 TEST_CASE("Derivative of UnivariateIntPolynomial", "[UnivariateIntPolynomial]")
@@ -291,6 +324,47 @@ TEST_CASE("UnivariateIntPolynomial expand", "[UnivariateIntPolynomial][expand]")
             == "x**9 + 3*x**8 + 6*x**7 + 7*x**6 + 6*x**5 + 3*x**4 + x**3");
 }
 
+TEST_CASE("GCD of two UnivariateIntPolynomial", "[UnivariateIntPolynomial]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+
+    // a = 2*(x + 1)**2 * (x - 3), b = 6*(x + 1) * (x**2 + 5)
+    RCP<const UnivariateIntPolynomial> a = univariate_int_polynomial(
+        x, {{0, -6_z}, {1, -10_z}, {2, -2_z}, {3, 2_z}});
+    RCP<const UnivariateIntPolynomial> b = univariate_int_polynomial(
+        x, {{0, 30_z}, {1, 30_z}, {2, 6_z}, {3, 6_z}});
+    REQUIRE(gcd_poly(*a, *b)->__str__() == "2*x + 2");
+    REQUIRE(gcd_poly(*b, *a)->__str__() == "2*x + 2");
+    REQUIRE(gcd_poly(*a, *a)->__str__() == "2*x**3 - 2*x**2 - 10*x - 6");
+    REQUIRE(gcd_poly(*neg_poly(*a), *a)->__str__()
+            == "2*x**3 - 2*x**2 - 10*x - 6");
+
+    RCP<const UnivariateIntPolynomial> z
+        = univariate_int_polynomial(x, map_uint_mpz{});
+    RCP<const UnivariateIntPolynomial> c
+        = univariate_int_polynomial(x, {{0, 4_z}});
+    REQUIRE(gcd_poly(*z, *neg_poly(*b))->__str__()
+            == "6*x**3 + 6*x**2 + 30*x + 30");
+    REQUIRE(gcd_poly(*z, *z)->__str__() == "0");
+    REQUIRE(gcd_poly(*a, *c)->__str__() == "2");
+
+    // coprime polynomials with large coefficients need several primes
+    RCP<const UnivariateIntPolynomial> p = univariate_int_polynomial(
+        x, {{0, 123456789012345_z}, {1, -987654321098765_z}, {5, 1_z}});
+    RCP<const UnivariateIntPolynomial> q = univariate_int_polynomial(
+        x, {{0, 555555555555555_z}, {2, 3_z}, {4, -77777777777_z}});
+    RCP<const UnivariateIntPolynomial> r = univariate_int_polynomial(
+        x, {{0, 1_z}, {3, 9999999999999_z}});
+    REQUIRE(gcd_poly(*p, *q)->__str__() == "1");
+    REQUIRE(eq(*gcd_poly(*mul_poly(*p, *r), *mul_poly(*r, *q)), *r));
+    REQUIRE(eq(*gcd_poly(*mul_poly(*mul_poly(*p, *r), *r), *mul_poly(*r, *p)),
+               *mul_poly(*r, *p)));
+
+    c = univariate_int_polynomial(y, {{0, -1_z}});
+    CHECK_THROWS_AS(gcd_poly(*a, *c), std::runtime_error);
+}
+
 TEST_CASE("Constructor of UnivariatePolynomial", "[UnivariatePolynomial]")
 {
     RCP<const Symbol> x = symbol("x");
@@ -5,6 +5,8 @@
 #include <symengine/mul.h>
 #include <symengine/polynomial.h>
 #include <symengine/polynomial_multivariate.h>
+#include <symengine/polynomial_packed.h>
+#include <symengine/polynomial_gcd.h>
 #include <symengine/pow.h>
 #include <symengine/printer.h>
 
@@ -38,6 +40,9 @@ using SymEngine::vec_int;
 using SymEngine::vec_basic;
 using SymEngine::vec_uint;
 using SymEngine::RCPBasicKeyLess;
+using SymEngine::MonomialPacker;
+using SymEngine::PackedIntPoly;
+using SymEngine::umap_uvec_mpz;
 
 using namespace SymEngine::literals;
 
@@ -647,6 +652,183 @@ TEST_CASE("Testing MultivariateIntPolynomial::get_args()",
                                           pow(z, integer(2)), one}));
 }
 
+TEST_CASE("Testing packed monomials", "[MultivariateIntPolynomial]")
+{
+    MonomialPacker packer(3);
+    REQUIRE(packer.bits_ == 21);
+    REQUIRE(packer.fits(packer.max_exponent()));
+    REQUIRE(not packer.fits(packer.max_exponent() + 1));
+    REQUIRE(not MonomialPacker(33).fits(0));
+    REQUIRE(not MonomialPacker(65).fits(0));
+    REQUIRE(MonomialPacker(65).guard_ == 0);
+
+    vec_uint v = {3, 0, 7}, w;
+    packer.unpack(packer.pack(v), w);
+    REQUIRE(v == w);
+    REQUIRE(packer.pack({1, 0, 0}) > packer.pack({0, 5, 5}));
+    REQUIRE(packer.pack(v, {2, 0, 1}) == packer.pack({0, 7, 3}));
+    REQUIRE(not packer.overflows(packer.pack(v) + packer.pack(v)));
+    REQUIRE(packer.overflows(packer.pack({packer.max_exponent(), 0, 0})
+                             + packer.pack({1, 0, 0})));
+
+    umap_uvec_mpz d1 = {{{1, 0, 0}, 1_z}, {{0, 1, 0}, 2_z}, {{0, 0, 0}, 3_z}};
+    umap_uvec_mpz d2 = {{{1, 0, 0}, -1_z}, {{0, 0, 1}, 1_z}};
+    vec_uint id = {0, 1, 2};
+    PackedIntPoly p1, p2, p3;
+    SymEngine::packed_from_dict(p1, d1, id, packer);
+    SymEngine::packed_from_dict(p2, d2, id, packer);
+    REQUIRE(p1.monoms_[0] == packer.pack({1, 0, 0}));
+    REQUIRE(p1.monoms_[2] == 0);
+
+    SymEngine::packed_add(p3, p1, p2);
+    umap_uvec_mpz r;
+    SymEngine::packed_to_dict(r, p3, packer);
+    REQUIRE(r == umap_uvec_mpz({{{0, 1, 0}, 2_z}, {{0, 0, 1}, 1_z},
+                                {{0, 0, 0}, 3_z}}));
+
+    SymEngine::packed_mul(p3, p1, p2);
+    r.clear();
+    SymEngine::packed_to_dict(r, p3, packer);
+    REQUIRE(r == umap_uvec_mpz({{{2, 0, 0}, -1_z},
+                                {{1, 0, 1}, 1_z},
+                                {{1, 1, 0}, -2_z},
+                                {{0, 1, 1}, 2_z},
+                                {{1, 0, 0}, -3_z},
+                                {{0, 0, 1}, 3_z}}));
+}
+
+TEST_CASE("Testing multiplication of MultivariateIntPolynomials with large "
+          "exponents",
+          "[MultivariateIntPolynomial]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Symbol> z = symbol("z");
+    // 2**20 does not fit into the 21 bit fields used for three variables
+    unsigned int big = 1u << 20;
+    RCP<const MultivariateIntPolynomial> p1 = MultivariateIntPolynomial::create(
+        {x, y, z}, {{{big, 0, 0}, 1_z}, {{0, 1, 0}, 1_z}});
+    RCP<const MultivariateIntPolynomial> p2 = MultivariateIntPolynomial::create(
+        {x, y, z}, {{{big, 0, 0}, 1_z}, {{0, 0, 1}, -1_z}});
+    RCP<const MultivariateIntPolynomial> q = MultivariateIntPolynomial::create(
+        {x, y, z}, {{{2 * big, 0, 0}, 1_z},
+                    {{big, 1, 0}, 1_z},
+                    {{big, 0, 1}, -1_z},
+                    {{0, 1, 1}, -1_z}});
+    REQUIRE(eq(*mul_mult_poly(*p1, *p2), *q));
+
+    // (x + y + z + 1)**2 * (x + y + z + 1)**2 == (x + y + z + 1)**4
+    RCP<const MultivariateIntPolynomial> s = MultivariateIntPolynomial::create(
+        {x, y, z}, {{{1, 0, 0}, 1_z},
+                    {{0, 1, 0}, 1_z},
+                    {{0, 0, 1}, 1_z},
+                    {{0, 0, 0}, 1_z}});
+    RCP<const MultivariateIntPolynomial> s2 = mul_mult_poly(*s, *s);
+    RCP<const MultivariateIntPolynomial> s4 = mul_mult_poly(*s2, *s2);
+    REQUIRE(eq(*s4, *mul_mult_poly(*mul_mult_poly(*s2, *s), *s)));
+    REQUIRE(s4->dict_.size() == 35);
+    REQUIRE(s4->degrees_.find(x)->second == 4);
+    std::map<RCP<const Basic>, integer_class, RCPBasicKeyLess> m
+        = {{x, 1_z}, {y, 1_z}, {z, 1_z}};
+    REQUIRE(s4->eval(m) == 256_z);
+}
+
+TEST_CASE("Testing parallel multiplication of packed polynomials",
+          "[MultivariateIntPolynomial]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Symbol> z = symbol("z");
+    RCP<const MultivariateIntPolynomial> s = MultivariateIntPolynomial::create(
+        {x, y, z}, {{{1, 0, 0}, 1_z},
+                    {{0, 1, 0}, 2_z},
+                    {{0, 0, 1}, -1_z},
+                    {{0, 0, 0}, 1_z}});
+    RCP<const MultivariateIntPolynomial> s2 = mul_mult_poly(*s, *s);
+    RCP<const MultivariateIntPolynomial> s4 = mul_mult_poly(*s2, *s2);
+    RCP<const MultivariateIntPolynomial> s8 = mul_mult_poly(*s4, *s4);
+    REQUIRE(s8->dict_.size() == 165);
+
+    MonomialPacker packer(3);
+    PackedIntPoly p8, p9, serial, parallel;
+    SymEngine::packed_from_dict(p8, s8->dict_, {0, 1, 2}, packer);
+    SymEngine::packed_from_dict(p9, mul_mult_poly(*s8, *s)->dict_, {0, 1, 2},
+                                packer);
+    SymEngine::packed_mul(serial, p8, p9);
+    for (unsigned int nthreads = 1; nthreads <= 5; nthreads++) {
+        SymEngine::packed_mul_parallel(parallel, p8, p9, nthreads);
+        REQUIRE(parallel == serial);
+    }
+
+    // The ranges split at `m` cover the whole product
+    PackedIntPoly upper, lower, both;
+    SymEngine::packed_monomial m = serial.monoms_[serial.size() / 2];
+    SymEngine::packed_mul_range(upper, p8, p9, m + 1, serial.monoms_[0]);
+    SymEngine::packed_mul_range(lower, p8, p9, 0, m);
+    SymEngine::packed_add(both, upper, lower);
+    REQUIRE(both == serial);
+    REQUIRE(lower.monoms_[0] == m);
+
+    RCP<const MultivariateIntPolynomial> s17 = mul_mult_poly(*s8, *s8);
+    s17 = mul_mult_poly(*s17, *s);
+    umap_uvec_mpz d;
+    SymEngine::packed_to_dict(d, serial, packer);
+    REQUIRE(d == s17->dict_);
+}
+
+TEST_CASE("Testing GCD of MultivariateIntPolynomials",
+          "[MultivariateIntPolynomial]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Symbol> z = symbol("z");
+    // g = 3*x*y - z**2 + 2
+    RCP<const MultivariateIntPolynomial> g = MultivariateIntPolynomial::create(
+        {x, y, z}, {{{1, 1, 0}, 3_z}, {{0, 0, 2}, -1_z}, {{0, 0, 0}, 2_z}});
+    // a = x**2 + y*z + 1, b = 2*x - y**3*z + 4
+    RCP<const MultivariateIntPolynomial> a = MultivariateIntPolynomial::create(
+        {x, y, z}, {{{2, 0, 0}, 1_z}, {{0, 1, 1}, 1_z}, {{0, 0, 0}, 1_z}});
+    RCP<const MultivariateIntPolynomial> b = MultivariateIntPolynomial::create(
+        {x, y, z}, {{{1, 0, 0}, 2_z}, {{0, 3, 1}, -1_z}, {{0, 0, 0}, 4_z}});
+
+    REQUIRE(eq(*gcd_mult_poly(*mul_mult_poly(*g, *a), *mul_mult_poly(*g, *b)),
+               *g));
+    REQUIRE(eq(*gcd_mult_poly(*mul_mult_poly(*a, *g), *g), *g));
+    REQUIRE(eq(*gcd_mult_poly(*a, *b), *MultivariateIntPolynomial::create(
+                                           {x, y, z}, {{{0, 0, 0}, 1_z}})));
+
+    // The sign is normalized and the integer contents are taken into account
+    RCP<const MultivariateIntPolynomial> m6
+        = MultivariateIntPolynomial::create({x}, {{{0}, -6_z}});
+    RCP<const MultivariateIntPolynomial> m4
+        = MultivariateIntPolynomial::create({y}, {{{0}, 4_z}});
+    RCP<const MultivariateIntPolynomial> g2 = mul_mult_poly(*g, *g);
+    REQUIRE(eq(*gcd_mult_poly(*mul_mult_poly(*m6, *mul_mult_poly(*g2, *a)),
+                              *mul_mult_poly(*m4, *mul_mult_poly(*g, *b))),
+               *mul_mult_poly(
+                   *MultivariateIntPolynomial::create({x}, {{{0}, 2_z}}),
+                   *g)));
+
+    // Polynomials in different sets of variables
+    RCP<const MultivariateIntPolynomial> c = MultivariateIntPolynomial::create(
+        {x, y}, {{{1, 0}, 1_z}, {{0, 1}, 1_z}});
+    RCP<const MultivariateIntPolynomial> d = MultivariateIntPolynomial::create(
+        {x, z}, {{{1, 0}, 1_z}, {{0, 1}, -1_z}});
+    RCP<const MultivariateIntPolynomial> e = MultivariateIntPolynomial::create(
+        {y}, {{{1}, 1_z}, {{0}, 7_z}});
+    // The gcd is expressed in the union of the variables of both arguments
+    REQUIRE(gcd_mult_poly(*mul_mult_poly(*c, *d), *mul_mult_poly(*c, *e))
+                ->__str__()
+            == c->__str__());
+    REQUIRE(gcd_mult_poly(*mul_mult_poly(*e, *d), *e)->__str__()
+            == e->__str__());
+
+    RCP<const MultivariateIntPolynomial> zero_poly
+        = MultivariateIntPolynomial::create({x}, {{{0}, 0_z}});
+    REQUIRE(eq(*gcd_mult_poly(*zero_poly, *c), *c));
+    REQUIRE(eq(*gcd_mult_poly(*zero_poly, *zero_poly), *zero_poly));
+}
+
 TEST_CASE("Constructing MultivariatePolynomial", "[MultivariatePolynomial]")
 {
     RCP<const Symbol> x = symbol("x");
@@ -202,6 +202,47 @@ void test_CVecBasic()
     basic_free_stack(y);
 }
 
+void test_serialize()
+{
+    CVecBasic *vec = vecbasic_new();
+    basic x, y, z, e;
+    basic_new_stack(x);
+    basic_new_stack(y);
+    basic_new_stack(z);
+    basic_new_stack(e);
+    symbol_set(x, "x");
+    char big[] = "123456789012345678901234567890";
+    integer_set_str(y, big);
+    basic_pow(z, x, y);
+    basic_sin(e, z);
+    basic_add(e, e, z);
+    vecbasic_push_back(vec, e);
+    vecbasic_push_back(vec, z);
+
+    size_t size;
+    char *data = vecbasic_serialize(vec, &size);
+    SYMENGINE_C_ASSERT(data != NULL);
+
+    CVecBasic *vec2 = vecbasic_new();
+    SYMENGINE_C_ASSERT(vecbasic_deserialize(vec2, data, size) == 1);
+    SYMENGINE_C_ASSERT(vecbasic_size(vec2) == 2);
+    vecbasic_get(vec2, 0, x);
+    SYMENGINE_C_ASSERT(basic_eq(x, e));
+    vecbasic_get(vec2, 1, x);
+    SYMENGINE_C_ASSERT(basic_eq(x, z));
+
+    SYMENGINE_C_ASSERT(vecbasic_deserialize(vec2, data, size - 1) == 0);
+    SYMENGINE_C_ASSERT(vecbasic_size(vec2) == 2);
+    basic_str_free(data);
+
+    vecbasic_free(vec);
+    vecbasic_free(vec2);
+    basic_free_stack(x);
+    basic_free_stack(y);
+    basic_free_stack(z);
+    basic_free_stack(e);
+}
+
 void test_CSetBasic()
 {
     CSetBasic *set = setbasic_new();
@@ -430,6 +471,112 @@ void test_subs() {
     basic_free_stack(z);
 }
 
+void test_vecbasic_batch() {
+    CVecBasic *vec = vecbasic_new();
+    CVecBasic *res = vecbasic_new();
+    CMapBasicBasic *map = mapbasicbasic_new();
+    basic x, y, e, r;
+    basic_new_stack(x);
+    basic_new_stack(y);
+    basic_new_stack(e);
+    basic_new_stack(r);
+    symbol_set(x, "x");
+    symbol_set(y, "y");
+
+    // e = (x + y)**2
+    basic_add(e, x, y);
+    integer_set_si(r, 2);
+    basic_pow(e, e, r);
+    vecbasic_push_back(vec, e);
+    basic_mul(e, x, y);
+    vecbasic_push_back(vec, e);
+
+    vecbasic_expand(res, vec);
+    SYMENGINE_C_ASSERT(vecbasic_size(res) == 2);
+    vecbasic_get(res, 0, e);
+    char *s = basic_str(e);
+    SYMENGINE_C_ASSERT(strcmp(s, "2*x*y + x**2 + y**2") == 0);
+    basic_str_free(s);
+
+    SYMENGINE_C_ASSERT(vecbasic_diff(res, vec, x) == 1);
+    vecbasic_get(res, 1, e);
+    SYMENGINE_C_ASSERT(basic_eq(e, y));
+    integer_set_si(r, 2);
+    SYMENGINE_C_ASSERT(vecbasic_diff(res, vec, r) == 0);
+
+    // substitute x = 3/2, y = 1/2 in place
+    integer_set_si(r, 3);
+    integer_set_si(e, 2);
+    basic_div(r, r, e);
+    mapbasicbasic_insert(map, x, r);
+    integer_set_si(r, 1);
+    basic_div(r, r, e);
+    mapbasicbasic_insert(map, y, r);
+    vecbasic_push_back(vec, x);
+    vecbasic_subs(vec, vec, map);
+    SYMENGINE_C_ASSERT(vecbasic_size(vec) == 3);
+
+    double values[3];
+    SYMENGINE_C_ASSERT(vecbasic_eval_double(values, vec) == 1);
+    SYMENGINE_C_ASSERT(values[0] == 4.0);
+    SYMENGINE_C_ASSERT(values[1] == 0.75);
+    SYMENGINE_C_ASSERT(values[2] == 1.5);
+    vecbasic_push_back(vec, x);
+    SYMENGINE_C_ASSERT(vecbasic_eval_double(values, vec) == 0);
+
+    mapbasicbasic_free(map);
+    vecbasic_free(vec);
+    vecbasic_free(res);
+    basic_free_stack(x);
+    basic_free_stack(y);
+    basic_free_stack(e);
+    basic_free_stack(r);
+}
+
+void test_lambda_real_double() {
+    CVecBasic *inputs = vecbasic_new();
+    CVecBasic *outputs = vecbasic_new();
+    CLambdaRealDouble *f = lambda_real_double_new();
+    basic x, y, e;
+    basic_new_stack(x);
+    basic_new_stack(y);
+    basic_new_stack(e);
+    symbol_set(x, "x");
+    symbol_set(y, "y");
+    vecbasic_push_back(inputs, x);
+    vecbasic_push_back(inputs, y);
+
+    basic_mul(e, x, y);
+    vecbasic_push_back(outputs, e);
+    basic_add(e, x, y);
+    basic_mul(e, e, x);
+    vecbasic_push_back(outputs, e);
+
+    SYMENGINE_C_ASSERT(lambda_real_double_init(f, inputs, outputs) == 1);
+    double inps[6] = {1.0, 2.0, 3.0, 4.0, 0.5, -1.0};
+    double outs[6];
+    lambda_real_double_call(f, outs, inps, 3);
+    SYMENGINE_C_ASSERT(outs[0] == 2.0);
+    SYMENGINE_C_ASSERT(outs[1] == 3.0);
+    SYMENGINE_C_ASSERT(outs[2] == 12.0);
+    SYMENGINE_C_ASSERT(outs[3] == 21.0);
+    SYMENGINE_C_ASSERT(outs[4] == -0.5);
+    SYMENGINE_C_ASSERT(outs[5] == -0.25);
+
+    // y is not an input
+    vecbasic_free(inputs);
+    inputs = vecbasic_new();
+    vecbasic_push_back(inputs, x);
+    SYMENGINE_C_ASSERT(lambda_real_double_init(f, inputs, outputs) == 0);
+
+    lambda_real_double_free(f);
+    vecbasic_free(inputs);
+    vecbasic_free(outputs);
+    basic_free_stack(x);
+    basic_free_stack(y);
+    basic_free_stack(e);
+}
+
 void test_constants() {
     basic z, o, mo, i;
     basic_new_stack(z);
@@ -702,6 +849,7 @@ int main(int argc, char* argv[])
     test_CVectorInt1();
     test_CVectorInt2();
     test_CVecBasic();
+    test_serialize();
     test_CSetBasic();
     test_CMapBasicBasic();
     test_get_args();
@@ -710,6 +858,8 @@ int main(int argc, char* argv[])
     test_hash();
     test_subs();
     test_subs2();
+    test_vecbasic_batch();
+    test_lambda_real_double();
     test_constants();
     test_ascii_art();
     test_functions();
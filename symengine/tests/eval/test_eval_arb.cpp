@@ -14,6 +14,7 @@
 #include <symengine/eval_arb.h>
 #include <symengine/constants.h>
 #include <symengine/eval_mpfr.h>
+#include <symengine/real_mpfr.h>
 
 using SymEngine::RCP;
 using SymEngine::Basic;
@@ -46,6 +47,13 @@ using SymEngine::print_stack_on_segfault;
 using SymEngine::min;
 using SymEngine::max;
 using SymEngine::loggamma;
+using SymEngine::evalf;
+using SymEngine::RealMPFR;
+using SymEngine::is_a;
+using SymEngine::pi;
+using SymEngine::one;
+using SymEngine::exp;
+using SymEngine::sub;
 
 TEST_CASE("Integer: eval_arb", "[eval_arb]")
 {
@@ -760,3 +768,29 @@ TEST_CASE("Min/Max: eval_arb", "[eval_arb]")
     mpfr_clear(f);
     arb_clear(a);
 }
+
+TEST_CASE("evalf: eval_arb", "[eval_arb]")
+{
+    // exp(pi*sqrt(163)) - 640320**3 - 744 = -7.499e-13
+    RCP<const Basic> e = sub(exp(mul(pi, sqrt(integer(163)))),
+                             add(pow(integer(640320), integer(3)),
+                                 integer(744)));
+    RCP<const Basic> r = evalf(*e, 30);
+    REQUIRE(is_a<RealMPFR>(*r));
+
+    mpfr_t f, g;
+    mpfr_init2(f, 400);
+    mpfr_init2(g, 400);
+    eval_mpfr(f, *e, MPFR_RNDN);
+    mpfr_sub(g, static_cast<const RealMPFR &>(*r).i.get_mpfr_t(), f,
+             MPFR_RNDN);
+    mpfr_div(g, g, f, MPFR_RNDN);
+    REQUIRE(mpfr_cmp_d(g, 1e-30) < 0);
+    REQUIRE(mpfr_cmp_d(g, -1e-30) > 0);
+    mpfr_clear(f);
+    mpfr_clear(g);
+
+    // zero, but not exactly
+    e = sub(add(pow(sin(one), integer(2)), pow(cos(one), integer(2))), one);
+    CHECK_THROWS_AS(evalf(*e, 10, 1024), std::runtime_error);
+}
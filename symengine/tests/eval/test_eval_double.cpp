@@ -1,5 +1,8 @@
 #include "catch.hpp"
 #include <cmath>
+#include <limits>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include <symengine/basic.h>
@@ -13,6 +16,7 @@
 #include <symengine/functions.h>
 #include <symengine/visitor.h>
 #include <symengine/eval_double.h>
+#include <symengine/exact_sum.h>
 #include <symengine/eval_mpfr.h>
 #include <symengine/eval_mpc.h>
 
@@ -57,6 +61,12 @@ using SymEngine::pi;
 using SymEngine::E;
 using SymEngine::EulerGamma;
 using SymEngine::loggamma;
+using SymEngine::lambertw;
+using SymEngine::polygamma;
+using SymEngine::lowergamma;
+using SymEngine::uppergamma;
+using SymEngine::dirichlet_eta;
+using SymEngine::beta;
 using SymEngine::vec_basic;
 using SymEngine::rational_class;
 using SymEngine::max;
@@ -120,6 +130,14 @@ TEST_CASE("eval_double: eval_double", "[eval_double]")
         {loggamma(pi), 0.82769459232343710152},
         {add(asech(div(one, integer(2))), real_double(0.1)), 1.41695789692482},
         {r5, 0.841470984807897},
+        {zeta(integer(3), div(one, integer(2))), 8.41439832211716},
+        {zeta(r3, r4), -4.16507133320789},
+        {dirichlet_eta(integer(3)), 0.901542677369696},
+        {lambertw(integer(10)), 1.74552800274070},
+        {polygamma(integer(2), integer(3)), -0.154113806319188},
+        {lowergamma(r3, integer(2)), 4.53122432934382},
+        {uppergamma(r3, r4), 0.00163329569169420},
+        {beta(r3, r4), 3.38203463203463},
     };
 
     for (unsigned i = 0; i < vec.size(); i++) {
@@ -145,16 +163,226 @@ TEST_CASE("eval_double: eval_double", "[eval_double]")
     CHECK_THROWS_AS(eval_double_single_dispatch(*levi_civita({r1})),
                     std::runtime_error);
 
-    CHECK_THROWS_AS(eval_double(*zeta(r1, r2)), std::runtime_error);
-    CHECK_THROWS_AS(eval_double_single_dispatch(*zeta(r1, r2)),
-                    std::runtime_error);
-
     CHECK_THROWS_AS(eval_double(*constant("dummy")), std::runtime_error);
     CHECK_THROWS_AS(eval_double_single_dispatch(*constant("dummy")),
                     std::runtime_error);
     // ... we don't test the rest of functions that are not implemented.
 }
 
+TEST_CASE("Special functions: eval_double", "[eval_double]")
+{
+    using SymEngine::uppergamma;
+    using SymEngine::lowergamma;
+    typedef std::complex<double> cd;
+    // zeta(-n) = -B_{n+1}/(n+1)
+    std::vector<std::pair<double, double>> zetas = {
+        {-1, -1.0 / 12},
+        {-9, -1.0 / 132},
+        {-13, -1.0 / 12},
+        {-15, 3617.0 / 8160},
+        {-19, 174611.0 / 6600},
+        {-0.5, -0.207886224977354566},
+    };
+    for (const auto &p : zetas) {
+        double d = p.second;
+        REQUIRE(std::fabs(zeta(p.first, 1.0) - d) < 1e-14 * std::fabs(d));
+        REQUIRE(std::abs(zeta(cd(p.first), cd(1.0)) - d)
+                < 1e-14 * std::fabs(d));
+    }
+    REQUIRE(zeta(-4.0, 1.0) == 0);
+    // zeta(s, a) = zeta(s) - sum(k**(-s), k < a) for integers a > 1
+    REQUIRE(std::fabs(zeta(-2.0, 3.0) + 5) < 1e-14);
+    REQUIRE(std::fabs(zeta(-1.0, 3.0) + 37.0 / 12) < 1e-14);
+    REQUIRE(std::fabs(zeta(-0.5, 2.0) - (-0.207886224977354566 - 1))
+            < 1e-14);
+    REQUIRE(std::abs(zeta(cd(-2.0), cd(3.0)) + 5.0) < 1e-14);
+    REQUIRE(std::fabs(eval_double(*zeta(real_double(-1.0), integer(3)))
+                      + 37.0 / 12)
+            < 1e-14);
+    CHECK_THROWS_AS(zeta(-2.5, 0.5), std::runtime_error);
+    CHECK_THROWS_AS(zeta(cd(-2.5), cd(3.0, 1.0)), std::runtime_error);
+    CHECK_THROWS_AS(eval_double(*zeta(real_double(-2.5), real_double(0.5))),
+                    std::runtime_error);
+    REQUIRE(std::fabs(dirichlet_eta(-9.0) - 7.75) < 1e-13);
+
+    std::vector<std::pair<std::pair<double, double>, double>> gammas = {
+        {{-20, 15}, 2.59647977741144033e-32},
+        {{-30, 25}, 2.88732258757750387e-55},
+        {{-5, 5.5}, 7.36872272540975687e-08},
+        {{-10.5, 5}, 1.94931636284032361e-11},
+        {{-4, 1}, 7.04542374617204009e-02},
+        {{-3, 0.5}, 1.32194260686678455},
+        {{-2.5, 0.3}, 5.11580573681432060},
+    };
+    for (const auto &p : gammas) {
+        double s = p.first.first, x = p.first.second, d = p.second;
+        REQUIRE(std::fabs(uppergamma(s, x) - d) < 1e-13 * d);
+        REQUIRE(std::abs(uppergamma(cd(s), cd(x)) - d) < 1e-13 * d);
+    }
+    double d = -2.64031675218400038e-07;
+    REQUIRE(std::fabs(lowergamma(-10.5, 5.0) - d) < 1e-13 * std::fabs(d));
+}
+
+TEST_CASE("Powers: eval_double", "[eval_double]")
+{
+    using SymEngine::DoublePower;
+    using SymEngine::eval_double_single_dispatch;
+    for (unsigned n = 1; n <= DoublePower::max_chain; n++) {
+        double x = 1.1, d = std::pow(x, double(n));
+        REQUIRE(std::fabs(DoublePower::chain(x, n) - d) < 1e-15 * d);
+        std::complex<double> z(0.6, -0.9), w = std::pow(z, double(n));
+        REQUIRE(std::abs(DoublePower::chain(z, n) - w) < 1e-14 * std::abs(w));
+    }
+
+    RCP<const Basic> x = real_double(1.7);
+    std::vector<std::pair<RCP<const Basic>, double>> vec = {
+        {pow(x, integer(15)), std::pow(1.7, 15)},
+        {pow(x, integer(-3)), std::pow(1.7, -3)},
+        {pow(x, integer(40)), std::pow(1.7, 40)},
+        {pow(x, Rational::from_two_ints(1, 2)), std::sqrt(1.7)},
+        {pow(x, Rational::from_two_ints(-1, 2)), 1 / std::sqrt(1.7)},
+        {pow(x, Rational::from_two_ints(1, 3)), std::cbrt(1.7)},
+        {pow(x, Rational::from_two_ints(-1, 3)), 1 / std::cbrt(1.7)},
+        {pow(x, Rational::from_two_ints(2, 3)), std::pow(1.7, 2.0 / 3)},
+        {pow(integer(2), Rational::from_two_ints(1, 3)), std::cbrt(2.0)},
+        {pow(E, x), std::exp(1.7)},
+    };
+    for (const auto &p : vec) {
+        double d = p.second;
+        REQUIRE(std::fabs(eval_double(*p.first) - d) < 1e-14 * d);
+        REQUIRE(std::fabs(eval_double_single_dispatch(*p.first) - d)
+                < 1e-14 * d);
+        REQUIRE(std::abs(eval_complex_double(*p.first) - d) < 1e-14 * d);
+    }
+
+    // the principal cube root of a negative number is not real
+    std::complex<double> c = eval_complex_double(
+        *pow(real_double(-8.0), Rational::from_two_ints(1, 3)));
+    REQUIRE(std::abs(c - std::complex<double>(1, std::sqrt(3.0))) < 1e-14);
+}
+
+// Compares the bits, as the tests are built with -ffast-math, which assumes
+// that there are no infinities
+static bool same_double(double a, double b)
+{
+    unsigned long long x, y;
+    std::memcpy(&x, &a, sizeof(x));
+    std::memcpy(&y, &b, sizeof(y));
+    return x == y;
+}
+
+TEST_CASE("Reproducible sums and products: eval_double", "[eval_double]")
+{
+    using SymEngine::ExactSum;
+    using SymEngine::add;
+    using SymEngine::mul;
+    using SymEngine::eval_double_reproducible;
+    using SymEngine::eval_complex_double_reproducible;
+
+    ExactSum s, t;
+    for (double x : {1e100, 1.0, -1e100, 1e-30})
+        s.add(x);
+    REQUIRE(s.round() == 1.0);
+    for (int i = 0; i < 10; i++)
+        t.add(0.1);
+    REQUIRE(t.round() == 1.0);
+    t.add(s);
+    REQUIRE(t.round() == 2.0);
+
+    // partial sums that overflow in some orders but not in others
+    const double big = std::numeric_limits<double>::max();
+    std::vector<double> v = {big, big, -big, 1.0, -big, 0.5 * big, 1e300};
+    std::sort(v.begin(), v.end());
+    do {
+        ExactSum u;
+        for (double x : v)
+            u.add(x);
+        REQUIRE(same_double(u.round(), 0.5 * big + 1e300));
+    } while (std::next_permutation(v.begin(), v.end()));
+    ExactSum o;
+    o.add(big);
+    o.add(0.5 * big);
+    o.add(-1.0);
+    REQUIRE(same_double(o.round(),
+                        std::numeric_limits<double>::infinity()));
+    o.add(-0.5 * big);
+    REQUIRE(same_double(o.round(), big));
+
+    // the same sum with the terms inserted in opposite orders
+    vec_basic terms, reversed;
+    for (int i = 1; i <= 3000; i++)
+        terms.push_back(mul(integer(i % 7 - 3), sin(integer(i))));
+    reversed.assign(terms.rbegin(), terms.rend());
+    RCP<const Basic> a = add(terms), b = add(reversed);
+    double d = eval_double_reproducible(*a);
+    REQUIRE(d == eval_double_reproducible(*b));
+    long double r = 0;
+    for (int i = 1; i <= 3000; i++)
+        r += (i % 7 - 3) * std::sin((long double)i);
+    REQUIRE(std::fabs(d - double(r)) < 1e-12);
+    REQUIRE(std::fabs(eval_double(*a) - d) < 1e-10);
+
+    std::complex<double> c = eval_complex_double_reproducible(
+        *add(a, mul(SymEngine::I, b)));
+    REQUIRE(c == std::complex<double>(d, d));
+
+    terms.resize(200);
+    reversed.assign(terms.rbegin(), terms.rend());
+    a = add(mul(terms), integer(1));
+    b = add(mul(reversed), integer(1));
+    REQUIRE(eval_double_reproducible(*a) == eval_double_reproducible(*b));
+    REQUIRE(eval_double_reproducible(*pow(a, integer(2)))
+            == eval_double_reproducible(*pow(b, integer(2))));
+}
+
+TEST_CASE("Dual numbers: eval_double", "[eval_double]")
+{
+    using SymEngine::DualDouble;
+    using SymEngine::eval_dual_double;
+    using SymEngine::gamma;
+    using SymEngine::map_basic_basic;
+    using SymEngine::add;
+    using SymEngine::mul;
+    using SymEngine::Symbol;
+    RCP<const Symbol> x = symbol("x"), y = symbol("y");
+    vec_basic xs = {x, y};
+    RCP<const Basic> r
+        = add({mul({x, y, sin(y)}), exp(div(x, y)), atan(mul(x, x)),
+               pow(x, y), sqrt(add(x, y)), pow(y, integer(5)),
+               pow(x, Rational::from_two_ints(1, 3)), gamma(y), erf(x),
+               loggamma(x), cosh(div(y, x))});
+    double px = 0.7, py = 1.3;
+    map_basic_basic subs = {{x, real_double(px)}, {y, real_double(py)}};
+    double f = eval_double(*r->subs(subs));
+    double dx = eval_double(*r->diff(x)->subs(subs));
+    double dy = eval_double(*r->diff(y)->subs(subs));
+
+    // derivative along (1, 2)
+    std::vector<DualDouble<1>> v1 = {px, py};
+    v1[0].d[0] = 1;
+    v1[1].d[0] = 2;
+    DualDouble<1> d1 = eval_dual_double(*r, xs, v1);
+    REQUIRE(std::fabs(d1.v - f) < 1e-14 * std::fabs(f));
+    REQUIRE(std::fabs(d1.d[0] - (dx + 2 * dy)) < 1e-12 * std::fabs(dx));
+
+    // both partial derivatives at once
+    std::vector<DualDouble<2>> v2 = {px, py};
+    v2[0].d[0] = 1;
+    v2[1].d[1] = 1;
+    DualDouble<2> d2 = eval_dual_double(*r, xs, v2);
+    REQUIRE(std::fabs(d2.v - f) < 1e-14 * std::fabs(f));
+    REQUIRE(std::fabs(d2.d[0] - dx) < 1e-12 * std::fabs(dx));
+    REQUIRE(std::fabs(d2.d[1] - dy) < 1e-12 * std::fabs(dy));
+
+    d2 = eval_dual_double(*max({mul(x, y), y}), xs, v2);
+    REQUIRE(d2.v == py);
+    REQUIRE(d2.d[0] == 0);
+    REQUIRE(d2.d[1] == 1);
+
+    CHECK_THROWS_AS(eval_dual_double(*r, {x}, v1), std::runtime_error);
+    CHECK_THROWS_AS(eval_dual_double(*zeta(x), {x}, v1), std::runtime_error);
+}
+
 TEST_CASE("eval_complex_double: eval_double", "[eval_double]")
 {
     RCP<const Basic> r1, r2, r3, r4, r5;
@@ -199,7 +427,9 @@ TEST_CASE("eval_complex_double: eval_double", "[eval_double]")
         {log(div(pi, mul(E, r1))),
          std::complex<double>(-1.38670227775307, -1.57079632679490)},
         {add(abs(r1), complex_double(std::complex<double>(0.1, 0.1))),
-         std::complex<double>(4.72479554547038, 0.1)}};
+         std::complex<double>(4.72479554547038, 0.1)},
+        {lambertw(integer(-1)),
+         std::complex<double>(-0.318131505204764, 1.33723570143069)}};
 
     for (unsigned i = 0; i < vec.size(); i++) {
         std::complex<double> val = eval_complex_double(*vec[i].first);
@@ -209,3 +439,60 @@ TEST_CASE("eval_complex_double: eval_double", "[eval_double]")
         REQUIRE(std::abs(val.real() - vec[i].second.real()) < 1e-12);
     }
 }
+
+TEST_CASE("eval_interval_double: eval_double", "[eval_double]")
+{
+    using SymEngine::IntervalDouble;
+    using SymEngine::eval_interval_double;
+    RCP<const Basic> x = symbol("x"), y = symbol("y");
+    IntervalDouble r;
+
+    // the exact values are contained
+    r = eval_interval_double(*sin(integer(1)));
+    REQUIRE(r.contains(0.8414709848078965));
+    REQUIRE((r.hi - r.lo) < 1e-15);
+    REQUIRE(eval_interval_double(*sin(pi)).contains(0));
+    REQUIRE(eval_interval_double(*cos(pi)).contains(-1));
+    r = eval_interval_double(*add(pow(sin(integer(3)), integer(2)),
+                                  pow(cos(integer(3)), integer(2))));
+    REQUIRE(r.contains(1));
+    REQUIRE((r.hi - r.lo) < 1e-14);
+    r = eval_interval_double(
+        *mul(pow(integer(3), div(one, integer(3))),
+             pow(integer(3), div(integer(2), integer(3)))));
+    REQUIRE(r.contains(3));
+    r = eval_interval_double(*div(one, integer(3)));
+    REQUIRE(r.lo < 1.0 / 3);
+    REQUIRE(r.hi > 1.0 / 3);
+
+    // x*y + sin(x) - sqrt(x)/(y + 2) on [1, 2] x [-1, 3]
+    RCP<const Basic> f
+        = sub(add(mul(x, y), sin(x)), div(sqrt(x), add(y, integer(2))));
+    r = eval_interval_double(*f, {x, y}, {{1, 2}, {-1, 3}});
+    for (int i = 0; i <= 10; i++) {
+        for (int j = 0; j <= 10; j++) {
+            double xv = 1 + i / 10.0, yv = -1 + 4 * j / 10.0;
+            double v = xv * yv + std::sin(xv) - std::sqrt(xv) / (yv + 2);
+            REQUIRE(r.contains(v));
+        }
+    }
+    r = eval_interval_double(*sin(x), {x}, {{0, 4}});
+    REQUIRE(r.hi == 1);
+    REQUIRE(r.contains(std::sin(4.0)));
+    r = eval_interval_double(*pow(x, integer(2)), {x}, {{-1, 2}});
+    REQUIRE(r.lo == 0);
+    REQUIRE(r.contains(4));
+
+    // only the points in the domain are considered
+    r = eval_interval_double(*log(x), {x}, {{-1, 1}});
+    REQUIRE(r.lo == -HUGE_VAL);
+    REQUIRE(r.contains(0));
+    r = eval_interval_double(*div(one, x), {x}, {{-1, 1}});
+    REQUIRE(r.lo == -HUGE_VAL);
+    REQUIRE(r.hi == HUGE_VAL);
+    REQUIRE(eval_interval_double(*sqrt(x), {x}, {{-2, -1}}).is_empty());
+
+    CHECK_THROWS_AS(eval_interval_double(*x), std::runtime_error);
+    CHECK_THROWS_AS(eval_interval_double(*zeta(x, y), {x, y}, {1, 2}),
+                    std::runtime_error);
+}
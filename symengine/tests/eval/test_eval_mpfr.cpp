@@ -106,3 +106,34 @@ TEST_CASE("precision: eval_mpfr", "[eval_mpfr]")
 
     mpfr_clear(a);
 }
+
+TEST_CASE("Constants: eval_mpfr", "[eval_mpfr]")
+{
+    using SymEngine::eval_mpfr_constant;
+    mpfr_t a, b;
+    mpfr_init2(a, 53);
+    mpfr_init2(b, 53);
+
+    // the cached values are rounded correctly for lower precisions
+    for (mpfr_prec_t prec : {1000, 60, 2000, 53, 2, 1000}) {
+        mpfr_set_prec(a, prec);
+        mpfr_set_prec(b, prec);
+        for (mpfr_rnd_t rnd : {MPFR_RNDN, MPFR_RNDD, MPFR_RNDU}) {
+            eval_mpfr_constant(a, *pi, rnd);
+            mpfr_const_pi(b, rnd);
+            REQUIRE(mpfr_equal_p(a, b));
+
+            eval_mpfr_constant(a, *EulerGamma, rnd);
+            mpfr_const_euler(b, rnd);
+            REQUIRE(mpfr_equal_p(a, b));
+
+            eval_mpfr_constant(a, *E, rnd);
+            mpfr_set_ui(b, 1, rnd);
+            mpfr_exp(b, b, rnd);
+            REQUIRE(mpfr_equal_p(a, b));
+        }
+    }
+
+    mpfr_clear(a);
+    mpfr_clear(b);
+}
@@ -1,6 +1,9 @@
 #include "catch.hpp"
 
 #include <symengine/lambda_double.h>
+#include <symengine/codegen.h>
+#include <symengine/lambda_batch.h>
+#include <symengine/lambda_gradient.h>
 
 using SymEngine::Basic;
 using SymEngine::RCP;
@@ -18,7 +21,24 @@ using SymEngine::max;
 using SymEngine::E;
 using SymEngine::gamma;
 using SymEngine::loggamma;
+using SymEngine::zeta;
+using SymEngine::polygamma;
+using SymEngine::uppergamma;
+using SymEngine::lowergamma;
+using SymEngine::lambertw;
+using SymEngine::beta;
 using SymEngine::min;
+using SymEngine::sin;
+using SymEngine::cos;
+using SymEngine::cot;
+using SymEngine::asec;
+using SymEngine::sqrt;
+using SymEngine::div;
+using SymEngine::sub;
+using SymEngine::rational;
+using SymEngine::CCodePrinter;
+using SymEngine::CCodeLambdaDouble;
+using SymEngine::JITLambdaDouble;
 
 TEST_CASE("Evaluate to double", "[lambda_double]")
 {
@@ -51,6 +71,13 @@ TEST_CASE("Evaluate to double", "[lambda_double]")
     d = v.call({4.0, 2.0, 2.5});
     REQUIRE(::fabs(d - 8.0) < 1e-12);
 
+    r = add({pow(x, integer(15)), pow(y, integer(-2)), sqrt(z),
+             pow(z, rational(-1, 3)), mul(x, pow(y, integer(5)))});
+    v.init({x, y, z}, *r);
+    d = v.call({1.1, 2.0, 8.0});
+    REQUIRE(::fabs(d - (std::pow(1.1, 15) + 0.25 + std::sqrt(8.0) + 0.5 + 35.2))
+            < 1e-12);
+
     // Evaluating to double when there are complex doubles raise an exception
     CHECK_THROWS_AS(
         v.init({x}, *add(complex_double(std::complex<double>(1, 2)), x)),
@@ -120,4 +147,341 @@ TEST_CASE("Evaluate functions", "[lambda_gamma]")
 
     d = v.call({1.1});
     REQUIRE(::fabs(d - 0.88020506957408169) < 1e-12);
-}
\ No newline at end of file
+
+    y = symbol("y");
+    r = add(zeta(x, y), polygamma(integer(1), x));
+    v.init({x, y}, *r);
+
+    d = v.call({2, 0.5});
+    REQUIRE(::fabs(d - 5.57973626739291) < 1e-12);
+
+    r = add(uppergamma(x, y), lambertw(y));
+    v.init({x, y}, *r);
+
+    d = v.call({0.2, 5});
+    REQUIRE(::fabs(d - 1.32835796093389) < 1e-12);
+
+    r = add(lowergamma(x, y), beta(x, y));
+    v.init({x, y}, *r);
+
+    d = v.call({0.2, 2});
+    REQUIRE(::fabs(d - 8.69789099601049) < 1e-12);
+
+    LambdaComplexDoubleVisitor w;
+    w.init({x}, *lambertw(x));
+    std::complex<double> c = w.call({-1.0});
+    REQUIRE(::fabs(c.real() + 0.318131505204764) < 1e-12);
+    REQUIRE(::fabs(c.imag() - 1.337235701430689) < 1e-12);
+}
+static size_t count_substr(const std::string &s, const std::string &t)
+{
+    size_t n = 0;
+    for (size_t i = s.find(t); i != std::string::npos; i = s.find(t, i + 1))
+        n++;
+    return n;
+}
+
+TEST_CASE("Generate C code", "[ccode]")
+{
+    RCP<const Basic> x, y, z, s;
+    std::string code;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+
+    CCodePrinter p;
+    code = p.apply("f", {x, y}, {mul(pow(x, integer(5)), y)});
+    REQUIRE(count_substr(code, "const double *restrict x") == 1);
+    REQUIRE(count_substr(code, "double *restrict out") == 1);
+    REQUIRE(count_substr(code, "pow(") == 0);
+    REQUIRE(count_substr(code, "const double t0 = x[0]*x[0];") == 1);
+    REQUIRE(count_substr(code, "out[0] = x[0]*t0*t0*x[1];") == 1);
+
+    // the common subexpression is computed once
+    s = sin(add(x, y));
+    code = p.apply("f", {x, y, z},
+                   {add(s, z), mul(s, z), pow(add(s, integer(1)), z)});
+    REQUIRE(count_substr(code, "sin(") == 1);
+    REQUIRE(count_substr(code, "const double t0 = sin(") == 1);
+    REQUIRE(count_substr(code, "t0*x[2]") == 1);
+
+    // the base of a power chain is computed once
+    code = p.apply("f", {x, y}, {pow(add(x, y), integer(-3))});
+    REQUIRE(count_substr(code, "const double t0 = x[") == 1);
+    REQUIRE(count_substr(code, "1.0/(t0*t0*t0)") == 1);
+
+    // undefined symbols raise an exception
+    CHECK_THROWS_AS(p.apply("f", {x}, {add(x, y)}), std::runtime_error);
+}
+
+#ifndef _WIN32
+TEST_CASE("Evaluate compiled C code", "[ccode]")
+{
+    RCP<const Basic> x, y, z, s;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+
+    s = sin(add(x, y));
+    vec_basic outputs = {
+        add(s, z),
+        mul(s, pow(z, integer(7))),
+        div(mul(integer(-3), cot(x)), pow(y, integer(2))),
+        add(sqrt(add(x, z)), pow(E, sub(y, x))),
+        add(asec(z), mul(rational(2, 3), pow(x, rational(1, 3)))),
+        max({x, mul(y, z), cos(s)}),
+        sub(gamma(z), div(integer(1), sqrt(x))),
+    };
+    std::vector<double> inps = {0.5, 1.25, 2.5};
+
+    CCodeLambdaDouble f;
+    f.init({x, y, z}, outputs);
+    std::vector<double> outs(outputs.size());
+    f.call(outs.data(), inps.data());
+
+    LambdaRealDoubleVisitor v;
+    for (size_t i = 0; i < outputs.size(); i++) {
+        v.init({x, y, z}, *outputs[i]);
+        double d = v.call(inps);
+        REQUIRE(::fabs(outs[i] - d) < 1e-12 * (1 + ::fabs(d)));
+    }
+}
+#endif
+
+#if defined(__x86_64__) && !defined(_WIN32)
+TEST_CASE("Evaluate with generated machine code", "[jit]")
+{
+    RCP<const Basic> x, y, z, s;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+
+    s = sin(add(x, y));
+    vec_basic outputs = {
+        add(s, z),
+        mul(s, pow(z, integer(7))),
+        div(mul(integer(-3), cot(x)), pow(y, integer(2))),
+        add(sqrt(add(x, z)), pow(E, sub(y, x))),
+        add(asec(z), mul(rational(2, 3), pow(x, rational(1, 3)))),
+        max({x, mul(y, z), cos(s)}),
+        min({x, mul(y, z), cos(s)}),
+        sub(gamma(z), div(integer(1), sqrt(x))),
+        add(x, mul(integer(2), add(y, pow(add(x, integer(1)), z)))),
+        y,
+        integer(3),
+    };
+
+    JITLambdaDouble f;
+    f.init({x, y, z}, outputs);
+    std::vector<double> outs(outputs.size());
+    LambdaRealDoubleVisitor v;
+    for (double t : {0.5, 1.5, 3.0}) {
+        std::vector<double> inps = {t, 1.25 * t, 2.5};
+        f.call(outs.data(), inps.data());
+        for (size_t i = 0; i < outputs.size(); i++) {
+            v.init({x, y, z}, *outputs[i]);
+            double d = v.call(inps);
+            REQUIRE(::fabs(outs[i] - d) < 1e-12 * (1 + ::fabs(d)));
+        }
+    }
+
+    // Undefined symbols and unsupported functions raise an exception
+    CHECK_THROWS_AS(f.init({x}, {add(x, y)}), std::runtime_error);
+    CHECK_THROWS_AS(f.init({x}, {SymEngine::zeta(x)}), std::runtime_error);
+}
+#endif
+
+TEST_CASE("Evaluate over intervals", "[lambda_interval_double]")
+{
+    using SymEngine::IntervalDouble;
+    using SymEngine::LambdaIntervalDoubleVisitor;
+    RCP<const Basic> x = symbol("x"), y = symbol("y");
+    RCP<const Basic> r = add(mul(cos(x), pow(y, integer(3))),
+                             div(sqrt(x), sub(y, integer(3))));
+    r = add(r, max({x, gamma(add(x, y))}));
+
+    LambdaRealDoubleVisitor v;
+    v.init({x, y}, *r);
+    LambdaIntervalDoubleVisitor w;
+    w.init({x, y}, *r);
+
+    for (int k = 0; k < 4; k++) {
+        double lo = 0.5 * k;
+        IntervalDouble a = w.call({{lo, lo + 0.5}, {-1, 2}});
+        for (int i = 0; i <= 8; i++) {
+            for (int j = 0; j <= 8; j++) {
+                double xv = lo + i / 16.0, yv = -1 + 3 * j / 8.0;
+                double d = v.call({xv, yv});
+                if (xv + yv > 0)
+                    REQUIRE(a.contains(d));
+            }
+        }
+    }
+    IntervalDouble a = w.call({{1, 1}, {0.5, 0.5}});
+    REQUIRE(a.contains(v.call({1, 0.5})));
+    REQUIRE((a.hi - a.lo) < 1e-13);
+}
+
+TEST_CASE("Evaluate at many points", "[lambda_complex_double_batch]")
+{
+    using SymEngine::exp;
+    using SymEngine::log;
+    using SymEngine::tan;
+    using SymEngine::I;
+    using SymEngine::LambdaComplexDoubleBatch;
+    RCP<const Basic> s = symbol("s"), k = symbol("k");
+    // transfer function of a damped oscillator with a delay
+    RCP<const Basic> h
+        = div(mul(k, exp(mul(real_double(-0.1), s))),
+              add({pow(s, integer(2)), mul(real_double(0.3), s), integer(1)}));
+    vec_basic outs = {h,
+                      add({log(add(s, integer(2))), mul(sin(s), cos(k)),
+                           pow(s, integer(-7)), mul(I, pow(s, k))}),
+                      add(tan(s), sqrt(add(s, k))), mul(I, integer(2))};
+
+    LambdaComplexDoubleBatch b;
+    b.init({s, k}, outs);
+    std::vector<LambdaComplexDoubleVisitor> v(outs.size());
+    for (size_t j = 0; j < outs.size(); j++)
+        v[j].init({s, k}, *outs[j]);
+
+    // more points than in one block and not a multiple of the block size
+    const size_t n = 1000;
+    std::vector<double> in_re(2 * n), in_im(2 * n);
+    for (size_t i = 0; i < n; i++) {
+        in_re[i] = 0.01 * i - 3;
+        in_im[i] = 0.003 * i + 0.2;
+        in_re[n + i] = 1.0 + 0.001 * i;
+        in_im[n + i] = 0.5 - 0.002 * i;
+    }
+    std::vector<double> out_re(outs.size() * n), out_im(outs.size() * n);
+    b.call(out_re.data(), out_im.data(), in_re.data(), in_im.data(), n);
+    for (size_t i = 0; i < n; i++) {
+        std::vector<std::complex<double>> x
+            = {{in_re[i], in_im[i]}, {in_re[n + i], in_im[n + i]}};
+        for (size_t j = 0; j < outs.size(); j++) {
+            std::complex<double> d = v[j].call(x);
+            std::complex<double> e(out_re[j * n + i], out_im[j * n + i]);
+            REQUIRE(std::abs(d - e) <= 1e-12 * std::max(1.0, std::abs(d)));
+        }
+    }
+
+    // real inputs
+    std::fill(in_im.begin(), in_im.end(), 0.0);
+    b.call(out_re.data(), out_im.data(), in_re.data(), nullptr, n);
+    std::vector<std::complex<double>> x = {{in_re[5], 0}, {in_re[n + 5], 0}},
+                                      y(outs.size());
+    b.call(y.data(), x.data());
+    for (size_t j = 0; j < outs.size(); j++) {
+        std::complex<double> d = v[j].call(x);
+        REQUIRE(std::abs(d - y[j]) <= 1e-12 * std::max(1.0, std::abs(d)));
+        std::complex<double> e(out_re[j * n + 5], out_im[j * n + 5]);
+        REQUIRE(std::abs(e - y[j]) <= 1e-12 * std::max(1.0, std::abs(d)));
+    }
+
+    // |z|**2 overflows or underflows, while 1/z and log(z) do not
+    b.init({s}, {div(integer(1), s), log(s)});
+    for (double r : {1e200, 1e-200}) {
+        std::complex<double> z(3 * r, -4 * r), w[2];
+        b.call(w, &z);
+        REQUIRE(std::abs(w[0] - 1.0 / z) <= 1e-15 * std::abs(1.0 / z));
+        REQUIRE(std::abs(w[1] - std::log(z)) <= 1e-15 * std::abs(std::log(z)));
+    }
+
+    CHECK_THROWS_AS(b.init({s}, outs), std::runtime_error);
+}
+
+TEST_CASE("Evaluate gradients", "[lambda_gradient]")
+{
+    using SymEngine::exp;
+    using SymEngine::log;
+    using SymEngine::atan2;
+    using SymEngine::tanh;
+    using SymEngine::erf;
+    using SymEngine::LambdaRealDoubleGradient;
+    RCP<const Basic> x = symbol("x"), y = symbol("y"), z = symbol("z");
+    vec_basic xs = {x, y, z};
+    RCP<const Basic> r = add({mul({x, y, sin(z)}), exp(div(x, y)),
+                              mul(log(z), pow(x, integer(3))), atan2(y, x),
+                              sqrt(mul(x, z)), pow(x, y), gamma(z),
+                              div(tanh(y), cos(x)), erf(sub(x, y)),
+                              pow(z, rational(1, 3)), cot(y), asec(z)});
+
+    LambdaRealDoubleGradient g;
+    g.init(xs, *r);
+    LambdaRealDoubleVisitor v;
+    v.init(xs, *r);
+    std::vector<double> p = {0.7, 1.3, 2.1}, grad;
+    double d = g.call(p, grad);
+    REQUIRE(::fabs(d - v.call(p)) < 1e-13 * ::fabs(d));
+    REQUIRE(::fabs(g.call(p) - d) < 1e-15 * ::fabs(d));
+    REQUIRE(grad.size() == 3);
+    for (size_t i = 0; i < 3; i++) {
+        v.init(xs, *r->diff(SymEngine::rcp_static_cast<const SymEngine::Symbol>(
+                       xs[i])));
+        double e = v.call(p);
+        REQUIRE(::fabs(grad[i] - e) < 1e-12 * ::fabs(e));
+    }
+
+    g.init(xs, *max({mul(x, y), z, integer(1)}));
+    REQUIRE(g.call({2.0, 3.0, 4.0}, grad) == 6.0);
+    REQUIRE(grad == std::vector<double>({3.0, 2.0, 0.0}));
+
+    // gradient of sum((x_i - i)**2) + sum(x_i)**2 with many symbols
+    const int n = 10000;
+    vec_basic syms, terms;
+    for (int i = 0; i < n; i++) {
+        syms.push_back(symbol("x" + std::to_string(i)));
+        terms.push_back(pow(sub(syms[i], integer(i)), integer(2)));
+    }
+    g.init(syms, *add(add(terms), pow(add(syms), integer(2))));
+    REQUIRE(g.size() < 5 * n);
+    std::vector<double> q(n);
+    double s = 0;
+    for (int i = 0; i < n; i++) {
+        q[i] = i + 1e-3 * (i % 10);
+        s += q[i];
+    }
+    g.call(q, grad);
+    for (int i = 0; i < n; i++)
+        REQUIRE(::fabs(grad[i] - (2 * (q[i] - i) + 2 * s)) < 1e-6);
+
+    CHECK_THROWS_AS(g.init({x}, *r), std::runtime_error);
+    CHECK_THROWS_AS(g.call({1.0}, grad), std::runtime_error);
+}
+
+TEST_CASE("Evaluate Jacobian-vector products", "[lambda_gradient]")
+{
+    using SymEngine::exp;
+    using SymEngine::atan2;
+    using SymEngine::LambdaRealDoubleGradient;
+    using SymEngine::LambdaRealDoubleJVP;
+    RCP<const Basic> x = symbol("x"), y = symbol("y"), z = symbol("z");
+    vec_basic xs = {x, y, z};
+    vec_basic fs = {add(mul({x, y, sin(z)}), exp(div(x, y))),
+                    add(atan2(y, x), pow(x, y)), max({mul(x, z), y})};
+
+    LambdaRealDoubleJVP j;
+    j.init(xs, fs);
+    // two tangent vectors, one after the other
+    std::vector<double> p = {0.7, 1.3, 2.1}, v = {1, 0, 0, 0.5, -1, 2}, f, jv;
+    j.call(p, v, f, jv);
+    REQUIRE(f.size() == 3);
+    REQUIRE(jv.size() == 6);
+    LambdaRealDoubleGradient g;
+    std::vector<double> grad;
+    for (size_t i = 0; i < 3; i++) {
+        g.init(xs, *fs[i]);
+        double e = g.call(p, grad);
+        REQUIRE(::fabs(f[i] - e) < 1e-15 * ::fabs(e));
+        for (size_t l = 0; l < 2; l++) {
+            double d = 0;
+            for (size_t k = 0; k < 3; k++)
+                d += grad[k] * v[l * 3 + k];
+            REQUIRE(::fabs(jv[l * 3 + i] - d) < 1e-13 * (1 + ::fabs(d)));
+        }
+    }
+
+    CHECK_THROWS_AS(j.call(p, {1.0, 2.0}, f, jv), std::runtime_error);
+    CHECK_THROWS_AS(j.call({1.0}, v, f, jv), std::runtime_error);
+}
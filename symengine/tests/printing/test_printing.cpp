@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include <chrono>
+#include <cstdio>
 
 #include <symengine/add.h>
 #include <symengine/basic.h>
@@ -20,6 +21,7 @@
 using SymEngine::RCP;
 using SymEngine::Basic;
 using SymEngine::div;
+using SymEngine::sub;
 using SymEngine::Expression;
 using SymEngine::pow;
 using SymEngine::univariate_int_polynomial;
@@ -410,6 +412,39 @@ TEST_CASE("test custom printing", "[printing]")
     CHECK(printer.apply(p) == "cos(MySin(x))");
 }
 
+TEST_CASE("test printing to a buffer and to files", "[printing]")
+{
+    SymEngine::StrPrinter printer;
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Basic> big
+        = integer(integer_class("-123456789012345678901234567890"));
+    RCP<const Basic> p = add(mul(big, x), sub(y, pow(x, integer(2))));
+    std::string expected = "-123456789012345678901234567890*x + y - x**2";
+    CHECK(p->__str__() == expected);
+    CHECK(integer(-5)->__str__() == "-5");
+    CHECK(integer(0)->__str__() == "0");
+
+    printer.print(*p);
+    printer.print(*x);
+    CHECK(printer.get_buffer() == expected + "x");
+    printer.clear_buffer();
+    // apply() does not touch what is already in the buffer
+    printer.print(*y);
+    CHECK(printer.apply(p) == expected);
+    CHECK(printer.get_buffer() == "y");
+
+    std::FILE *f = std::tmpfile();
+    REQUIRE(f != nullptr);
+    printer.print_lines({p, x, div(x, y)}, f);
+    printer.print(*y, f);
+    std::rewind(f);
+    char buf[128];
+    std::size_t n = std::fread(buf, 1, sizeof(buf), f);
+    std::fclose(f);
+    CHECK(std::string(buf, n) == expected + "\nx\nx/y\ny");
+}
+
 TEST_CASE("Ascii Art", "[basic]")
 {
     std::cout << SymEngine::ascii_art() << std::endl;
@@ -110,3 +110,22 @@ TEST_CASE("Test rcp_from_this const 2", "[rcp]")
     f2_hybrid(*m2);
     REQUIRE(m2->use_count() == 1);
 }
+
+TEST_CASE("Test make_immortal", "[rcp]")
+{
+    RCP<Mesh> m = make_rcp<Mesh>();
+    m->make_immortal();
+    RCP<Mesh> m2 = m;
+#if defined(SYMENGINE_IMMORTAL_OBJECTS)
+    // copies do not change the reference counter, and the object is not
+    // deleted when the last reference is released
+    REQUIRE(m->use_count() == 1);
+    Mesh *p = m.get();
+    m.reset();
+    m2.reset();
+    REQUIRE(p->use_count() == 1);
+    delete p;
+#else
+    REQUIRE(m->use_count() == 2);
+#endif
+}